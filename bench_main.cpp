@@ -0,0 +1,379 @@
+// 基准测试：物理步进、AI 轨迹/瞄准搜索、关卡加载与初始沉降等热点路径的可重复测量
+//
+// 用法：Benchmark [--filter 子串] [--samples N] [--quick] [--seed N] [--json 输出路径]
+//   每个用例先预热一次，再采样 N 次（默认 7）；每次采样内部循环若干次，结果折算为单次耗时（微秒）
+//   --filter：只运行名称包含该子串的用例（例如 --filter ai.）
+//   --quick：减少采样次数和压力关卡规模（冒烟检查用）
+//   --seed：压力关卡生成种子（默认 1，同一种子在任何平台上得到相同关卡）
+//   --json：把结果写成机器可读的 JSON（"-" 表示标准输出）；`cmake --build . --target bench`
+//           会把结果写到构建目录下的 bench_results.json
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "AIController.hpp"
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "Level.hpp"
+#include "LevelGenerator.hpp"
+#include "Logger.hpp"
+#include "Material.hpp"
+#include "Physics.hpp"
+#include "Simulation.hpp"
+#include "TrajectoryBatch.hpp"
+
+// AIController 的轨迹与搜索函数是私有的，基准测试通过友元直接调用（不改变 AI 的公开接口）
+class AIBenchmark {
+public:
+    static void analyze(AIController& ai, const SimulationSession& session) {
+        ai.slingshotPos_ = session.level().slingshot;
+        ai.invalidateLayout();
+        ai.analyzeLevelLayout(session.blocks(), session.pigs());
+    }
+    static const std::vector<TargetInfo>& pigTargets(const AIController& ai) { return ai.pigTargets_; }
+    static void setPredictObstacles(AIController& ai, bool enabled) { ai.predictObstacles_ = enabled; }
+
+    static TrajectoryResult trajectory(AIController& ai, BirdType type, const TargetInfo& target,
+                                       float angle, float power) {
+        sf::Vector2f velocity = ai.velocityFromAngleAndPower(angle, power, type);
+        bool useSkill = (type == BirdType::Yellow);
+        return ai.calculateTrajectory(ai.slingshotPos_, velocity, type, useSkill, target, 5.0f, false);
+    }
+    static AimingInfo optimize(AIController& ai, BirdType type, const TargetInfo& target) {
+        return ai.optimizeLaunchParameters(type, target, ai.slingshotPos_);
+    }
+    static AimingInfo aim(AIController& ai, BirdType type, const TargetInfo& target) {
+        return ai.calculateOptimalAim(type, target, ai.slingshotPos_);
+    }
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    std::string name;
+    int samples{0};
+    int iterations{0};  // 每次采样内的循环次数
+    double meanUs{0.0};
+    double medianUs{0.0};
+    double minUs{0.0};
+    double maxUs{0.0};
+    double stddevUs{0.0};
+    nlohmann::json params = nlohmann::json::object();
+};
+
+struct BenchOptions {
+    std::string filter;
+    int samples{7};
+    bool quick{false};
+    std::uint32_t seed{1};
+    std::string jsonPath;
+};
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options) : options_(options) {}
+
+    bool enabled(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // setup 在每次采样前执行（不计时），body 在采样内循环 iterations 次
+    void run(const std::string& name, int iterations, const std::function<void()>& setup,
+             const std::function<void()>& body, nlohmann::json params = nlohmann::json::object()) {
+        if (!enabled(name)) return;
+        iterations = std::max(1, iterations);
+
+        setup();
+        body();  // 预热：填充缓存、对象池和线程池
+
+        std::vector<double> perOp;
+        perOp.reserve(static_cast<std::size_t>(options_.samples));
+        for (int s = 0; s < options_.samples; ++s) {
+            setup();
+            auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i) body();
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            perOp.push_back(us / iterations);
+        }
+
+        BenchResult result;
+        result.name = name;
+        result.samples = options_.samples;
+        result.iterations = iterations;
+        result.params = std::move(params);
+        std::vector<double> sorted = perOp;
+        std::sort(sorted.begin(), sorted.end());
+        result.minUs = sorted.front();
+        result.maxUs = sorted.back();
+        result.medianUs = sorted[sorted.size() / 2];
+        double sum = 0.0;
+        for (double v : perOp) sum += v;
+        result.meanUs = sum / static_cast<double>(perOp.size());
+        double var = 0.0;
+        for (double v : perOp) var += (v - result.meanUs) * (v - result.meanUs);
+        result.stddevUs = std::sqrt(var / static_cast<double>(perOp.size()));
+
+        std::cout << std::left << std::setw(40) << result.name << std::right
+                  << " median=" << std::setw(12) << result.medianUs << " us"
+                  << "  min=" << std::setw(12) << result.minUs
+                  << "  max=" << std::setw(12) << result.maxUs
+                  << "  (" << result.samples << "x" << result.iterations << ")\n";
+        results_.push_back(std::move(result));
+    }
+
+    void runOnce(const std::string& name, const std::function<void()>& body,
+                 nlohmann::json params = nlohmann::json::object()) {
+        run(name, 1, [] {}, body, std::move(params));
+    }
+
+    nlohmann::json toJson() const {
+        nlohmann::json doc;
+        doc["schema"] = 1;
+        doc["trajectory_kernel"] = trajectoryBatchKernelName();
+        doc["seed"] = options_.seed;
+        doc["quick"] = options_.quick;
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& r : results_) {
+            list.push_back({{"name", r.name},
+                            {"samples", r.samples},
+                            {"iterations", r.iterations},
+                            {"mean_us", r.meanUs},
+                            {"median_us", r.medianUs},
+                            {"min_us", r.minUs},
+                            {"max_us", r.maxUs},
+                            {"stddev_us", r.stddevUs},
+                            {"params", r.params}});
+        }
+        doc["results"] = std::move(list);
+        return doc;
+    }
+
+private:
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+const char* birdName(BirdType type) {
+    switch (type) {
+        case BirdType::Yellow: return "yellow";
+        case BirdType::Bomb: return "bomb";
+        case BirdType::Red:
+        default: return "red";
+    }
+}
+
+LevelData stressLevel(int blocks, std::uint32_t seed) {
+    LevelGenerator::StressOptions options;
+    options.blockCount = blocks;
+    options.seed = seed;
+    return LevelGenerator::makeStressLevel(options);
+}
+
+// ========== 物理 ==========
+
+void benchPhysics(BenchRunner& runner, const BenchOptions& options) {
+    std::vector<int> sizes = options.quick ? std::vector<int>{50, 200} : std::vector<int>{50, 200, 500};
+    for (int n : sizes) {
+        std::string name = "physics.step.collapse_" + std::to_string(n);
+        if (!runner.enabled(name)) continue;
+
+        // 未沉降的塔楼：前两秒大量接触与碰撞，代表出手后的最重负载
+        LevelData level = stressLevel(n, options.seed);
+        PhysicsWorld world({0.f, config::kGravity});
+        std::vector<std::unique_ptr<Block>> blocks;
+        std::vector<std::unique_ptr<Pig>> pigs;
+        auto setup = [&] {
+            blocks.clear();
+            pigs.clear();
+            world.reset({0.f, config::kGravity});
+            world.createBoxBody({700.0f, static_cast<float>(config::kWindowHeight) - 10.0f}, {1800.0f, 20.0f},
+                                0.0f, 2.0f, 0.1f, false, false, true, nullptr);
+            for (const auto& b : level.blocks) {
+                blocks.push_back(std::make_unique<Block>(getMaterialOrDefault(b.material),
+                                                         b.position + b.size * 0.5f, b.size, world));
+            }
+            for (const auto& p : level.pigs) {
+                pigs.push_back(std::make_unique<Pig>(p.type, p.position, world));
+            }
+        };
+        runner.run(name, 120, setup, [&] { world.step(config::kFixedDelta); },
+                   {{"blocks", n}, {"pigs", static_cast<int>(level.pigs.size())}});
+        blocks.clear();
+        pigs.clear();
+    }
+
+    // 沉降完成后的静止塔楼：大部分刚体休眠，衡量每帧的基础开销
+    int settledSize = 200;
+    std::string settledName = "physics.step.settled_" + std::to_string(settledSize);
+    if (runner.enabled(settledName)) {
+        SimulationSession session;
+        session.loadLevel(stressLevel(settledSize, options.seed));
+        runner.run(settledName, 600, [] {}, [&] { session.physics().step(config::kFixedDelta); },
+                   {{"blocks", settledSize}, {"settle_steps", session.settleSteps()}});
+    }
+
+    // 静止塔楼的实体更新：逐个更新全部方块/猪 vs 只更新唤醒集合（Game::stepWorld 的做法）
+    std::string updateAllName = "entities.update_all.settled_" + std::to_string(settledSize);
+    std::string updateAwakeName = "entities.update_awake.settled_" + std::to_string(settledSize);
+    if (runner.enabled(updateAllName) || runner.enabled(updateAwakeName)) {
+        SimulationSession session;
+        session.loadLevel(stressLevel(settledSize, options.seed));
+        std::vector<Entity*> awake;
+        session.physics().collectAwakeEntities(awake);
+        for (Entity* e : awake) e->update(config::kFixedDelta);  // 清掉新建实体的首次更新请求
+        session.physics().collectAwakeEntities(awake);
+        nlohmann::json params = {{"blocks", settledSize}, {"awake", static_cast<int>(awake.size())}};
+        runner.run(updateAllName, 600, [] {}, [&] {
+            for (const auto& b : session.blocks()) b->update(config::kFixedDelta);
+            for (const auto& p : session.pigs()) p->update(config::kFixedDelta);
+        }, params);
+        runner.run(updateAwakeName, 600, [] {}, [&] {
+            session.physics().collectAwakeEntities(awake);
+            for (Entity* e : awake) e->update(config::kFixedDelta);
+        }, params);
+    }
+}
+
+// ========== AI ==========
+
+void benchAI(BenchRunner& runner, const BenchOptions& options) {
+    int size = options.quick ? 100 : 200;
+    SimulationSession session;
+    session.loadLevel(stressLevel(size, options.seed));
+
+    AIController ai;
+    ai.setParallelSearch(false);  // 单线程搜索，结果与机器核数无关
+    AIBenchmark::analyze(ai, session);
+    if (AIBenchmark::pigTargets(ai).empty()) {
+        std::cerr << "压力关卡中没有存活的猪，跳过 AI 基准\n";
+        return;
+    }
+    const TargetInfo target = AIBenchmark::pigTargets(ai).front();
+    nlohmann::json params = {{"blocks", size}, {"target_x", target.position.x}, {"target_y", target.position.y}};
+
+    runner.run("ai.analyze_layout", 50, [] {}, [&] { AIBenchmark::analyze(ai, session); }, params);
+
+    for (BirdType type : {BirdType::Red, BirdType::Yellow, BirdType::Bomb}) {
+        std::string bird = birdName(type);
+        runner.run("ai.trajectory." + bird, 2000, [] {}, [&] { AIBenchmark::trajectory(ai, type, target, 45.0f, 80.0f); },
+                   params);
+        runner.run("ai.trajectory_obstacles." + bird, 2000,
+                   [&] { AIBenchmark::setPredictObstacles(ai, true); },
+                   [&] { AIBenchmark::trajectory(ai, type, target, 45.0f, 80.0f); }, params);
+        AIBenchmark::setPredictObstacles(ai, false);
+
+        runner.run("ai.optimize." + bird, 1, [] {}, [&] { AIBenchmark::optimize(ai, type, target); }, params);
+        runner.run("ai.aim." + bird, 1, [] {}, [&] { AIBenchmark::aim(ai, type, target); }, params);
+    }
+}
+
+// ========== 关卡加载与沉降 ==========
+
+std::vector<std::string> levelFiles() {
+    std::vector<std::string> paths;
+    for (int i = 1; std::filesystem::exists(config::levelPath(i)); ++i) {
+        paths.push_back(config::levelPath(i));
+    }
+    return paths;
+}
+
+std::string levelStem(const std::string& path) {
+    return std::filesystem::path(path).stem().string();
+}
+
+void benchLevels(BenchRunner& runner, const BenchOptions& options) {
+    LevelLoader loader;
+    for (const auto& path : levelFiles()) {
+        std::string stem = levelStem(path);
+        nlohmann::json params = {{"path", path}};
+        // load 在存在新鲜 .lvb 时走二进制，loadJson 始终解析 JSON
+        runner.run("level.load." + stem, 20, [] {}, [&] { loader.load(path); }, params);
+        runner.run("level.load_json." + stem, 20, [] {}, [&] { loader.loadJson(path); }, params);
+    }
+
+    // 完整加载 + 初始沉降（与 Game::loadLevel 同一流程；关闭沉降缓存，每次都真正沉降）
+    for (const auto& path : levelFiles()) {
+        std::string name = "level.settle." + levelStem(path);
+        if (!runner.enabled(name)) continue;
+        SimulationSession session;
+        session.setUseSettleCache(false);
+        runner.runOnce(name, [&] { session.loadLevel(path); });
+    }
+
+    int size = options.quick ? 200 : 500;
+    std::string stressName = "level.settle.stress_" + std::to_string(size);
+    if (runner.enabled(stressName)) {
+        LevelData level = stressLevel(size, options.seed);
+        SimulationSession session;
+        runner.runOnce(stressName, [&] { session.loadLevel(level); }, {{"blocks", size}});
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    bool samplesSet = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.samples = std::max(1, std::atoi(argv[++i]));
+            samplesSet = true;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else {
+            std::cerr << "未知参数: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (options.quick && !samplesSet) {
+        options.samples = 3;
+    }
+
+    // 不加载贴图；日志只写文件，避免控制台输出干扰计时
+    Entity::setHeadless(true);
+    Logger::getInstance().setConsoleOutput(false);
+    Logger::getInstance().init("bench_run.log");
+
+    std::cout << std::fixed << std::setprecision(2);
+    BenchRunner runner(options);
+    benchPhysics(runner, options);
+    benchAI(runner, options);
+    benchLevels(runner, options);
+
+    if (!options.jsonPath.empty()) {
+        std::string text = runner.toJson().dump(2);
+        if (options.jsonPath == "-") {
+            std::cout << text << "\n";
+        } else {
+            std::ofstream out(options.jsonPath);
+            if (!out) {
+                std::cerr << "无法写入结果文件: " << options.jsonPath << "\n";
+                Logger::getInstance().close();
+                return 1;
+            }
+            out << text << "\n";
+        }
+    }
+
+    Logger::getInstance().close();
+    return 0;
+}
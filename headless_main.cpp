@@ -0,0 +1,97 @@
+// 无窗口批量模拟入口：让AI以固定步长尽可能快地打完关卡，输出每关分数/胜负/发射次数
+//
+// 用法：HeadlessRunner [关卡编号或JSON路径 ...] [--repeat N] [--max-time 秒] [--verbose] [--no-settle-cache]
+//                     [--no-obstacle-aim]
+//   不指定关卡时依次运行 levels/level1.json 起的所有存在的关卡
+//   --no-settle-cache：每次都重新做初始沉降（不读写 levels/levelN.settled.json，也不使用 .lvb 中的预沉降数据）
+//   --no-obstacle-aim：AI 瞄准时忽略方块遮挡（对比障碍物感知瞄准的发射次数）
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "Logger.hpp"
+#include "Simulation.hpp"
+
+namespace {
+bool isNumber(const std::string& s) {
+    return !s.empty() && s.find_first_not_of("0123456789") == std::string::npos;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> levelPaths;
+    int repeat = 1;
+    float maxSimTime = 120.0f;
+    bool verbose = false;
+    bool useSettleCache = true;
+    bool obstacleAwareAim = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--max-time" && i + 1 < argc) {
+            maxSimTime = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--no-settle-cache") {
+            useSettleCache = false;
+        } else if (arg == "--no-obstacle-aim") {
+            obstacleAwareAim = false;
+        } else if (isNumber(arg)) {
+            levelPaths.push_back(config::levelPath(std::stoi(arg)));
+        } else {
+            levelPaths.push_back(arg);
+        }
+    }
+
+    if (levelPaths.empty()) {
+        for (int i = 1; std::filesystem::exists(config::levelPath(i)); ++i) {
+            levelPaths.push_back(config::levelPath(i));
+        }
+    }
+    if (levelPaths.empty()) {
+        std::cerr << "未找到关卡文件（目录: " << config::kLevelDirectory << "）\n";
+        return 1;
+    }
+
+    // 不加载任何贴图，日志只写文件（--verbose 时同时输出到控制台）
+    Entity::setHeadless(true);
+    Logger::getInstance().setConsoleOutput(verbose);
+    Logger::getInstance().init("headless_run.log");
+
+    int failures = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& path : levelPaths) {
+        for (int r = 0; r < repeat; ++r) {
+            SimulationSession session;
+            session.setUseSettleCache(useSettleCache);
+            session.setObstacleAwareAim(obstacleAwareAim);
+            if (!session.loadLevel(path)) {
+                std::cout << "level=" << path << " loaded=0\n";
+                ++failures;
+                break;
+            }
+            SimulationResult result = session.run(maxSimTime);
+            std::cout << "level=" << result.levelPath
+                      << " run=" << r + 1
+                      << " settle_steps=" << session.settleSteps()
+                      << " won=" << (result.won ? 1 : 0)
+                      << " score=" << result.score
+                      << " shots=" << result.shots
+                      << " birds_left=" << result.birdsLeft
+                      << " pigs_left=" << result.pigsLeft
+                      << " sim_time=" << result.simulatedTime
+                      << " wall_ms=" << result.wallTimeMs << "\n";
+        }
+    }
+
+    Logger::getInstance().close();
+    return failures == 0 ? 0 : 1;
+}
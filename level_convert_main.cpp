@@ -0,0 +1,97 @@
+// 关卡转换工具：levels/*.json -> 同名 .lvb 二进制关卡（见 src/LevelBinary.hpp）
+//
+// 用法：LevelConverter [JSON路径 ...] [--settle] [--verbose]
+//   不指定关卡时转换 levels 目录下所有 .json（跳过 *.settled.json 沉降缓存）
+//   --settle：转换前在无窗口模拟中完成初始沉降，把沉降后的刚体变换写入 .lvb，
+//             之后加载该关卡时无需再沉降
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "Level.hpp"
+#include "LevelBinary.hpp"
+#include "LevelSettle.hpp"
+#include "Logger.hpp"
+#include "Simulation.hpp"
+
+namespace {
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> levelPaths;
+    bool settle = false;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--settle") {
+            settle = true;
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else {
+            levelPaths.push_back(arg);
+        }
+    }
+
+    if (levelPaths.empty()) {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(config::kLevelDirectory, ec)) {
+            std::string path = entry.path().generic_string();
+            if (entry.is_regular_file() && endsWith(path, ".json") && !endsWith(path, ".settled.json")) {
+                levelPaths.push_back(path);
+            }
+        }
+        std::sort(levelPaths.begin(), levelPaths.end());
+    }
+    if (levelPaths.empty()) {
+        std::cerr << "未找到关卡文件（目录: " << config::kLevelDirectory << "）\n";
+        return 1;
+    }
+
+    Entity::setHeadless(true);
+    Logger::getInstance().setConsoleOutput(verbose);
+    Logger::getInstance().init("level_convert.log");
+
+    LevelLoader loader;
+    int failures = 0;
+    for (const auto& path : levelPaths) {
+        LevelData level;
+        try {
+            level = loader.loadJson(path);
+        } catch (const std::exception& e) {
+            std::cerr << path << ": " << e.what() << "\n";
+            ++failures;
+            continue;
+        }
+
+        if (settle) {
+            // 与游戏加载相同的沉降流程（不读写 .settled.json 缓存）
+            SimulationSession session;
+            session.loadLevel(level);
+            LevelSettle::captureSettled(level, session.blocks(), session.pigs());
+        }
+
+        const std::string outPath = LevelBinary::binaryPath(path);
+        if (!LevelBinary::write(outPath, level)) {
+            std::cerr << "写入失败: " << outPath << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << path << " -> " << outPath
+                  << " blocks=" << level.blocks.size()
+                  << " pigs=" << level.pigs.size()
+                  << " birds=" << level.birds.size()
+                  << " settled=" << (settle ? 1 : 0) << "\n";
+    }
+
+    Logger::getInstance().close();
+    return failures == 0 ? 0 : 1;
+}
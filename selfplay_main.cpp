@@ -0,0 +1,271 @@
+// 并行自我对局：每个关卡运行 N 局带随机扰动的 AI 模拟，多局在任务窃取线程池上并发执行，
+// 汇总每关胜率、分数分布与发射次数（关卡平衡与 AI 回归用）
+//
+// 用法：SelfPlayRunner [关卡编号或JSON路径 ...] [--runs N] [--threads N] [--seed N] [--max-time 秒]
+//                      [--jitter 像素] [--aim-noise 度] [--power-noise 百分比] [--json 输出路径] [--verbose]
+//   不指定关卡时依次运行 levels/level1.json 起的所有存在的关卡
+//   --runs：每关局数（默认 32）；--threads：工作线程数（默认 = CPU 核数）
+//   --jitter：每局把方块和猪的水平位置随机偏移 ±像素（默认 1，之后重新沉降；0 = 所有局共用一次沉降）
+//   --aim-noise / --power-noise：每次发射的方向/力度扰动（默认 0.5 度 / 2%）
+//   --json：额外输出机器可读的汇总结果（"-" 表示标准输出）
+//   每局的随机种子只由 --seed、关卡序号和局序号决定，结果与线程数无关
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "Level.hpp"
+#include "LevelSettle.hpp"
+#include "Logger.hpp"
+#include "Simulation.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace {
+
+struct SelfPlayOptions {
+    int runs{32};
+    std::size_t threads{0};
+    std::uint32_t seed{1};
+    float maxSimTime{120.0f};
+    float jitter{1.0f};
+    float aimNoise{0.5f};
+    float powerNoise{2.0f};
+    std::string jsonPath;
+    bool verbose{false};
+};
+
+bool isNumber(const std::string& s) {
+    return !s.empty() && s.find_first_not_of("0123456789") == std::string::npos;
+}
+
+// 每局独立的种子（splitmix 式混合），不依赖执行顺序
+std::uint32_t runSeed(std::uint32_t seed, std::size_t level, int run) {
+    std::uint64_t x = (static_cast<std::uint64_t>(seed) << 32) ^ (static_cast<std::uint64_t>(level) << 20) ^
+                      static_cast<std::uint64_t>(run);
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>(x ^ (x >> 31));
+}
+
+float symmetricUnit(std::mt19937& rng) {
+    return static_cast<float>(rng() >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+// 水平抖动：只改 x，避免竖向叠放的方块互相嵌入；改动后的关卡必须重新沉降
+LevelData perturbLevel(const LevelData& base, float jitter, std::mt19937& rng) {
+    LevelData level = base;
+    level.settledBlocks.clear();
+    level.settledPigs.clear();
+    for (auto& block : level.blocks) block.position.x += symmetricUnit(rng) * jitter;
+    for (auto& pig : level.pigs) pig.position.x += symmetricUnit(rng) * jitter;
+    return level;
+}
+
+struct LevelStats {
+    std::string path;
+    std::vector<SimulationResult> runs;
+};
+
+double percentile(std::vector<int> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    std::size_t index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+nlohmann::json summarize(const LevelStats& stats) {
+    std::vector<int> scores;
+    std::vector<int> shots;
+    int wins = 0;
+    int loaded = 0;
+    double wallMs = 0.0;
+    nlohmann::json shotHistogram = nlohmann::json::object();
+    for (const auto& r : stats.runs) {
+        if (!r.loaded) continue;
+        ++loaded;
+        wins += r.won ? 1 : 0;
+        scores.push_back(r.score);
+        shots.push_back(r.shots);
+        wallMs += r.wallTimeMs;
+        std::string key = std::to_string(r.shots);
+        shotHistogram[key] = shotHistogram.value(key, 0) + 1;
+    }
+
+    double meanScore = 0.0;
+    double meanShots = 0.0;
+    for (int s : scores) meanScore += s;
+    for (int s : shots) meanShots += s;
+    if (loaded > 0) {
+        meanScore /= loaded;
+        meanShots /= loaded;
+        wallMs /= loaded;
+    }
+
+    return {{"level", stats.path},
+            {"runs", loaded},
+            {"wins", wins},
+            {"win_rate", loaded > 0 ? static_cast<double>(wins) / loaded : 0.0},
+            {"score_mean", meanScore},
+            {"score_min", percentile(scores, 0.0)},
+            {"score_p10", percentile(scores, 0.1)},
+            {"score_p50", percentile(scores, 0.5)},
+            {"score_p90", percentile(scores, 0.9)},
+            {"score_max", percentile(scores, 1.0)},
+            {"shots_mean", meanShots},
+            {"shots_histogram", shotHistogram},
+            {"wall_ms_mean", wallMs}};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> levelPaths;
+    SelfPlayOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) {
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = static_cast<std::size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--max-time" && i + 1 < argc) {
+            options.maxSimTime = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--jitter" && i + 1 < argc) {
+            options.jitter = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--aim-noise" && i + 1 < argc) {
+            options.aimNoise = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--power-noise" && i + 1 < argc) {
+            options.powerNoise = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else if (isNumber(arg)) {
+            levelPaths.push_back(config::levelPath(std::stoi(arg)));
+        } else {
+            levelPaths.push_back(arg);
+        }
+    }
+
+    if (levelPaths.empty()) {
+        for (int i = 1; std::filesystem::exists(config::levelPath(i)); ++i) {
+            levelPaths.push_back(config::levelPath(i));
+        }
+    }
+    if (levelPaths.empty()) {
+        std::cerr << "未找到关卡文件（目录: " << config::kLevelDirectory << "）\n";
+        return 1;
+    }
+
+    // 不加载贴图；并发会话的 AI 信息日志量很大，默认只记录警告和错误
+    Entity::setHeadless(true);
+    Logger::getInstance().setConsoleOutput(options.verbose);
+    Logger::getInstance().setMinLevel(options.verbose ? LogLevel::Info : LogLevel::Warning);
+    Logger::getInstance().init("selfplay_run.log");
+
+    // 关卡文件在主线程读取一次；不抖动时顺便沉降一次，所有局直接复用沉降结果
+    std::vector<LevelData> baseLevels;
+    std::vector<LevelStats> stats;
+    LevelLoader loader;
+    for (const auto& path : levelPaths) {
+        try {
+            LevelData level = loader.load(path);
+            if (options.jitter <= 0.0f && level.settledBlocks.empty()) {
+                SimulationSession session;
+                session.loadLevel(path);
+                LevelSettle::captureSettled(level, session.blocks(), session.pigs());
+            }
+            baseLevels.push_back(std::move(level));
+            stats.push_back({path, std::vector<SimulationResult>(static_cast<std::size_t>(options.runs))});
+        } catch (const std::exception& e) {
+            std::cerr << "关卡加载失败: " << path << " (" << e.what() << ")\n";
+        }
+    }
+    if (baseLevels.empty()) {
+        Logger::getInstance().close();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    WorkStealingPool pool(options.threads);
+    for (std::size_t l = 0; l < baseLevels.size(); ++l) {
+        for (int r = 0; r < options.runs; ++r) {
+            pool.submit([&, l, r] {
+                std::mt19937 rng(runSeed(options.seed, l, r));
+                SimulationSession session;
+                session.setParallelSearch(false);  // 并行度来自多局并发，AI 搜索留在本线程
+                session.setLaunchNoise(options.aimNoise, options.powerNoise, rng());
+                if (options.jitter > 0.0f) {
+                    session.loadLevel(perturbLevel(baseLevels[l], options.jitter, rng));
+                } else {
+                    session.loadLevel(baseLevels[l]);
+                }
+                SimulationResult result = session.run(options.maxSimTime);
+                result.levelPath = stats[l].path;
+                stats[l].runs[static_cast<std::size_t>(r)] = std::move(result);
+            });
+        }
+    }
+    pool.wait();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    nlohmann::json levels = nlohmann::json::array();
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& level : stats) {
+        nlohmann::json summary = summarize(level);
+        std::cout << "level=" << level.path
+                  << " runs=" << summary["runs"].get<int>()
+                  << " win_rate=" << summary["win_rate"].get<double>()
+                  << " score_mean=" << summary["score_mean"].get<double>()
+                  << " score_p10=" << summary["score_p10"].get<double>()
+                  << " score_p50=" << summary["score_p50"].get<double>()
+                  << " score_p90=" << summary["score_p90"].get<double>()
+                  << " shots_mean=" << summary["shots_mean"].get<double>() << "\n";
+        levels.push_back(std::move(summary));
+    }
+
+    std::size_t totalRuns = baseLevels.size() * static_cast<std::size_t>(options.runs);
+    std::cout << "total_runs=" << totalRuns
+              << " threads=" << pool.threadCount()
+              << " stolen=" << pool.stolenCount()
+              << " wall_s=" << wallSeconds
+              << " runs_per_s=" << (wallSeconds > 0.0 ? static_cast<double>(totalRuns) / wallSeconds : 0.0) << "\n";
+
+    if (!options.jsonPath.empty()) {
+        nlohmann::json doc = {{"seed", options.seed},
+                              {"runs_per_level", options.runs},
+                              {"threads", pool.threadCount()},
+                              {"jitter", options.jitter},
+                              {"aim_noise", options.aimNoise},
+                              {"power_noise", options.powerNoise},
+                              {"wall_s", wallSeconds},
+                              {"levels", levels}};
+        if (options.jsonPath == "-") {
+            std::cout << doc.dump(2) << "\n";
+        } else {
+            std::ofstream out(options.jsonPath);
+            if (out) {
+                out << doc.dump(2) << "\n";
+            } else {
+                std::cerr << "无法写入结果文件: " << options.jsonPath << "\n";
+            }
+        }
+    }
+
+    Logger::getInstance().close();
+    return 0;
+}
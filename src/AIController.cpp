@@ -8,8 +8,9 @@
 #include <tuple>
 #include <SFML/Graphics.hpp>
 
-#include "Game.hpp"
 #include "Material.hpp"
+#include "ThreadPool.hpp"
+#include "TrajectoryBatch.hpp"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -18,12 +19,23 @@
 // ========== 构造函数和析构函数 ==========
 
 AIController::AIController() {
-    Logger::getInstance().info("AI控制器初始化");
-    stats_ = PerformanceStats();
+    LOG_INFO("AI控制器初始化");
 }
 
 AIController::~AIController() {
-    Logger::getInstance().info("AI控制器销毁");
+    LOG_INFO("AI控制器销毁");
+}
+
+AIController::PerformanceStats AIController::getStats() const {
+    PerformanceStats snapshot;
+    snapshot.trajectoryCalculations = stats_.trajectoryCalculations.load(std::memory_order_relaxed);
+    snapshot.targetIdentifications = stats_.targetIdentifications.load(std::memory_order_relaxed);
+    long long totalUs = stats_.totalTrajectoryTimeUs.load(std::memory_order_relaxed);
+    if (snapshot.trajectoryCalculations > 0) {
+        snapshot.avgTrajectoryTimeMs = static_cast<float>(totalUs) / 1000.0f / snapshot.trajectoryCalculations;
+    }
+    snapshot.maxTrajectoryTimeMs = static_cast<float>(stats_.maxTrajectoryTimeUs.load(std::memory_order_relaxed)) / 1000.0f;
+    return snapshot;
 }
 
 // ========== 主更新函数 ==========
@@ -49,7 +61,7 @@ void AIController::update(float dt,
         if (trajectoryPreviewTimer_ >= kTrajectoryPreviewDuration) {
             trajectoryPreviewReady_ = true;
             trajectoryPreviewTimer_ = 0.0f;
-            Logger::getInstance().info("轨迹预览完成，准备发射");
+            LOG_INFO("轨迹预览完成，准备发射");
             // 立即设置发射标志，避免重新计算
             if (currentAim_.isValid) {
                 shouldLaunch_ = true;
@@ -64,9 +76,9 @@ void AIController::update(float dt,
                 if (nextBirdType == BirdType::Yellow) {
                     shouldActivateSkill_ = true;
                 }
-                Logger::getInstance().info("AI准备发射: 角度=" + std::to_string(currentAim_.angle) + 
-                                          "°, 力度=" + std::to_string(currentAim_.power) + 
-                                          "%, 误差=" + std::to_string(currentAim_.trajectoryError) + "%");
+                LOG_INFO("AI准备发射: 角度=" + std::to_string(currentAim_.angle) + 
+                        "°, 力度=" + std::to_string(currentAim_.power) + 
+                        "%, 误差=" + std::to_string(currentAim_.trajectoryError) + "%");
                 launchCooldown_ = kLaunchCooldownTime;
             }
         }
@@ -103,7 +115,7 @@ void AIController::update(float dt,
         }
         // 不记录日志（避免日志过多），只在第一次检测到时记录
         if (!waitingForBirdsLogged_ && activeBirdsCount > 0) {
-            Logger::getInstance().info("AI等待: 还有 " + std::to_string(activeBirdsCount) + " 只鸟在空中飞行");
+            LOG_INFO("AI等待: 还有 " + std::to_string(activeBirdsCount) + " 只鸟在空中飞行");
             waitingForBirdsLogged_ = true;
         }
         return;
@@ -113,7 +125,7 @@ void AIController::update(float dt,
             // 刚刚所有鸟都消失了，开始计时
             lastBirdWasActive_ = false;
             birdDisappearWaitTimer_ = 0.0f;
-            Logger::getInstance().info("AI等待: 所有鸟已消失，等待1秒后准备发射下一只");
+            LOG_INFO("AI等待: 所有鸟已消失，等待1秒后准备发射下一只");
         }
         
         // 如果正在等待中，继续等待
@@ -129,7 +141,7 @@ void AIController::update(float dt,
         
         // 等待时间已到，可以准备发射下一只
         if (waitingForBirdsLogged_) {
-            Logger::getInstance().info("AI等待结束: 等待时间已过，准备发射下一只");
+            LOG_INFO("AI等待结束: 等待时间已过，准备发射下一只");
             waitingForBirdsLogged_ = false;
         }
     }
@@ -183,17 +195,17 @@ void AIController::update(float dt,
         
         // 如果找到了有效目标，计算最佳瞄准
         if (selectedTarget.entityPtr != nullptr) {
-            Logger::getInstance().info("AI开始计算瞄准: 鸟类型=" + std::to_string(static_cast<int>(nextBirdType)) + 
-                                      ", 目标位置=(" + std::to_string(selectedTarget.position.x) + 
-                                      ", " + std::to_string(selectedTarget.position.y) + ")");
+            LOG_INFO("AI开始计算瞄准: 鸟类型=" + std::to_string(static_cast<int>(nextBirdType)) + 
+                    ", 目标位置=(" + std::to_string(selectedTarget.position.x) + 
+                    ", " + std::to_string(selectedTarget.position.y) + ")");
             
             currentAim_ = calculateOptimalAim(nextBirdType, selectedTarget, slingshotPos_);
             
             // 如果瞄准有效，检查误差
             if (currentAim_.isValid) {
-                Logger::getInstance().info("AI瞄准计算完成: 角度=" + std::to_string(currentAim_.angle) + 
-                                          "°, 力度=" + std::to_string(currentAim_.power) + 
-                                          "%, 误差=" + std::to_string(currentAim_.trajectoryError) + "%");
+                LOG_INFO("AI瞄准计算完成: 角度=" + std::to_string(currentAim_.angle) + 
+                        "°, 力度=" + std::to_string(currentAim_.power) + 
+                        "%, 误差=" + std::to_string(currentAim_.trajectoryError) + "%");
                 
                 // 对于不同鸟类，使用不同的误差阈值
                 // 黄鸟：轨迹计算复杂，放宽到5%
@@ -212,7 +224,7 @@ void AIController::update(float dt,
                     if (trajectoryPreviewTimer_ == 0.0f) {
                         trajectoryPreviewTimer_ = 0.001f;  // 启动计时器（很小的初始值）
                         trajectoryPreviewReady_ = false;
-                        Logger::getInstance().info("轨迹预览开始，等待1秒...");
+                        LOG_INFO("轨迹预览开始，等待1秒...");
                     }
                     
                     // 更新轨迹预览显示
@@ -221,14 +233,14 @@ void AIController::update(float dt,
                     // 轨迹预览中，不发射（等待计时器完成）
                     shouldLaunch_ = false;
                 } else {
-                    Logger::getInstance().info("AI瞄准误差过大: " + std::to_string(currentAim_.trajectoryError) + 
-                                              "% (阈值: " + std::to_string(errorThreshold) + "%)");
+                    LOG_INFO("AI瞄准误差过大: " + std::to_string(currentAim_.trajectoryError) + 
+                            "% (阈值: " + std::to_string(errorThreshold) + "%)");
                 }
             } else {
-                Logger::getInstance().info("AI未能找到有效瞄准方案");
+                LOG_INFO("AI未能找到有效瞄准方案");
             }
         } else {
-            Logger::getInstance().info("AI未找到有效目标");
+            LOG_INFO("AI未找到有效目标");
         }
     }
 }
@@ -237,7 +249,22 @@ void AIController::update(float dt,
 
 void AIController::analyzeLevelLayout(const std::vector<std::unique_ptr<Block>>& blocks,
                                      const std::vector<std::unique_ptr<Pig>>& pigs) {
+    // 增量分析：实体集合没变时只刷新醒着或掉血的实体，整个结构都在休眠时直接跳过
+    if (layoutValid_ && slingshotPos_ == analyzedSlingshotPos_) {
+        LayoutDelta delta = refreshLayout(blocks, pigs);
+        if (delta == LayoutDelta::None) {
+            return;
+        }
+        if (delta == LayoutDelta::Moved) {
+            stats_.targetIdentifications++;
+            rebuildObstacleIndex();
+            return;
+        }
+    }
+    
     stats_.targetIdentifications++;
+    layoutValid_ = true;
+    analyzedSlingshotPos_ = slingshotPos_;
     
     allTargets_.clear();
     pigTargets_.clear();
@@ -253,7 +280,8 @@ void AIController::analyzeLevelLayout(const std::vector<std::unique_ptr<Block>>&
         TargetInfo info;
         info.type = TargetInfo::Block;
         info.position = body->position();
-        info.size = sf::Vector2f(50.0f, 20.0f);  // 默认大小，可以从Entity获取
+        info.size = block->size();
+        info.angle = body->angle();
         info.health = block->health();
         info.maxHealth = block->maxHealth();
         info.materialName = block->material().name;
@@ -288,8 +316,87 @@ void AIController::analyzeLevelLayout(const std::vector<std::unique_ptr<Block>>&
         pigTargets_.push_back(info);
     }
     
+    rebuildObstacleIndex();
+}
+
+AIController::LayoutDelta AIController::refreshLayout(const std::vector<std::unique_ptr<Block>>& blocks,
+                                                      const std::vector<std::unique_ptr<Pig>>& pigs) {
+    // 与上次分析按顺序逐个比对：有实体被销毁/移除时返回 Structural 交给完整重建
+    // 休眠刚体不会移动，受伤必然伴随接触（接触会唤醒刚体），这里仍比对血量以防万一
+    bool moved = false;
+    const size_t pigOffset = blockTargets_.size();
+    
+    size_t index = 0;
+    for (const auto& block : blocks) {
+        if (!block || block->isDestroyed()) continue;
+        auto* body = block->body();
+        if (!body || !body->active()) continue;
+        
+        if (index >= blockTargets_.size() || blockTargets_[index].entityPtr != block.get()) {
+            return LayoutDelta::Structural;
+        }
+        auto& info = blockTargets_[index];
+        if (body->awake() || block->health() != info.health) {
+            info.position = body->position();
+            info.angle = body->angle();
+            info.health = block->health();
+            
+            auto& target = allTargets_[index];
+            target.position = info.position;
+            target.angle = info.angle;
+            target.health = info.health;
+            moved = true;
+        }
+        ++index;
+    }
+    if (index != blockTargets_.size()) {
+        return LayoutDelta::Structural;
+    }
+    
+    index = 0;
+    for (const auto& pig : pigs) {
+        if (!pig || pig->isDestroyed()) continue;
+        auto* body = pig->body();
+        if (!body || !body->active()) continue;
+        
+        if (index >= pigTargets_.size() || pigTargets_[index].entityPtr != pig.get()) {
+            return LayoutDelta::Structural;
+        }
+        auto& info = pigTargets_[index];
+        if (body->awake() || pig->health() != info.health) {
+            info.position = body->position();
+            info.health = pig->health();
+            info.threatValue = calculateThreatLevel(info);
+            info.attackValue = calculateAttackValue(info, slingshotPos_);
+            
+            auto& target = allTargets_[pigOffset + index];
+            target.position = info.position;
+            target.health = info.health;
+            target.threatValue = info.threatValue;
+            target.attackValue = info.attackValue;
+            moved = true;
+        }
+        ++index;
+    }
+    if (index != pigTargets_.size()) {
+        return LayoutDelta::Structural;
+    }
+    
+    return moved ? LayoutDelta::Moved : LayoutDelta::None;
+}
+
+void AIController::rebuildObstacleIndex() {
+    // 方块空间索引：本轮分析内的层数统计、射线检测都走网格，不再逐个扫描方块
+    std::vector<ObstacleGrid::Box> boxes;
+    boxes.reserve(blockTargets_.size());
+    for (const auto& block : blockTargets_) {
+        // 被撞歪的方块按真实朝向登记：外接 AABB 入格，线段求交按旋转后的盒子
+        boxes.push_back(ObstacleGrid::Box::oriented(block.position, block.size, block.angle));
+    }
+    blockGrid_.build(std::move(boxes));
+    
     // 计算障碍物层级（用于炸弹鸟）
-    calculateObstacleLayers(allTargets_, blockTargets_);
+    calculateObstacleLayers();
 }
 
 // ========== 子系统2: 差异化目标选择 ==========
@@ -449,71 +556,37 @@ TargetInfo AIController::selectTargetForYellowBird(const std::vector<TargetInfo>
     return bestTarget;
 }
 
-void AIController::calculateObstacleLayers(const std::vector<TargetInfo>& allTargets,
-                                           const std::vector<TargetInfo>& blocks) {
-    // 为每个目标计算障碍物层级数
-    for (auto& target : const_cast<std::vector<TargetInfo>&>(allTargets)) {
-        if (target.type == TargetInfo::Pig) {
-            target.obstacleLayerCount = countObstacleLayers(target, blocks, slingshotPos_);
-        }
-    }
-    
-    // 同步到pigTargets_
-    for (auto& pig : pigTargets_) {
-        for (const auto& target : allTargets) {
-            if (target.entityPtr == pig.entityPtr) {
-                pig.obstacleLayerCount = target.obstacleLayerCount;
-                pig.blockingBlocks = target.blockingBlocks;
-                break;
-            }
-        }
+void AIController::calculateObstacleLayers() {
+    // 为每只猪计算障碍物层级数
+    // allTargets_ 中方块在前、猪在后，且猪的顺序与 pigTargets_ 一致，按偏移直接同步
+    const size_t pigOffset = allTargets_.size() - pigTargets_.size();
+    for (size_t i = 0; i < pigTargets_.size(); ++i) {
+        auto& pig = pigTargets_[i];
+        pig.obstacleLayerCount = countObstacleLayers(pig, slingshotPos_, pig.blockingBlocks);
+        
+        auto& target = allTargets_[pigOffset + i];
+        target.obstacleLayerCount = pig.obstacleLayerCount;
+        target.blockingBlocks = pig.blockingBlocks;
     }
 }
 
 int AIController::countObstacleLayers(const TargetInfo& target,
-                                     const std::vector<TargetInfo>& blocks,
-                                     const sf::Vector2f& slingshotPos) {
-    // 使用射线检测计算从弹弓到目标的障碍物层数
-    sf::Vector2f direction = normalize(target.position - slingshotPos);
-    float dist = distance(target.position, slingshotPos);
-    
-    std::vector<std::pair<float, size_t>> intersections;  // (distance, blockIndex)
-    
-    // 检查每个方块是否与射线相交
-    for (size_t i = 0; i < blocks.size(); ++i) {
-        const auto& block = blocks[i];
-        sf::Vector2f blockCenter = block.position;
-        sf::Vector2f blockSize = block.size;
-        
-        // 简单的AABB射线相交检测
-        sf::Vector2f min = blockCenter - blockSize * 0.5f;
-        sf::Vector2f max = blockCenter + blockSize * 0.5f;
-        
-        // 简化的射线-AABB相交（这里使用中心点距离作为近似）
-        sf::Vector2f toBlock = blockCenter - slingshotPos;
-        float projDist = std::abs(toBlock.x * direction.x + toBlock.y * direction.y);
-        
-        if (projDist < dist && length(toBlock) < dist) {
-            // 检查是否在方块的包围盒内（简化检测）
-            sf::Vector2f projPoint = slingshotPos + direction * projDist;
-            if (projPoint.x >= min.x && projPoint.x <= max.x &&
-                projPoint.y >= min.y && projPoint.y <= max.y) {
-                intersections.push_back({projDist, i});
-            }
-        }
-    }
-    
-    // 按距离排序
-    std::sort(intersections.begin(), intersections.end(),
-              [](const auto& a, const auto& b) { return a.first < b.first; });
-    
-    // 返回层数（最多计算到目标的距离）
+                                     const sf::Vector2f& slingshotPos,
+                                     std::vector<size_t>& blockingBlocks) const {
+    // 从弹弓到目标中心的线段与方块（按真实尺寸和朝向）求交（slab 法），按进入点排序
+    std::vector<ObstacleGrid::Hit> hits;
+    blockGrid_.raycast(slingshotPos, target.position, hits);
+    
+    // 返回层数：进入点相同的方块视为同一层
+    blockingBlocks.clear();
     int layerCount = 0;
-    float currentDist = 0.0f;
-    for (const auto& intersection : intersections) {
-        if (intersection.first > currentDist && intersection.first < dist) {
+    float currentT = -1.0f;
+    for (const auto& hit : hits) {
+        if (hit.t >= 1.0f) continue;
+        blockingBlocks.push_back(hit.index);
+        if (hit.t > currentT) {
             layerCount++;
-            currentDist = intersection.first;
+            currentT = hit.t;
         }
     }
     
@@ -564,9 +637,10 @@ TrajectoryResult AIController::calculateTrajectory(const sf::Vector2f& startPos,
                                                    BirdType birdType,
                                                    bool useSkill,
                                                    const TargetInfo& target,
-                                                   float maxTime) {
+                                                   float maxTime,
+                                                   bool recordPoints) {
     auto startTime = std::chrono::high_resolution_clock::now();
-    stats_.trajectoryCalculations++;
+    stats_.trajectoryCalculations.fetch_add(1, std::memory_order_relaxed);
     
     TrajectoryResult result;
     
@@ -574,33 +648,41 @@ TrajectoryResult AIController::calculateTrajectory(const sf::Vector2f& startPos,
     if (birdType == BirdType::Yellow && useSkill) {
         // 黄鸟使用特殊轨迹计算
         float skillTime = 0.2f;  // 默认技能激活时间
-        result = calculateYellowBirdTrajectory(startPos, velocity, skillTime, target, maxTime);
+        result = calculateYellowBirdTrajectory(startPos, velocity, skillTime, target, maxTime, recordPoints);
     } else {
         // 标准轨迹计算
         sf::Vector2f pos = startPos;
         sf::Vector2f vel = velocity;
         
         // 获取鸟的最大速度
-        float maxSpeed = config::kMaxBodySpeed;
-        switch (birdType) {
-            case BirdType::Red:
-                maxSpeed = config::bird_speed::kRedMaxSpeed;
-                break;
-            case BirdType::Yellow:
-                maxSpeed = useSkill ? config::bird_speed::kYellowMaxSpeed : config::bird_speed::kYellowInitialMax;
-                break;
-            case BirdType::Bomb:
-                maxSpeed = config::bird_speed::kBombMaxSpeed;
-                break;
-        }
+        float maxSpeed = flightMaxSpeed(birdType, useSkill);
         
         const float dt = 0.02f;  // 20ms步长
         const int maxSteps = static_cast<int>(maxTime / dt);
         float closestDist = std::numeric_limits<float>::max();
         sf::Vector2f closestPoint;
+        if (recordPoints) {
+            result.points.reserve(maxSteps);
+        }
+        
+        // 简化碰撞检测：检查是否在目标范围内
+        float targetRadius = target.size.x;  // 对于方块，使用宽度的一半
+        if (target.type == TargetInfo::Pig) {
+            targetRadius = target.size.x;  // 猪的半径
+        } else {
+            targetRadius = std::max(target.size.x, target.size.y) * 0.5f;
+        }
+        
+        // 对于炸弹鸟，扩大碰撞检测范围（因为爆炸范围大）
+        float collisionRadius = targetRadius + 10.0f;
+        if (birdType == BirdType::Bomb) {
+            collisionRadius = targetRadius + 30.0f;  // 炸弹鸟有更大的爆炸范围
+        }
         
         for (int i = 0; i < maxSteps; ++i) {
-            result.points.push_back(pos);
+            if (recordPoints) {
+                result.points.push_back(pos);
+            }
             
             // 检查是否击中目标
             float distToTarget = distance(pos, target.position);
@@ -609,20 +691,6 @@ TrajectoryResult AIController::calculateTrajectory(const sf::Vector2f& startPos,
                 closestPoint = pos;
             }
             
-            // 简化碰撞检测：检查是否在目标范围内
-            float targetRadius = target.size.x;  // 对于方块，使用宽度的一半
-            if (target.type == TargetInfo::Pig) {
-                targetRadius = target.size.x;  // 猪的半径
-            } else {
-                targetRadius = std::max(target.size.x, target.size.y) * 0.5f;
-            }
-            
-            // 对于炸弹鸟，扩大碰撞检测范围（因为爆炸范围大）
-            float collisionRadius = targetRadius + 10.0f;
-            if (birdType == BirdType::Bomb) {
-                collisionRadius = targetRadius + 30.0f;  // 炸弹鸟有更大的爆炸范围
-            }
-            
             if (distToTarget < collisionRadius) {
                 result.hitTarget = true;
                 result.hitTime = i * dt;
@@ -632,8 +700,14 @@ TrajectoryResult AIController::calculateTrajectory(const sf::Vector2f& startPos,
             }
             
             // 应用物理（返回更新后的位置和速度）
+            sf::Vector2f prev = pos;
             std::tie(pos, vel) = applyPhysicsStep(pos, vel, dt, maxSpeed);
             
+            if (predictObstacles_ && resolveObstacleContact(prev, pos, target, collisionRadius, (i + 1) * dt,
+                                                            recordPoints, result, closestDist, closestPoint)) {
+                break;
+            }
+            
             // 边界检查
             if (pos.y > static_cast<float>(config::kWindowHeight) + 100.0f || 
                 pos.x < -100.0f || pos.x > static_cast<float>(config::kWindowWidth) + 100.0f) {
@@ -649,14 +723,14 @@ TrajectoryResult AIController::calculateTrajectory(const sf::Vector2f& startPos,
         result.finalVelocity = length(vel);
     }
     
-    // 性能统计
+    // 性能统计（可能在多个搜索线程中并发执行，使用原子累加）
     auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-    float timeMs = duration.count() / 1000.0f;
+    long long timeUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
     
-    stats_.avgTrajectoryTimeMs = (stats_.avgTrajectoryTimeMs * (stats_.trajectoryCalculations - 1) + timeMs) / stats_.trajectoryCalculations;
-    if (timeMs > stats_.maxTrajectoryTimeMs) {
-        stats_.maxTrajectoryTimeMs = timeMs;
+    stats_.totalTrajectoryTimeUs.fetch_add(timeUs, std::memory_order_relaxed);
+    long long prevMax = stats_.maxTrajectoryTimeUs.load(std::memory_order_relaxed);
+    while (timeUs > prevMax &&
+           !stats_.maxTrajectoryTimeUs.compare_exchange_weak(prevMax, timeUs, std::memory_order_relaxed)) {
     }
     
     return result;
@@ -666,7 +740,8 @@ TrajectoryResult AIController::calculateYellowBirdTrajectory(const sf::Vector2f&
                                                             const sf::Vector2f& initialVelocity,
                                                             float skillActivationTime,
                                                             const TargetInfo& target,
-                                                            float maxTime) {
+                                                            float maxTime,
+                                                            bool recordPoints) {
     TrajectoryResult result;
     
     sf::Vector2f pos = startPos;
@@ -689,19 +764,29 @@ TrajectoryResult AIController::calculateYellowBirdTrajectory(const sf::Vector2f&
     if (currentSpeed > 0.001f) {
         float newSpeed = std::min(currentSpeed * 2.0f, maxSpeed);  // 翻倍但不超过1500
         vel = normalize(vel) * newSpeed;
-        Logger::getInstance().info("黄鸟轨迹计算: 初始速度=" + std::to_string(currentSpeed) + 
-                                  ", 技能后速度=" + std::to_string(newSpeed));
+        // 注意：此函数会在搜索线程中对每个候选调用，不在这里写日志
     }
     
     float closestDist = std::numeric_limits<float>::max();
     sf::Vector2f closestPoint;
+    if (recordPoints) {
+        result.points.reserve(maxSteps);
+    }
+    
+    float targetRadius = target.size.x;
+    if (target.type == TargetInfo::Block) {
+        targetRadius = std::max(target.size.x, target.size.y) * 0.5f;
+    }
+    const float collisionRadius = targetRadius + 10.0f;
     
     for (int i = 0; i < maxSteps; ++i) {
         currentTime += dt;
         
         // 技能已经在开始时激活，不需要再次检查
         
-        result.points.push_back(pos);
+        if (recordPoints) {
+            result.points.push_back(pos);
+        }
         
         // 检查碰撞
         float distToTarget = distance(pos, target.position);
@@ -710,12 +795,7 @@ TrajectoryResult AIController::calculateYellowBirdTrajectory(const sf::Vector2f&
             closestPoint = pos;
         }
         
-        float targetRadius = target.size.x;
-        if (target.type == TargetInfo::Block) {
-            targetRadius = std::max(target.size.x, target.size.y) * 0.5f;
-        }
-        
-        if (distToTarget < targetRadius + 10.0f) {
+        if (distToTarget < collisionRadius) {
             result.hitTarget = true;
             result.hitTime = currentTime;
             result.hitPoint = pos;
@@ -724,8 +804,14 @@ TrajectoryResult AIController::calculateYellowBirdTrajectory(const sf::Vector2f&
         }
         
         // 应用物理（返回更新后的位置和速度）
+        sf::Vector2f prev = pos;
         std::tie(pos, vel) = applyPhysicsStep(pos, vel, dt, maxSpeed);
         
+        if (predictObstacles_ && resolveObstacleContact(prev, pos, target, collisionRadius, currentTime + dt,
+                                                        recordPoints, result, closestDist, closestPoint)) {
+            break;
+        }
+        
         // 边界检查
         if (pos.y > static_cast<float>(config::kWindowHeight) + 100.0f || 
             pos.x < -100.0f || pos.x > static_cast<float>(config::kWindowWidth) + 100.0f) {
@@ -742,58 +828,83 @@ TrajectoryResult AIController::calculateYellowBirdTrajectory(const sf::Vector2f&
     return result;
 }
 
-std::pair<sf::Vector2f, sf::Vector2f> AIController::applyPhysicsStep(sf::Vector2f pos, sf::Vector2f vel, float dt, float maxSpeed) {
-    // 应用重力
-    vel.y += config::kGravity * dt;
-    
-    // 应用空气阻力
-    float speed = length(vel);
-    if (speed > 0.001f) {
-        const float airResistanceAccelPixels = config::kAirResistanceAccel * config::kPixelsPerMeter;
-        sf::Vector2f resistanceDir = normalize(vel);
-        sf::Vector2f resistanceAccel = -resistanceDir * airResistanceAccelPixels;
-        vel += resistanceAccel * dt;
-        
-        // 重新计算速度（空气阻力可能改变了速度大小）
-        speed = length(vel);
+bool AIController::firstObstacleContact(const sf::Vector2f& from, const sf::Vector2f& to,
+                                        const TargetInfo& target, sf::Vector2f& contact) const {
+    ObstacleGrid::Hit hit;
+    if (!blockGrid_.firstHit(from, to, hit)) {
+        return false;
     }
-    
-    // 限制速度（必须在应用重力和空气阻力之后检查）
-    if (speed > maxSpeed) {
-        vel = normalize(vel) * maxSpeed;
+    if (blockTargets_[hit.index].entityPtr == target.entityPtr) {
+        return false;  // 最先碰到的就是目标方块，交给目标距离判定
+    }
+    contact = from + (to - from) * hit.t;
+    return true;
+}
+
+bool AIController::resolveObstacleContact(const sf::Vector2f& from, const sf::Vector2f& to,
+                                          const TargetInfo& target, float collisionRadius, float time,
+                                          bool recordPoints, TrajectoryResult& result,
+                                          float& closestDist, sf::Vector2f& closestPoint) const {
+    sf::Vector2f contact;
+    if (!firstObstacleContact(from, to, target, contact)) {
+        return false;
     }
     
-    // 更新位置
-    pos += vel * dt;
+    // 首次接触即结束轨迹：之后的飞行取决于碰撞结果，按接触点打分
+    result.hitObstacle = true;
+    result.obstacleContact = contact;
+    if (recordPoints) {
+        result.points.push_back(contact);
+    }
     
-    return std::make_pair(pos, vel);
+    // 撞上紧贴目标的方块（在碰撞半径内）仍算击中，例如炸弹鸟落在猪旁边
+    float contactDist = distance(contact, target.position);
+    if (contactDist < collisionRadius) {
+        result.hitTarget = true;
+        result.hitTime = time;
+        result.hitPoint = contact;
+        result.minDistanceToTarget = contactDist;
+    } else if (contactDist < closestDist) {
+        closestDist = contactDist;
+        closestPoint = contact;
+    }
+    return true;
+}
+
+std::pair<sf::Vector2f, sf::Vector2f> AIController::applyPhysicsStep(sf::Vector2f pos, sf::Vector2f vel, float dt, float maxSpeed) {
+    // 与玩家拖拽预览共用同一积分器（见 TrajectoryPreview.hpp）
+    return integrateFlightStep(pos, vel, dt, maxSpeed);
 }
 
 float AIController::calculateAirResistance(float speed) {
     return config::kAirResistanceAccel * config::kPixelsPerMeter;
 }
 
+float AIController::flightMaxSpeed(BirdType birdType, bool useSkill) const {
+    return birdFlightMaxSpeed(birdType, useSkill);
+}
+
+void AIController::setFlightLaunch(AimingInfo& aim, sf::Vector2f velocity, BirdType birdType, bool useSkill) const {
+    // 与 calculateTrajectory 相同：黄鸟技能在发射瞬间让速度翻倍（不超过技能后的上限）
+    aim.flightMaxSpeed = flightMaxSpeed(birdType, useSkill);
+    if (birdType == BirdType::Yellow && useSkill) {
+        float speed = length(velocity);
+        if (speed > 0.001f) {
+            velocity = normalize(velocity) * std::min(speed * 2.0f, aim.flightMaxSpeed);
+        }
+    }
+    aim.flightVelocity = velocity;
+}
+
 // ========== 轨迹预览更新 ==========
 
 void AIController::updateTrajectoryPreview() {
-    // 生成轨迹预览（只计算1秒的轨迹）
-    trajectoryPreview_.clear();
-    if (currentAim_.isValid && !currentAim_.trajectoryPoints.empty()) {
-        // 计算1秒内的轨迹点（假设60fps，1秒约60个点）
-        const float previewTime = 1.0f;
-        const float dt = 0.0167f;  // 约60fps的时间步长
-        const int maxPreviewSteps = static_cast<int>(previewTime / dt);
-        
-        // 使用已有的轨迹点，但只取前1秒的
-        int pointsToShow = std::min(static_cast<int>(currentAim_.trajectoryPoints.size()), maxPreviewSteps);
-        
-        for (int i = 0; i < pointsToShow; ++i) {
-            const auto& pt = currentAim_.trajectoryPoints[i];
-            float alpha = 255.0f * (1.0f - static_cast<float>(i) / pointsToShow);
-            unsigned char alphaByte = static_cast<unsigned char>(alpha);
-            trajectoryPreview_.emplace_back(pt, sf::Color(255u, 255u, 0u, alphaByte));
-        }
+    // 预览前1秒的飞行轨迹；瞄准结果不变时 TrajectoryPreview 直接复用上次的顶点
+    if (!currentAim_.isValid) {
+        trajectoryPreview_.clear();
+        return;
     }
+    trajectoryPreview_.update(currentAim_.dragStart, currentAim_.flightVelocity, currentAim_.flightMaxSpeed);
 }
 
 // ========== 子系统4: 发射参数计算 ==========
@@ -801,14 +912,170 @@ void AIController::updateTrajectoryPreview() {
 AimingInfo AIController::calculateOptimalAim(BirdType birdType,
                                              const TargetInfo& target,
                                              const sf::Vector2f& slingshotPos) {
-    AimingInfo aim;
+    auto solve = [&] {
+        AimingInfo result;
+        // 优先使用解析求解（微秒级），找不到足够精确的解时回退到网格搜索
+        if (aimSolver_ == AimSolver::Analytic) {
+            result = solveLaunchAnalytic(birdType, target, slingshotPos);
+        }
+        if (!result.isValid) {
+            result = optimizeLaunchParameters(birdType, target, slingshotPos);
+        }
+        return result;
+    };
+    
+    // 先求绕开方块的解；目标被完全包住时所有候选都会先撞墙，
+    // 这时退回不考虑障碍物的搜索（直接砸开外层结构）
+    constexpr float kObstacleAcceptError = 3.0f;
+    predictObstacles_ = obstacleAware_ && !blockGrid_.empty();
+    AimingInfo aim = solve();
+    if (predictObstacles_ && (!aim.isValid || aim.trajectoryError >= kObstacleAcceptError)) {
+        predictObstacles_ = false;
+        AimingInfo direct = solve();
+        if (direct.isValid && (!aim.isValid || direct.trajectoryError < aim.trajectoryError)) {
+            aim = std::move(direct);
+        }
+    }
+    predictObstacles_ = false;
+    
     aim.target = target;
     aim.dragStart = slingshotPos;
+    return aim;
+}
+
+AimingInfo AIController::solveLaunchAnalytic(BirdType birdType,
+                                             const TargetInfo& target,
+                                             const sf::Vector2f& slingshotPos) {
+    AimingInfo bestAim;
+    bestAim.isValid = false;
     
-    // 使用迭代优化找到最佳角度和力度
-    aim = optimizeLaunchParameters(birdType, target, slingshotPos);
+    const float dx = target.position.x - slingshotPos.x;
+    const float dyUp = slingshotPos.y - target.position.y;  // 目标高于弹弓为正
+    if (dx <= 1.0f) {
+        return bestAim;  // 目标在弹弓后方或正上方，交给网格搜索
+    }
     
-    return aim;
+    const bool useSkill = (birdType == BirdType::Yellow);
+    const float baseMaxSpeed = length(velocityFromAngleAndPower(0.0f, 100.0f, birdType));
+    const float maxTrajectoryTime = (birdType == BirdType::Bomb) ? 8.0f : 5.0f;
+    const float targetSize = std::max(target.size.x, target.size.y);
+    const float g = config::kGravity;
+    const float degPerRad = static_cast<float>(180.0 / M_PI);
+    
+    constexpr int kNewtonIterations = 4;       // 割线迭代次数上限
+    constexpr float kMissTolerance = 0.5f;     // 竖直偏差容差（像素）
+    constexpr float kAcceptError = 3.0f;       // 解析解可接受的误差（%），否则回退网格搜索
+    
+    float bestError = std::numeric_limits<float>::max();
+    float bestAngle = 0.0f;
+    float bestPower = 0.0f;
+    sf::Vector2f bestVelocity;
+    
+    // 力度从大到小尝试（优先平直有力的弹道），每个力度先低抛后高抛
+    for (float power = 100.0f; power >= 20.0f && bestError >= 1.0f; power -= 5.0f) {
+        float launchSpeed = (power / 100.0f) * baseMaxSpeed;
+        // 黄鸟技能在发射时立即翻倍（受限于飞行速度上限）
+        float v = useSkill ? std::min(launchSpeed * 2.0f, flightMaxSpeed(birdType, useSkill)) : launchSpeed;
+        
+        float v2 = v * v;
+        float disc = v2 * v2 - g * (g * dx * dx + 2.0f * dyUp * v2);
+        if (disc < 0.0f) continue;  // 该力度无阻力时也够不到目标
+        float sqrtDisc = std::sqrt(disc);
+        
+        for (float sign : {-1.0f, 1.0f}) {
+            float angle = std::atan((v2 + sign * sqrtDisc) / (g * dx)) * degPerRad;
+            if (angle < 5.0f || angle > 85.0f) continue;
+            
+            // 割线法修正阻力与速度限制带来的偏差
+            auto miss = [&](float a) {
+                return verticalMissAtTarget(slingshotPos, velocityFromAngleAndPower(a, power, birdType),
+                                            birdType, useSkill, target.position, maxTrajectoryTime);
+            };
+            float a0 = angle;
+            float f0 = miss(a0);
+            if (std::isnan(f0)) continue;
+            float a1 = angle + 0.5f;
+            float f1 = miss(a1);
+            for (int iter = 0; iter < kNewtonIterations && std::abs(f0) > kMissTolerance; ++iter) {
+                if (std::isnan(f1) || std::abs(f1 - f0) < 1e-4f) break;
+                float a2 = std::clamp(a1 - f1 * (a1 - a0) / (f1 - f0), 5.0f, 85.0f);
+                a0 = a1;
+                f0 = f1;
+                a1 = a2;
+                f1 = miss(a1);
+                if (!std::isnan(f1) && std::abs(f1) < std::abs(f0)) {
+                    std::swap(a0, a1);
+                    std::swap(f0, f1);
+                }
+            }
+            
+            // 用与网格搜索相同的评估方式打分
+            sf::Vector2f velocity = velocityFromAngleAndPower(a0, power, birdType);
+            TrajectoryResult traj = calculateTrajectory(
+                slingshotPos, velocity, birdType, useSkill, target, maxTrajectoryTime, false);
+            float error = traj.hitTarget ? 0.0f : traj.minDistanceToTarget;
+            float errorPercent = (error / targetSize) * 100.0f;
+            if (errorPercent < bestError) {
+                bestError = errorPercent;
+                bestAngle = a0;
+                bestPower = power;
+                bestVelocity = velocity;
+            }
+            if (bestError < 1.0f) break;
+        }
+    }
+    
+    if (bestError >= kAcceptError) {
+        return bestAim;
+    }
+    
+    TrajectoryResult bestTraj = calculateTrajectory(
+        slingshotPos, bestVelocity, birdType, useSkill, target, maxTrajectoryTime, true);
+    
+    bestAim.isValid = true;
+    bestAim.angle = bestAngle;
+    bestAim.power = bestPower;
+    bestAim.trajectoryError = bestError;
+    bestAim.trajectoryPoints = std::move(bestTraj.points);
+    bestAim.predictedHitPoint = bestTraj.hitPoint;
+    applyDragFromVelocity(bestAim, bestVelocity, birdType, baseMaxSpeed, slingshotPos);
+    setFlightLaunch(bestAim, bestVelocity, birdType, useSkill);
+    if (useSkill) {
+        bestAim.skillActivationTime = 0.0f;  // 发射时立即激活
+    }
+    return bestAim;
+}
+
+float AIController::verticalMissAtTarget(const sf::Vector2f& startPos, const sf::Vector2f& velocity,
+                                         BirdType birdType, bool useSkill,
+                                         const sf::Vector2f& targetPos, float maxTime) {
+    sf::Vector2f pos = startPos;
+    sf::Vector2f vel = velocity;
+    float maxSpeed = flightMaxSpeed(birdType, useSkill);
+    
+    // 与 calculateYellowBirdTrajectory 一致：技能在发射时立即翻倍
+    if (birdType == BirdType::Yellow && useSkill) {
+        float speed = length(vel);
+        if (speed > 0.001f) {
+            vel = normalize(vel) * std::min(speed * 2.0f, maxSpeed);
+        }
+    }
+    
+    const float dt = 0.02f;  // 与轨迹计算相同的步长
+    const int maxSteps = static_cast<int>(maxTime / dt);
+    for (int i = 0; i < maxSteps; ++i) {
+        sf::Vector2f prev = pos;
+        std::tie(pos, vel) = applyPhysicsStep(pos, vel, dt, maxSpeed);
+        if (pos.x >= targetPos.x) {
+            float t = (targetPos.x - prev.x) / std::max(0.0001f, pos.x - prev.x);
+            float y = prev.y + t * (pos.y - prev.y);
+            return y - targetPos.y;
+        }
+        if (pos.y > static_cast<float>(config::kWindowHeight) + 100.0f) {
+            break;
+        }
+    }
+    return std::numeric_limits<float>::quiet_NaN();
 }
 
 AimingInfo AIController::optimizeLaunchParameters(BirdType birdType,
@@ -816,106 +1083,74 @@ AimingInfo AIController::optimizeLaunchParameters(BirdType birdType,
                                                   const sf::Vector2f& slingshotPos) {
     AimingInfo bestAim;
     bestAim.isValid = false;
-    float bestError = std::numeric_limits<float>::max();
     
     // 获取初始最大速度限制
     float baseMaxSpeed = config::bird_speed::kRedInitialMax;
-    float maxSpeed = config::bird_speed::kRedMaxSpeed;
     bool useSkill = false;
     
     switch (birdType) {
         case BirdType::Red:
             baseMaxSpeed = config::bird_speed::kRedInitialMax;
-            maxSpeed = config::bird_speed::kRedMaxSpeed;
             break;
         case BirdType::Yellow:
             // 黄鸟在AI模式下允许2倍拉弓距离，但实际发射速度仍限制为kYellowInitialMax (500)
             // 然后立即激活技能，速度翻倍到1000（但受限于kYellowMaxSpeed = 1500）
             // AI计算时使用2倍速度假设，以模拟技能激活后的效果
             baseMaxSpeed = config::bird_speed::kYellowInitialMax * 2.0f;  // AI计算用：假设初始速度可达1000
-            maxSpeed = config::bird_speed::kYellowMaxSpeed;                // 技能后速度：1500
             useSkill = true;  // 黄鸟默认使用技能
             break;
         case BirdType::Bomb:
             baseMaxSpeed = config::bird_speed::kBombInitialMax;
-            maxSpeed = config::bird_speed::kBombMaxSpeed;
             break;
     }
     
-    // 注意：baseMaxSpeed是初始发射速度限制，轨迹计算时会考虑技能加速
-    
-    // 迭代搜索最佳角度和力度
-    // 角度范围：5-85度，步长2度（扩大范围以找到更多可能的角度）
-    // 对于炸弹鸟，角度范围可以更大（包括更小的角度）
-    // 力度范围：20-100%，步长5%（降低最小力度，允许更小的力度）
-    // 如果找到误差<3%的解决方案，提前终止
-    float angleStep = (birdType == BirdType::Bomb) ? 1.5f : 2.0f;  // 炸弹鸟使用更小的步长
-    for (float angle = 5.0f; angle <= 85.0f; angle += angleStep) {
-        // 如果已经找到很好的解，可以进行精细搜索
-        if (bestError < 3.0f && angle > 5.0f) {
-            // 在最佳角度附近进行精细搜索
-            float fineAngleStart = std::max(5.0f, angle - 4.0f);
-            float fineAngleEnd = std::min(85.0f, angle + 4.0f);
-            for (float fineAngle = fineAngleStart; fineAngle <= fineAngleEnd; fineAngle += 1.0f) {
-                if (fineAngle == angle) continue;  // 跳过已经计算过的角度
-                
-                for (float power = 20.0f; power <= 100.0f; power += 5.0f) {
-                    sf::Vector2f velocity = velocityFromAngleAndPower(fineAngle, power, birdType);
-                    
-                    float speed = length(velocity);
-                    if (speed > baseMaxSpeed) {
-                        velocity = normalize(velocity) * baseMaxSpeed;
-                    }
-                    
-                    // 对于炸弹鸟，使用更长的计算时间以覆盖远距离目标
-                    float maxTrajectoryTime = (birdType == BirdType::Bomb) ? 8.0f : 5.0f;
-                    TrajectoryResult traj = calculateTrajectory(
-                        slingshotPos, velocity, birdType, useSkill, target, maxTrajectoryTime);
-                    
-                    float error = traj.minDistanceToTarget;
-                    if (traj.hitTarget) error = 0.0f;
-                    
-                    float targetSize = std::max(target.size.x, target.size.y);
-                    float errorPercent = (error / targetSize) * 100.0f;
-                    
-                    if (errorPercent < bestError) {
-                        bestError = errorPercent;
-                        bestAim.isValid = true;
-                        bestAim.angle = fineAngle;
-                        bestAim.power = power;
-                        bestAim.trajectoryError = errorPercent;
-                        bestAim.trajectoryPoints = traj.points;
-                        bestAim.predictedHitPoint = traj.hitPoint;
-                        
-                        sf::Vector2f pull = -velocity / config::kSlingshotStiffness;
-                        float pullDist = length(pull);
-                        float maxPull = config::kMaxPullDistance;
-                        if (birdType == BirdType::Yellow) {
-                            maxPull = config::kMaxPullDistance * 2.0f;
-                        }
-                        
-                        if (pullDist > maxPull) {
-                            pull = normalize(pull) * maxPull;
-                            // 重新计算速度，确保与限制后的pull一致
-                            velocity = -pull * config::kSlingshotStiffness;
-                            // 限制速度到baseMaxSpeed
-                            float speed = length(velocity);
-                            if (speed > baseMaxSpeed) {
-                                velocity = normalize(velocity) * baseMaxSpeed;
-                            }
-                        }
-                        
-                        bestAim.dragEnd = slingshotPos + pull;
-                        
-                        if (birdType == BirdType::Yellow && useSkill) {
-                            bestAim.skillActivationTime = 0.0f;  // 立即激活
-                        }
-                    }
-                }
-            }
-        }
+    // 对于炸弹鸟，使用更长的计算时间以覆盖远距离目标
+    const float maxTrajectoryTime = (birdType == BirdType::Bomb) ? 8.0f : 5.0f;
+    const float targetSize = std::max(target.size.x, target.size.y);
+    
+    // 每个角度（一行）的力度 20-100%（步长5%）作为一个批次评估，行之间并行
+    // 候选只做评估（不记录轨迹点），最终胜出的候选再重新积分一次生成轨迹点
+    struct RowBest {
+        float error{std::numeric_limits<float>::max()};
+        float angle{0.0f};
+        float power{0.0f};
+        sf::Vector2f velocity;
+    };
+    
+    // 一行的 17 个力度候选组成 SoA 批次，由 SIMD 内核一次推进（见 TrajectoryBatch.hpp）
+    // 黄鸟技能在发射瞬间生效：这里预先把速度翻倍（不超过1500），与 calculateYellowBirdTrajectory 一致
+    const bool yellowSkill = (birdType == BirdType::Yellow && useSkill);
+    float targetRadius = target.size.x;  // 猪的半径
+    if (target.type != TargetInfo::Pig) {
+        targetRadius = std::max(target.size.x, target.size.y) * 0.5f;
+    }
+    TrajectoryBatchParams batch;
+    batch.startX = slingshotPos.x;
+    batch.startY = slingshotPos.y;
+    batch.targetX = target.position.x;
+    batch.targetY = target.position.y;
+    batch.collisionRadius = targetRadius + ((birdType == BirdType::Bomb && !yellowSkill) ? 30.0f : 10.0f);
+    batch.maxSpeed = yellowSkill ? config::bird_speed::kYellowMaxSpeed : flightMaxSpeed(birdType, useSkill);
+    batch.gravity = config::kGravity;
+    batch.airAccel = config::kAirResistanceAccel * config::kPixelsPerMeter;
+    batch.dt = 0.02f;
+    batch.maxSteps = static_cast<int>(maxTrajectoryTime / batch.dt);
+    batch.minX = -100.0f;
+    batch.maxX = static_cast<float>(config::kWindowWidth) + 100.0f;
+    batch.maxY = static_cast<float>(config::kWindowHeight) + 100.0f;
+    
+    constexpr std::size_t kPowerSteps = 17;  // 力度 20%..100%，步长5%
+    
+    auto evaluateRow = [&](float angle, RowBest& best) {
+        float powers[kPowerSteps];
+        sf::Vector2f launchVelocities[kPowerSteps];
+        float velX[kPowerSteps];
+        float velY[kPowerSteps];
+        float minDistance[kPowerSteps];
+        std::uint8_t hit[kPowerSteps];
         
-        for (float power = 20.0f; power <= 100.0f; power += 5.0f) {
+        std::size_t count = 0;
+        for (float power = 20.0f; power <= 100.0f && count < kPowerSteps; power += 5.0f) {
             sf::Vector2f velocity = velocityFromAngleAndPower(angle, power, birdType);
             
             // 限制初始速度
@@ -924,74 +1159,159 @@ AimingInfo AIController::optimizeLaunchParameters(BirdType birdType,
                 velocity = normalize(velocity) * baseMaxSpeed;
             }
             
-            // 计算轨迹（对于炸弹鸟，使用更长的计算时间以覆盖远距离目标）
-            float maxTrajectoryTime = (birdType == BirdType::Bomb) ? 8.0f : 5.0f;
-            TrajectoryResult traj = calculateTrajectory(
-                slingshotPos, velocity, birdType, useSkill, target, maxTrajectoryTime);
-            
-            // 评估误差
-            float error = traj.minDistanceToTarget;
-            
-            if (traj.hitTarget) {
-                error = 0.0f;  // 击中目标，误差为0
+            sf::Vector2f flightVelocity = velocity;
+            if (yellowSkill) {
+                float currentSpeed = length(flightVelocity);
+                if (currentSpeed > 0.001f) {
+                    flightVelocity = normalize(flightVelocity) *
+                                     std::min(currentSpeed * 2.0f, config::bird_speed::kYellowMaxSpeed);
+                }
             }
             
-            // 转换为百分比误差（相对于目标大小）
-            float targetSize = std::max(target.size.x, target.size.y);
+            powers[count] = power;
+            launchVelocities[count] = velocity;
+            velX[count] = flightVelocity.x;
+            velY[count] = flightVelocity.y;
+            ++count;
+        }
+        
+        evaluateTrajectoryBatch(batch, velX, velY, count, minDistance, hit);
+        stats_.trajectoryCalculations.fetch_add(static_cast<int>(count), std::memory_order_relaxed);
+        
+        for (std::size_t i = 0; i < count; ++i) {
+            // 评估误差：击中目标误差为0，否则转换为相对于目标大小的百分比
+            float error = hit[i] ? 0.0f : minDistance[i];
             float errorPercent = (error / targetSize) * 100.0f;
             
-            if (errorPercent < bestError) {
-                bestError = errorPercent;
-                bestAim.isValid = true;
-                bestAim.angle = angle;
-                bestAim.power = power;
-                bestAim.trajectoryError = errorPercent;
-                bestAim.trajectoryPoints = traj.points;
-                bestAim.predictedHitPoint = traj.hitPoint;
-                
-                // 计算拖拽终点
-                // 拖拽向量 = -velocity / stiffness（反向）
-                sf::Vector2f pull = -velocity / config::kSlingshotStiffness;
-                float pullDist = length(pull);
-                
-                // 限制拖拽距离
-                float maxPull = config::kMaxPullDistance;
-                if (birdType == BirdType::Yellow) {
-                    maxPull = config::kMaxPullDistance * 2.0f;  // 黄鸟允许2倍距离
-                }
-                
-                // 如果拉弓距离超过限制，重新计算速度和pull以保持一致
-                if (pullDist > maxPull) {
-                    pull = normalize(pull) * maxPull;
-                    // 重新计算速度，确保与限制后的pull一致
-                    velocity = -pull * config::kSlingshotStiffness;
-                    // 限制速度到baseMaxSpeed
-                    float speed = length(velocity);
-                    if (speed > baseMaxSpeed) {
-                        velocity = normalize(velocity) * baseMaxSpeed;
-                        // 再次更新pull以保持一致
-                        pull = -velocity / config::kSlingshotStiffness;
-                    }
-                }
-                
-                bestAim.dragEnd = slingshotPos + pull;
-                
-                // 黄鸟技能激活时间（立即激活）
-                if (birdType == BirdType::Yellow && useSkill) {
-                    bestAim.skillActivationTime = 0.0f;  // 发射时立即激活
-                }
+            // 障碍物感知：SIMD 内核不做方块求交，它的误差可视为下界（轨迹在接触处截断基本只会让误差变大），
+            // 只有可能刷新本行最优的候选才用标量积分器带障碍物重算
+            if (predictObstacles_ && errorPercent < best.error) {
+                TrajectoryResult traj = calculateTrajectory(
+                    slingshotPos, launchVelocities[i], birdType, useSkill, target, maxTrajectoryTime, false);
+                error = traj.hitTarget ? 0.0f : traj.minDistanceToTarget;
+                errorPercent = (error / targetSize) * 100.0f;
+            }
+            
+            if (errorPercent < best.error) {
+                best.error = errorPercent;
+                best.angle = angle;
+                best.power = powers[i];
+                best.velocity = launchVelocities[i];
             }
         }
-        
-        // 性能优化：如果已找到误差<1%的完美解，提前终止
-        if (bestError < 1.0f) {
-            break;
+    };
+    
+    // 按行序归约（严格小于，与串行搜索的选取规则一致，结果与线程数无关）
+    auto reduceRows = [](const std::vector<RowBest>& rows, std::size_t lastRow, RowBest& best) {
+        for (std::size_t row = 0; row <= lastRow && row < rows.size(); ++row) {
+            if (rows[row].error < best.error) {
+                best = rows[row];
+            }
         }
+    };
+    
+    // 粗搜索：角度范围5-85度，步长2度（炸弹鸟1.5度）
+    // 如果某一行找到误差<1%的解，之后的行不再计算（提前终止对所有工作线程生效）
+    float angleStep = (birdType == BirdType::Bomb) ? 1.5f : 2.0f;
+    std::vector<float> angles;
+    for (float angle = 5.0f; angle <= 85.0f; angle += angleStep) {
+        angles.push_back(angle);
+    }
+    
+    std::vector<RowBest> rows(angles.size());
+    std::atomic<std::size_t> stopRow{angles.size()};
+    runSearchTasks(angles.size(), [&](std::size_t row) {
+        if (row > stopRow.load(std::memory_order_acquire)) return;
+        evaluateRow(angles[row], rows[row]);
+        if (rows[row].error < 1.0f) {
+            std::size_t current = stopRow.load(std::memory_order_acquire);
+            while (row < current &&
+                   !stopRow.compare_exchange_weak(current, row, std::memory_order_acq_rel)) {
+            }
+        }
+    });
+    
+    RowBest best;
+    reduceRows(rows, stopRow.load(), best);
+    
+    // 精细搜索：误差<3%但还不够完美时，在最佳角度±4度内以1度步长细化
+    if (best.error < 3.0f && best.error >= 1.0f) {
+        float fineAngleStart = std::max(5.0f, best.angle - 4.0f);
+        float fineAngleEnd = std::min(85.0f, best.angle + 4.0f);
+        std::vector<float> fineAngles;
+        for (float fineAngle = fineAngleStart; fineAngle <= fineAngleEnd; fineAngle += 1.0f) {
+            if (fineAngle == best.angle) continue;  // 跳过已经计算过的角度
+            fineAngles.push_back(fineAngle);
+        }
+        
+        std::vector<RowBest> fineRows(fineAngles.size());
+        runSearchTasks(fineAngles.size(), [&](std::size_t row) {
+            evaluateRow(fineAngles[row], fineRows[row]);
+        });
+        reduceRows(fineRows, fineRows.size(), best);
+    }
+    
+    if (best.error == std::numeric_limits<float>::max()) {
+        return bestAim;
+    }
+    
+    // 只为胜出的候选生成完整轨迹点（供 updateTrajectoryPreview 使用）
+    TrajectoryResult bestTraj = calculateTrajectory(
+        slingshotPos, best.velocity, birdType, useSkill, target, maxTrajectoryTime, true);
+    
+    bestAim.isValid = true;
+    bestAim.angle = best.angle;
+    bestAim.power = best.power;
+    bestAim.trajectoryError = best.error;
+    bestAim.trajectoryPoints = std::move(bestTraj.points);
+    bestAim.predictedHitPoint = bestTraj.hitPoint;
+    applyDragFromVelocity(bestAim, best.velocity, birdType, baseMaxSpeed, slingshotPos);
+    setFlightLaunch(bestAim, best.velocity, birdType, useSkill);
+    
+    // 黄鸟技能激活时间（立即激活）
+    if (birdType == BirdType::Yellow && useSkill) {
+        bestAim.skillActivationTime = 0.0f;  // 发射时立即激活
     }
     
     return bestAim;
 }
 
+void AIController::applyDragFromVelocity(AimingInfo& aim, sf::Vector2f velocity, BirdType birdType,
+                                         float baseMaxSpeed, const sf::Vector2f& slingshotPos) {
+    // 拖拽向量 = -velocity / stiffness（反向）
+    sf::Vector2f pull = -velocity / config::kSlingshotStiffness;
+    float pullDist = length(pull);
+    
+    // 限制拖拽距离
+    float maxPull = config::kMaxPullDistance;
+    if (birdType == BirdType::Yellow) {
+        maxPull = config::kMaxPullDistance * 2.0f;  // 黄鸟允许2倍距离
+    }
+    
+    // 如果拉弓距离超过限制，重新计算速度和pull以保持一致
+    if (pullDist > maxPull) {
+        pull = normalize(pull) * maxPull;
+        velocity = -pull * config::kSlingshotStiffness;
+        // 限制速度到baseMaxSpeed
+        float speed = length(velocity);
+        if (speed > baseMaxSpeed) {
+            velocity = normalize(velocity) * baseMaxSpeed;
+            // 再次更新pull以保持一致
+            pull = -velocity / config::kSlingshotStiffness;
+        }
+    }
+    
+    aim.dragEnd = slingshotPos + pull;
+}
+
+void AIController::runSearchTasks(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (parallelSearch_) {
+        ThreadPool::shared().parallelFor(count, task);
+    } else {
+        for (std::size_t i = 0; i < count; ++i) task(i);
+    }
+}
+
 sf::Vector2f AIController::velocityFromAngleAndPower(float angle, float power, BirdType birdType) {
     // 角度转换为弧度（0度=向右，90度=向上）
     float angleRad = angle * M_PI / 180.0f;
@@ -1047,29 +1367,17 @@ sf::Vector2f AIController::normalize(const sf::Vector2f& v) const {
 }
 
 bool AIController::raycastToTarget(const sf::Vector2f& start, const sf::Vector2f& end,
-                                   const std::vector<TargetInfo>& obstacles,
-                                   sf::Vector2f& hitPoint) const {
-    // 简化的射线检测实现
-    sf::Vector2f dir = normalize(end - start);
-    float dist = distance(start, end);
-    
-    for (const auto& obstacle : obstacles) {
-        sf::Vector2f toObstacle = obstacle.position - start;
-        float projDist = toObstacle.x * dir.x + toObstacle.y * dir.y;
-        
-        if (projDist > 0 && projDist < dist) {
-            sf::Vector2f projPoint = start + dir * projDist;
-            float distToObstacle = distance(projPoint, obstacle.position);
-            
-            float obstacleRadius = std::max(obstacle.size.x, obstacle.size.y) * 0.5f;
-            if (distToObstacle < obstacleRadius) {
-                hitPoint = projPoint;
-                return true;
-            }
-        }
+                                   sf::Vector2f& hitPoint, size_t* blockIndex) const {
+    ObstacleGrid::Hit hit;
+    if (!blockGrid_.firstHit(start, end, hit)) {
+        return false;
     }
     
-    return false;
+    hitPoint = start + (end - start) * hit.t;
+    if (blockIndex) {
+        *blockIndex = hit.index;
+    }
+    return true;
 }
 
 std::vector<BirdType> AIController::determineLaunchOrder(const std::deque<std::unique_ptr<Bird>>& birds) {
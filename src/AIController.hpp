@@ -9,14 +9,16 @@
 #include <chrono>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 
 #include "Entity.hpp"
 #include "Physics.hpp"
 #include "Config.hpp"
 #include "Logger.hpp"
-
-// 前向声明
-class Game;
+#include "ObstacleGrid.hpp"
+#include "TrajectoryPreview.hpp"
 
 // ========== 数据结构定义 ==========
 
@@ -25,7 +27,8 @@ struct TargetInfo {
     enum Type { Pig, Block };
     Type type;
     sf::Vector2f position;
-    sf::Vector2f size;  // 对于圆形目标（猪），size.x 为半径
+    sf::Vector2f size;  // 方块为未旋转的宽高；对于圆形目标（猪），size.x 为半径
+    float angle{0.0f};  // 方块朝向（弧度，刚体角度），障碍物检测按旋转后的盒子计算
     int health{0};
     int maxHealth{0};
     float threatValue{0.0f};  // 威胁值（用于优先级排序）
@@ -60,6 +63,8 @@ struct AimingInfo {
     // 轨迹点（用于可视化）
     std::vector<sf::Vector2f> trajectoryPoints;
     sf::Vector2f predictedHitPoint;  // 预测碰撞点
+    sf::Vector2f flightVelocity;     // 飞行初速度（已含黄鸟技能翻倍），用于轨迹预览
+    float flightMaxSpeed{0.0f};      // 飞行速度上限
 };
 
 // 轨迹计算结果
@@ -70,20 +75,38 @@ struct TrajectoryResult {
     sf::Vector2f hitPoint;              // 击中点
     float minDistanceToTarget{999999.0f};  // 与目标的最小距离
     float finalVelocity{0.0f};          // 击中时的速度
+    bool hitObstacle{false};            // 障碍物感知预测：是否在到达目标前撞上方块（轨迹在首次接触处结束）
+    sf::Vector2f obstacleContact;       // 首次接触点
 };
 
 // ========== AI控制器主类 ==========
 
 class AIController {
+    friend class AIBenchmark;  // bench_main.cpp：直接测量私有的轨迹计算与搜索函数
 public:
     AIController();
     ~AIController();
     
-    // 基础接口
-    void setGame(Game* game) { game_ = game; }
-    void setEnabled(bool enabled) { enabled_ = enabled; }
+    // 基础接口（AI 只读取 update 传入的实体，不依赖 Game，可在任意线程的独立会话中使用）
+    // 开关 AI 时作废布局缓存：关闭期间关卡可能被重载（实体地址可能被对象池复用）
+    void setEnabled(bool enabled) { enabled_ = enabled; layoutValid_ = false; }
+    void invalidateLayout() { layoutValid_ = false; }
     bool isEnabled() const { return enabled_; }
     
+    // 瞄准求解方式：解析反解 + 牛顿迭代（默认，失败时回退到网格搜索） / 全网格搜索
+    enum class AimSolver { Analytic, Grid };
+    void setAimSolver(AimSolver solver) { aimSolver_ = solver; }
+    AimSolver aimSolver() const { return aimSolver_; }
+    
+    // 发射参数搜索是否使用共享线程池并行（默认开启；多会话并行运行时应关闭）
+    void setParallelSearch(bool enabled) { parallelSearch_ = enabled; }
+    bool parallelSearch() const { return parallelSearch_; }
+    
+    // 障碍物感知瞄准：轨迹每个积分段与方块求交，按首次接触点打分（默认开启）
+    // 目标被完全包住、找不到绕开障碍的解时，自动退回不考虑障碍物的搜索
+    void setObstacleAwareAim(bool enabled) { obstacleAware_ = enabled; }
+    bool obstacleAwareAim() const { return obstacleAware_; }
+    
     // 更新接口
     void update(float dt, 
                 const std::vector<std::unique_ptr<Block>>& blocks,
@@ -106,10 +129,10 @@ public:
         trajectoryPreviewTimer_ = 0.0f;
         trajectoryPreviewReady_ = false;
     }
-    const std::vector<sf::Vertex>& getTrajectoryPreview() const { return trajectoryPreview_; }
+    const std::vector<sf::Vertex>& getTrajectoryPreview() const { return trajectoryPreview_.vertices(); }
     void updateTrajectoryPreview();  // 更新轨迹预览
     
-    // 性能统计
+    // 性能统计（快照，内部计数器为原子量，可在搜索线程中累加）
     struct PerformanceStats {
         int trajectoryCalculations{0};
         int targetIdentifications{0};
@@ -119,12 +142,16 @@ public:
         int totalShots{0};
         float successRate{0.0f};
     };
-    const PerformanceStats& getStats() const { return stats_; }
+    PerformanceStats getStats() const;
 
 private:
     // ========== 子系统1: 关卡布局分析 ==========
     void analyzeLevelLayout(const std::vector<std::unique_ptr<Block>>& blocks,
                            const std::vector<std::unique_ptr<Pig>>& pigs);
+    enum class LayoutDelta { None, Moved, Structural };  // 相对上次分析的变化程度
+    LayoutDelta refreshLayout(const std::vector<std::unique_ptr<Block>>& blocks,
+                              const std::vector<std::unique_ptr<Pig>>& pigs);
+    void rebuildObstacleIndex();  // 重建 blockGrid_ 并重新统计障碍物层数
     
     // ========== 子系统2: 差异化目标选择 ==========
     TargetInfo selectTargetForBombBird(const std::vector<TargetInfo>& targets,
@@ -133,11 +160,10 @@ private:
     TargetInfo selectTargetForYellowBird(const std::vector<TargetInfo>& targets);
     
     // 炸弹鸟专用：障碍物层级分析
-    void calculateObstacleLayers(const std::vector<TargetInfo>& allTargets,
-                                 const std::vector<TargetInfo>& blocks);
-    int countObstacleLayers(const TargetInfo& target, 
-                           const std::vector<TargetInfo>& blocks,
-                           const sf::Vector2f& slingshotPos);
+    void calculateObstacleLayers();
+    int countObstacleLayers(const TargetInfo& target,
+                           const sf::Vector2f& slingshotPos,
+                           std::vector<size_t>& blockingBlocks) const;
     float evaluateTargetValueForBomb(const TargetInfo& target, 
                                      const std::vector<TargetInfo>& blocks);
     
@@ -147,23 +173,27 @@ private:
                               const sf::Vector2f& fromPos);
     
     // ========== 子系统3: 轨迹计算引擎 ==========
+    // recordPoints = false 时只评估（命中/最小距离），不记录轨迹点、不分配内存
     TrajectoryResult calculateTrajectory(const sf::Vector2f& startPos,
                                         const sf::Vector2f& velocity,
                                         BirdType birdType,
                                         bool useSkill,
                                         const TargetInfo& target,
-                                        float maxTime = 5.0f);
+                                        float maxTime = 5.0f,
+                                        bool recordPoints = true);
     
     TrajectoryResult calculateYellowBirdTrajectory(const sf::Vector2f& startPos,
                                                    const sf::Vector2f& initialVelocity,
                                                    float skillActivationTime,
                                                    const TargetInfo& target,
-                                                   float maxTime = 5.0f);
+                                                   float maxTime = 5.0f,
+                                                   bool recordPoints = true);
     
     // 物理计算辅助函数
     std::pair<sf::Vector2f, sf::Vector2f> applyPhysicsStep(sf::Vector2f pos, sf::Vector2f vel,
                                                           float dt, float maxSpeed);
     float calculateAirResistance(float speed);
+    float flightMaxSpeed(BirdType birdType, bool useSkill) const;  // 飞行中的速度上限
     
     // ========== 子系统4: 发射参数计算 ==========
     AimingInfo calculateOptimalAim(BirdType birdType,
@@ -175,9 +205,28 @@ private:
                                        const TargetInfo& target,
                                        const sf::Vector2f& slingshotPos);
     
+    // 解析求解：无阻力抛物线反解初始角度，再用真实积分器做割线（牛顿）迭代修正
+    AimingInfo solveLaunchAnalytic(BirdType birdType,
+                                   const TargetInfo& target,
+                                   const sf::Vector2f& slingshotPos);
+    
+    // 积分到目标x坐标处时与目标的竖直偏差（像素，正值=偏下）；到达不了返回NaN
+    float verticalMissAtTarget(const sf::Vector2f& startPos, const sf::Vector2f& velocity,
+                               BirdType birdType, bool useSkill,
+                               const sf::Vector2f& targetPos, float maxTime);
+    
     // 从角度和力度计算速度向量
     sf::Vector2f velocityFromAngleAndPower(float angle, float power, BirdType birdType);
     
+    // 根据发射速度计算拖拽终点（限制拉弓距离）
+    void applyDragFromVelocity(AimingInfo& aim, sf::Vector2f velocity, BirdType birdType,
+                               float baseMaxSpeed, const sf::Vector2f& slingshotPos);
+    // 记录飞行初速度与速度上限（供轨迹预览重新积分）
+    void setFlightLaunch(AimingInfo& aim, sf::Vector2f velocity, BirdType birdType, bool useSkill) const;
+    
+    // 并行（或串行）执行 task(i)，i ∈ [0, count)
+    void runSearchTasks(std::size_t count, const std::function<void(std::size_t)>& task);
+    
     // ========== 子系统5: 发射顺序决策 ==========
     std::vector<BirdType> determineLaunchOrder(const std::deque<std::unique_ptr<Bird>>& birds);
     
@@ -188,13 +237,24 @@ private:
     sf::Vector2f normalize(const sf::Vector2f& v) const;
     
     // 碰撞检测辅助
+    // 积分段 from->to 最先碰到的非目标方块（目标本身是方块时不算障碍）
+    bool firstObstacleContact(const sf::Vector2f& from, const sf::Vector2f& to,
+                              const TargetInfo& target, sf::Vector2f& contact) const;
+    // 积分循环中的障碍物处理：撞上方块时以接触点结束轨迹并更新结果，返回 true
+    bool resolveObstacleContact(const sf::Vector2f& from, const sf::Vector2f& to,
+                                const TargetInfo& target, float collisionRadius, float time,
+                                bool recordPoints, TrajectoryResult& result,
+                                float& closestDist, sf::Vector2f& closestPoint) const;
+    // 线段最先碰到的方块（基于 blockGrid_），返回 blockTargets_ 下标
     bool raycastToTarget(const sf::Vector2f& start, const sf::Vector2f& end,
-                        const std::vector<TargetInfo>& obstacles,
-                        sf::Vector2f& hitPoint) const;
+                        sf::Vector2f& hitPoint, size_t* blockIndex = nullptr) const;
     
     // ========== 成员变量 ==========
-    Game* game_{nullptr};
     bool enabled_{false};
+    bool parallelSearch_{true};
+    bool obstacleAware_{true};
+    bool predictObstacles_{false};  // 当前这次瞄准搜索是否做障碍物求交（calculateOptimalAim 内设置）
+    AimSolver aimSolver_{AimSolver::Analytic};
     
     // 当前状态
     bool shouldLaunch_{false};
@@ -205,13 +265,22 @@ private:
     std::vector<TargetInfo> allTargets_;     // 所有目标（猪+方块）
     std::vector<TargetInfo> pigTargets_;     // 仅猪目标
     std::vector<TargetInfo> blockTargets_;   // 仅方块
+    ObstacleGrid blockGrid_;                 // blockTargets_ 的空间索引（下标一一对应），随布局分析重建
     sf::Vector2f slingshotPos_;
+    bool layoutValid_{false};             // 上面的分析结果是否可增量刷新
+    sf::Vector2f analyzedSlingshotPos_;   // 上次完整分析时的弹弓位置
     
     // 轨迹可视化
-    std::vector<sf::Vertex> trajectoryPreview_;
+    TrajectoryPreview trajectoryPreview_{{60, 1.0f / 60.0f, sf::Color(255u, 255u, 0u, 255u), true}};
     
-    // 性能统计
-    PerformanceStats stats_;
+    // 性能统计（原子计数，搜索线程并发累加）
+    struct StatsCounters {
+        std::atomic<int> trajectoryCalculations{0};
+        std::atomic<int> targetIdentifications{0};
+        std::atomic<long long> totalTrajectoryTimeUs{0};
+        std::atomic<long long> maxTrajectoryTimeUs{0};
+    };
+    StatsCounters stats_;
     std::chrono::high_resolution_clock::time_point trajectoryCalcStart_;
     
     // 状态管理
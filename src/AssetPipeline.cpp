@@ -0,0 +1,90 @@
+// 启动资源流水线实现
+#include "AssetPipeline.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "TextureCache.hpp"
+#include "ThreadPool.hpp"
+
+AssetPipeline::~AssetPipeline() {
+    // 未完成的解码任务仍可能写入调用方的对象，必须等它们结束
+    if (worker_.joinable()) worker_.join();
+}
+
+void AssetPipeline::add(Decode decode, Finish finish) {
+    if (started_) return;
+    jobs_.push_back({std::move(decode), std::move(finish)});
+}
+
+void AssetPipeline::addTexture(const std::string& path, sf::Texture& target, std::function<void()> onLoaded) {
+    auto image = std::make_shared<sf::Image>();
+    add([image, path] { return image->loadFromFile(path); },
+        [image, path, &target, onLoaded = std::move(onLoaded)](bool ok) {
+            if (ok && target.loadFromImage(*image)) {
+                if (onLoaded) onLoaded();
+            } else {
+                std::cerr << "警告: 无法加载贴图 " << path << "\n";
+            }
+            *image = sf::Image();  // 上传后释放 CPU 侧像素
+        });
+}
+
+void AssetPipeline::addCachedTexture(const std::string& path) {
+    auto image = std::make_shared<sf::Image>();
+    add([image, path] { return image->loadFromFile(path); },
+        [image, path](bool ok) {
+            TextureCache::instance().insert(path, ok ? image.get() : nullptr);
+            *image = sf::Image();
+        });
+}
+
+void AssetPipeline::start() {
+    if (started_) return;
+    started_ = true;
+    if (jobs_.empty()) return;
+    worker_ = std::thread([this] {
+        // 调用线程（本线程）也参与解码，主线程只负责上传
+        ThreadPool::shared().parallelFor(jobs_.size(), [this](std::size_t i) {
+            bool ok = jobs_[i].decode();
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_[i].ok = ok;
+            ready_.push_back(i);
+            readyCv_.notify_one();
+        });
+    });
+}
+
+bool AssetPipeline::pump(float budgetMs) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    while (!done()) {
+        std::size_t index;
+        bool ok;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ready_.empty()) break;
+            index = ready_.front();
+            ready_.pop_front();
+            ok = jobs_[index].ok;
+        }
+        jobs_[index].finish(ok);
+        jobs_[index] = Job{};  // 释放任务捕获的缓冲区
+        ++finished_;
+        if (std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= budgetMs) break;
+    }
+    if (done() && worker_.joinable()) worker_.join();
+    return done();
+}
+
+void AssetPipeline::finish() {
+    if (!started_) start();
+    while (!done()) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            readyCv_.wait(lock, [this] { return !ready_.empty(); });
+        }
+        pump(1e9f);
+    }
+}
@@ -0,0 +1,69 @@
+// 启动资源流水线：图片/音频在后台线程读盘解码，主线程每帧在时间预算内逐个上传显存
+// 开屏画面在第一帧就能显示，资源陆续就绪；全部完成后由调用方进入后续场景
+//
+// 每个任务分两步：decode 在工作线程执行（只能做 CPU 工作，不得触碰 OpenGL 上下文），
+// finish 在调用 pump() 的主线程执行（上传贴图、创建精灵/音效）。decode 写入的对象在 finish 之前
+// 不能被主线程访问
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+class AssetPipeline {
+public:
+    using Decode = std::function<bool()>;
+    using Finish = std::function<void(bool ok)>;
+
+    AssetPipeline() = default;
+    ~AssetPipeline();
+
+    AssetPipeline(const AssetPipeline&) = delete;
+    AssetPipeline& operator=(const AssetPipeline&) = delete;
+
+    // 任务按添加顺序开始解码（先添加首帧需要的资源）；start() 之后不能再添加
+    void add(Decode decode, Finish finish);
+
+    // 图片解码到内部 sf::Image，主线程上传到 target；onLoaded 只在成功时调用
+    void addTexture(const std::string& path, sf::Texture& target, std::function<void()> onLoaded = {});
+
+    // 解码后登记到 TextureCache（实体、开屏小鸟等按路径共享的贴图）
+    void addCachedTexture(const std::string& path);
+
+    // 在后台线程上用共享线程池并行解码所有任务
+    void start();
+
+    // 主线程调用：依次执行已解码任务的 finish，累计耗时超过 budgetMs 后返回（至少执行一个）
+    // 返回 true 表示所有任务都已完成
+    bool pump(float budgetMs);
+
+    // 阻塞直到所有任务完成（包括 finish）
+    void finish();
+
+    bool done() const { return finished_ == jobs_.size(); }
+    std::size_t total() const { return jobs_.size(); }
+    std::size_t finished() const { return finished_; }
+
+private:
+    struct Job {
+        Decode decode;
+        Finish finish;
+        bool ok{false};  // 工作线程写入后才放进 ready_，主线程取出后读取
+    };
+
+    std::vector<Job> jobs_;
+    std::size_t finished_{0};
+    bool started_{false};
+
+    std::mutex mutex_;
+    std::condition_variable readyCv_;
+    std::deque<std::size_t> ready_;  // 已解码、等待主线程 finish 的任务
+    std::thread worker_;
+};
@@ -2,24 +2,17 @@
 #include "Button.hpp"
 
 #include <algorithm>
-#include <iostream>
 
-// Static texture for wood background (shared by all buttons)
-sf::Texture& Button::getWoodTexture() {
-    static sf::Texture woodTexture;
-    static bool textureLoaded = false;
-    
-    if (!textureLoaded) {
-        if (!woodTexture.loadFromFile("image/wood.png")) {
-            std::cerr << "警告: 无法加载按钮背景贴图 image/wood.png\n";
-            // If loading fails, texture will be invalid but button will still work with default color
-        } else {
-            // Enable texture repeating for seamless tiling
-            woodTexture.setRepeated(true);
-        }
-        textureLoaded = true;
+#include "TextureCache.hpp"
+
+// Wood background texture shared by all buttons
+// 由启动资源流水线在后台解码并登记到 TextureCache（见 Game::queueStartupAssets），这里只取缓存；加载失败返回 nullptr
+sf::Texture* Button::getWoodTexture() {
+    sf::Texture* woodTexture = TextureCache::instance().get(kWoodTexturePath);
+    if (woodTexture) {
+        // Enable texture repeating for seamless tiling
+        woodTexture->setRepeated(true);
     }
-    
     return woodTexture;
 }
 
@@ -31,12 +24,11 @@ Button::Button(const std::string& text, const sf::Font& font, const sf::Vector2f
     shape_.setOutlineColor(sf::Color::Black);
     shape_.setOutlineThickness(2.0f);
     
-    // Set wood texture
-    sf::Texture& woodTex = getWoodTexture();
-    shape_.setTexture(&woodTex);
+    // Set wood texture (button still works with default color if it failed to load)
+    sf::Texture* woodTex = getWoodTexture();
+    shape_.setTexture(woodTex);
     // Set texture rect to cover button size (texture will repeat if enabled)
-    sf::Vector2u texSize = woodTex.getSize();
-    if (texSize.x > 0 && texSize.y > 0) {
+    if (woodTex && woodTex->getSize().x > 0 && woodTex->getSize().y > 0) {
         // Use texture rect to make texture fill the button (with repetition)
         sf::IntRect texRect(sf::Vector2i(0, 0), sf::Vector2i(static_cast<int>(size.x), static_cast<int>(size.y)));
         shape_.setTextureRect(texRect);
@@ -61,9 +53,7 @@ void Button::setPosition(const sf::Vector2f& position) {
 void Button::setSize(const sf::Vector2f& size) {
     shape_.setSize(size);
     // Update texture rect to match new size
-    sf::Texture& woodTex = getWoodTexture();
-    sf::Vector2u texSize = woodTex.getSize();
-    if (texSize.x > 0 && texSize.y > 0) {
+    if (shape_.getTexture()) {
         sf::IntRect texRect(sf::Vector2i(0, 0), sf::Vector2i(static_cast<int>(size.x), static_cast<int>(size.y)));
         shape_.setTextureRect(texRect);
     }
@@ -22,9 +22,11 @@ public:
     bool isHovered() const { return hovered_; }
     bool isPressed() const { return pressed_; }
     
+    static constexpr const char* kWoodTexturePath = "image/wood.png";  // 按钮木纹背景（由启动流水线预先解码）
+    
 private:
     void updateVisuals();
-    static sf::Texture& getWoodTexture();  // Static method to load and return wood texture
+    static sf::Texture* getWoodTexture();  // Wood texture from TextureCache (nullptr if it failed to load)
     
     sf::RectangleShape shape_;
     sf::Text text_;
@@ -1,6 +1,7 @@
 // Global configuration constants for the Angry Birds style game.
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace config {
@@ -8,6 +9,13 @@ namespace config {
 // ======= 物理世界基础参数 =======
 // 固定物理步长（秒）。值越小，物理越精确，CPU 占用越高。
 constexpr float kFixedDelta = 1.0f / 60.0f;
+// 每帧最多追赶的物理步数：卡顿后丢弃多余的积压时间，避免越追越慢。
+constexpr int kMaxPhysicsStepsPerFrame = 5;
+// 单帧时间上限（秒）：拖动窗口、断点调试等长时间停顿不会被当成一次超长的帧。
+constexpr float kMaxFrameTime = 0.25f;
+// 模拟/渲染流水线的默认开关（游戏中按 F3 切换）：开启后固定步长模拟在模拟线程上执行，
+// 与上一帧快照的绘制并行；画面比输入晚一帧。显示碰撞框调试时自动退回串行。
+constexpr bool kPipelinedSimulation = false;
 // 像素与 Box2D 米的换算比例（1 米 = 30 像素）。
 constexpr float kPixelsPerMeter = 30.0f;
 // 重力加速度，单位：像素/秒²（9.8 m/s² * 像素/米）。
@@ -16,6 +24,29 @@ constexpr float kGravity = 9.8f * kPixelsPerMeter;
 constexpr float kMaxBodySpeed = 800.0f;
 // 小鸟和猪猪的空气阻力加速度（m/s²，负值表示减速）。
 constexpr float kAirResistanceAccel = -0.25f;  // m/s^2
+// Box2D 每步的速度/位置迭代次数：位置迭代调高以消除重叠（尤其是石板两端）。
+constexpr int kVelocityIterations = 10;
+constexpr int kPositionIterations = 40;
+// 贴地滚动的动态刚体每个物理步按速度档位衰减（见 DamageContactListener::resolveGroundFriction）。
+namespace groundFriction {
+    constexpr float kBase = 0.92f;          // 基础：每步减速 8%
+    constexpr float kSlow = 0.85f;          // 慢速（低于 kSlowSpeed）：每步减速 15%
+    constexpr float kMedium = 0.90f;        // 中速（低于 kMediumSpeed）：每步减速 10%
+    constexpr float kSlowSpeed = 50.0f;     // 像素/秒
+    constexpr float kMediumSpeed = 100.0f;  // 像素/秒
+}
+// 单个物理步的接触事件缓冲预分配容量（地面摩擦 + 撞击）；超出时自动扩容，只影响首次分配。
+constexpr int kContactEventReserve = 512;
+
+// ======= 关卡初始沉降参数 =======
+// 载入关卡后先推进物理让堆叠物体落稳；所有刚体休眠或动能足够小时提前结束。
+namespace settle {
+    constexpr int kMaxSteps = 600;          // 最多 600 步（10 秒），与旧的固定沉降时长相同
+    constexpr int kMinSteps = 60;           // 至少 1 秒，给初始重叠留出被推开的时间
+    constexpr int kCheckInterval = 10;      // 每 10 步检查一次是否已静止
+    constexpr int kStableChecks = 3;        // 连续 3 次检查都静止才结束（避免摆动的瞬间误判）
+    constexpr float kEnergyPerBody = 0.005f;  // 每个动态刚体平均动能阈值（焦耳，Box2D 单位）
+}
 
 // ======= 小鸟速度与技能相关参数 =======
 namespace bird_speed {
@@ -33,8 +64,11 @@ namespace bird_speed {
 }
 
 // ======= 关卡与资源路径配置 =======
+// 启动资源每帧上传显存的时间预算（毫秒）：开屏期间逐帧上传后台解码好的贴图，保持画面流畅
+constexpr float kStartupUploadBudgetMs = 4.0f;
 // 关卡文件所在目录，相对于可执行文件工作目录（示例：build/bin）。
 constexpr const char* kLevelDirectory = "levels";
+constexpr int kLevelSelectCount = 8;  // 选关界面的关卡按钮数（level1 ~ level8）
 // 字体搜索顺序：优先使用程序工作目录下的字体文件（由 CMake 从 Windows 字体目录自动复制）
 // 注意：这些路径都是相对于可执行文件所在目录（通常是 build/bin）
 constexpr const char* kFontPathPrimary   = "fonts/msyh.ttc";   // 微软雅黑
@@ -54,6 +88,17 @@ constexpr float kMaxPullDistance = 220.0f;
 constexpr float kSlingshotStiffness = 10.0f;
 // AI轨迹计算上限次数：限制收集的候选轨迹数量，避免计算过多
 constexpr int kMaxTrajectoryCandidates = 10;
+// AI障碍物网格单元边长（像素）：略大于方块尺寸，使每个方块只落在少数几个单元里
+constexpr float kAIObstacleGridCellSize = 64.0f;
+// 关卡编辑器空间哈希的格子边长（像素）：与常见方块尺寸同量级，点选时一个格子里只有少数几个实体
+constexpr float kEditorSpatialHashCellSize = 64.0f;
+// 关卡编辑器撤销历史上限（条）：每条命令只记录增量（几十字节），超出时按组丢弃最早的命令
+constexpr std::size_t kEditorUndoHistoryLimit = 10000;
+// 同一实体首尾相接的移动/缩放在该时间窗（秒）内合并为一条命令（连续的小幅拖动只需撤销一次）
+constexpr float kEditorUndoCoalesceSeconds = 0.75f;
+// 轨迹预览量化步长：起点（像素）与初速度（像素/秒，5 = 拉弓距离变化 0.5 像素）变化小于该值时不重新积分
+constexpr float kPreviewPositionQuantum = 0.5f;
+constexpr float kPreviewVelocityQuantum = 5.0f;
 // 弹弓锚点位置（像素坐标，屏幕左上为原点）。
 constexpr float kSlingshotX = 200.0f;
 constexpr float kSlingshotY = 500.0f;
@@ -0,0 +1,122 @@
+// 关卡编辑器空间哈希实现
+#include "EditorSpatialHash.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+EditorSpatialHash::EditorSpatialHash(float cellSize) : cellSize_(cellSize > 0.0f ? cellSize : 1.0f) {}
+
+void EditorSpatialHash::clear() {
+    cells_.clear();
+    ranges_.clear();
+    boxes_.clear();
+    count_ = 0;
+}
+
+std::uint64_t EditorSpatialHash::key(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+int EditorSpatialHash::cellOf(float v) const {
+    return static_cast<int>(std::floor(v / cellSize_));
+}
+
+EditorSpatialHash::CellRange EditorSpatialHash::rangeOf(const Box& box) const {
+    return {cellOf(box.min.x), cellOf(box.min.y), cellOf(box.max.x), cellOf(box.max.y)};
+}
+
+void EditorSpatialHash::link(std::size_t index, const CellRange& range) {
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            cells_[key(x, y)].push_back(index);
+        }
+    }
+}
+
+void EditorSpatialHash::unlink(std::size_t index, const CellRange& range) {
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            auto it = cells_.find(key(x, y));
+            if (it == cells_.end()) continue;
+            auto& items = it->second;
+            auto pos = std::find(items.begin(), items.end(), index);
+            if (pos != items.end()) {
+                *pos = items.back();
+                items.pop_back();
+            }
+            if (items.empty()) cells_.erase(it);
+        }
+    }
+}
+
+void EditorSpatialHash::set(std::size_t index, const Box& box) {
+    if (index >= ranges_.size()) {
+        ranges_.resize(index + 1);
+        boxes_.resize(index + 1);
+    }
+    CellRange range = rangeOf(box);
+    CellRange& current = ranges_[index];
+    if (current.empty()) {
+        ++count_;
+        link(index, range);
+    } else if (!(current == range)) {
+        // 物理运动和拖拽大多停留在同一组格子里，跨格子时才改动格子列表
+        unlink(index, current);
+        link(index, range);
+    }
+    current = range;
+    boxes_[index] = box;
+}
+
+void EditorSpatialHash::erase(std::size_t index) {
+    if (index >= ranges_.size() || ranges_[index].empty()) return;
+    unlink(index, ranges_[index]);
+    ranges_[index] = CellRange{};
+    --count_;
+}
+
+void EditorSpatialHash::queryPoint(const sf::Vector2f& p, std::vector<std::size_t>& out) const {
+    out.clear();
+    auto it = cells_.find(key(cellOf(p.x), cellOf(p.y)));
+    if (it == cells_.end()) return;
+    for (std::size_t index : it->second) {
+        const Box& box = boxes_[index];
+        if (p.x >= box.min.x && p.x <= box.max.x && p.y >= box.min.y && p.y <= box.max.y) {
+            out.push_back(index);
+        }
+    }
+    // 同一格子里每个下标只登记一次，无需去重
+    std::sort(out.begin(), out.end());
+}
+
+void EditorSpatialHash::queryRect(const sf::Vector2f& min, const sf::Vector2f& max,
+                                  std::vector<std::size_t>& out) const {
+    out.clear();
+    if (count_ == 0) return;
+    auto overlaps = [&](const Box& box) {
+        return box.max.x >= min.x && box.min.x <= max.x && box.max.y >= min.y && box.min.y <= max.y;
+    };
+
+    CellRange range = rangeOf({min, max});
+    const double cellCount = (static_cast<double>(range.x1) - range.x0 + 1.0) *
+                             (static_cast<double>(range.y1) - range.y0 + 1.0);
+    if (cellCount > static_cast<double>(count_)) {
+        // 框选范围远大于实体数量（例如框住整个关卡）时逐个检查登记的盒子更快
+        for (std::size_t index = 0; index < ranges_.size(); ++index) {
+            if (!ranges_[index].empty() && overlaps(boxes_[index])) out.push_back(index);
+        }
+        return;
+    }
+
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            auto it = cells_.find(key(x, y));
+            if (it == cells_.end()) continue;
+            for (std::size_t index : it->second) {
+                if (overlaps(boxes_[index])) out.push_back(index);
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,58 @@
+// 关卡编辑器空间哈希：实体 AABB 登记到固定边长的哈希格子里，点选/悬停/框选只检查附近格子
+// 与 ObstacleGrid（整体重建的静态网格）不同，这里支持逐个登记和移动：拖拽、缩放、物理运动
+// 都只更新被改动的实体；格子用哈希表存放，编辑器里的实体可以摆到任意坐标
+// 键为实体在 LevelEditor::entities_ 中的下标，增删导致下标整体平移时由编辑器重建
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include "Config.hpp"
+
+class EditorSpatialHash {
+public:
+    struct Box {
+        sf::Vector2f min;
+        sf::Vector2f max;
+    };
+
+    explicit EditorSpatialHash(float cellSize = config::kEditorSpatialHashCellSize);
+
+    void clear();
+
+    // 登记或更新 index 的包围盒；覆盖的格子范围没变时只刷新盒子，不改动格子列表
+    void set(std::size_t index, const Box& box);
+    void erase(std::size_t index);
+
+    // 包围盒包含点 p 的下标（升序，无重复）；调用方再做精确形状测试
+    void queryPoint(const sf::Vector2f& p, std::vector<std::size_t>& out) const;
+
+    // 包围盒与矩形 [min, max] 重叠的下标（升序，无重复）
+    void queryRect(const sf::Vector2f& min, const sf::Vector2f& max, std::vector<std::size_t>& out) const;
+
+    std::size_t size() const { return count_; }
+
+private:
+    // 覆盖的格子坐标范围（闭区间）；x1 < x0 表示未登记
+    struct CellRange {
+        int x0{0}, y0{0}, x1{-1}, y1{-1};
+        bool empty() const { return x1 < x0; }
+        bool operator==(const CellRange&) const = default;
+    };
+
+    static std::uint64_t key(int x, int y);
+    int cellOf(float v) const;
+    CellRange rangeOf(const Box& box) const;
+    void link(std::size_t index, const CellRange& range);
+    void unlink(std::size_t index, const CellRange& range);
+
+    float cellSize_;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells_;
+    std::vector<CellRange> ranges_;  // 按下标
+    std::vector<Box> boxes_;         // 按下标
+    std::size_t count_{0};
+};
@@ -7,9 +7,51 @@
 #include <iostream>
 
 #include "Config.hpp"
+#include "ObjectPool.hpp"
+#include "RenderSnapshot.hpp"
+#include "SpriteBatch.hpp"
+#include "TextureCache.hpp"
 
 namespace {
-constexpr float kSpawnInvincibleTime = 2.5f;  // seconds
+
+void savePrevious(const PhysicsBody& body, PreviousTransform& prev) {
+    prev.position = body.position();
+    prev.angle = body.angle();
+    prev.valid = true;
+}
+
+// 在上一物理步与当前刚体变换之间插值；没有上一步记录时直接使用当前变换
+void lerpTransform(const PhysicsBody& body, const PreviousTransform& prev, float alpha,
+                   sf::Vector2f& position, float& angle) {
+    position = body.position();
+    angle = body.angle();
+    if (prev.valid) {
+        position = prev.position + (position - prev.position) * alpha;
+        angle = prev.angle + (angle - prev.angle) * alpha;
+    }
+}
+
+// 实体所在世界的受击状态表（刚体由 PhysicsWorld 创建，owner_ 总是有效）
+EntityTable& tableOf(const PhysicsBody& body) {
+    return body.owner_->entities();
+}
+
+void releaseEntity(PhysicsBody& body, EntityHandle handle) {
+    if (body.owner_) body.owner_->entities().remove(handle);
+    body.release();
+}
+
+// 更新末尾调用：刚体休眠且没有待播放的受击效果时退出唤醒集合（见 PhysicsWorld::collectAwakeEntities）
+// 退出前把插值起点对齐到当前变换，之后精灵保持在休眠位置，直到被撞醒
+void finishUpdate(PhysicsBody& body, PreviousTransform& prev, bool busy) {
+    bool keepUpdating = busy || body.awake();
+    body.setNeedsUpdate(keepUpdating);
+    if (!keepUpdating) savePrevious(body, prev);
+}
+}
+
+void Entity::appendToSnapshot(RenderSnapshot& snapshot) const {
+    if (!appendToBatch(snapshot.batch())) appendDrawables(snapshot);
 }
 
 Block::Block(const Material& material, const sf::Vector2f& pos, const sf::Vector2f& size, PhysicsWorld& world)
@@ -20,8 +62,9 @@ Block::Block(const Material& material, const sf::Vector2f& pos, const sf::Vector
     // Set HP based on material strength (higher strength = more HP)
     // 使用全局系数 config::kBlockHpFactor 统一控制所有建筑物血量。
     // 示例：0.5f -> 原始血量；0.75f -> 在原始基础上整体 +50%。
-    maxHp_ = static_cast<int>(material_.strength * config::kBlockHpFactor);  // Convert strength to HP
-    hp_ = maxHp_;
+    int maxHp = static_cast<int>(material_.strength * config::kBlockHpFactor);  // Convert strength to HP
+    handle_ = world.entities().add(EntityKind::Block, this, body_.userData_, body_.body_,
+                                  materialIdFromName(material_.name), material_.strength, maxHp);
 
     // 初始化备用shape（如果纹理加载失败时使用）
     shape_.setSize(size);
@@ -46,66 +89,78 @@ Block::Block(const Material& material, const sf::Vector2f& pos, const sf::Vector
     }
 }
 
+Block::~Block() {
+    releaseEntity(body_, handle_);
+}
+
+void* Block::operator new(std::size_t size) {
+    return poolAllocate<Block>(size);
+}
+
+void Block::operator delete(void* p, std::size_t size) {
+    poolDeallocate<Block>(p, size);
+}
+
 void Block::update(float dt) {
-    age_ += dt;
-    if (!body_.active()) {
-        destroyed_ = true;
-        return;
-    }
+    // 出生计时、受伤闪烁倒计时、撞击与血量判定已由 EntityTable::tick 在本步整表处理，这里只刷新画面
+    if (destroyed_) return;
     // CRITICAL FIX: Always sync visual position and rotation with physics body
     if (sprite_.has_value()) {
         sprite_->setPosition(body_.position());
         sprite_->setRotation(sf::radians(body_.angle()));  // SFML 3.0 uses sf::radians()
-    } else {
-        shape_.setPosition(body_.position());
-        shape_.setRotation(sf::radians(body_.angle()));  // SFML 3.0 uses sf::radians()
+        finishUpdate(body_, prev_, false);  // 贴图版不改颜色，无需为闪烁保持更新
+        return;
     }
-    
-    // Update damage flash effect (for fallback shape only, texture doesn't need color changes)
-    if (!sprite_.has_value() && damageFlash_ > 0.0f) {
-        damageFlash_ -= dt;
+    shape_.setPosition(body_.position());
+    shape_.setRotation(sf::radians(body_.angle()));  // SFML 3.0 uses sf::radians()
+
+    // 只有备用 shape 播放受伤闪烁（无窗口模式不绘制，跳过）
+    EntityTable& table = tableOf(body_);
+    const std::uint32_t row = table.row(handle_);
+    if (table.takeVisualDirty(row) && !Entity::headless()) updateShapeColor(table, row);
+    finishUpdate(body_, prev_, !Entity::headless() && table.flash(row) > 0.0f);
+}
+
+void Block::updateShapeColor(const EntityTable& table, std::uint32_t row) {
+    const auto baseColor = material_.color;
+    const auto alpha = static_cast<std::uint8_t>(material_.opacity * 255);
+    const float flash = table.flash(row);
+    if (flash > 0.0f) {
         // Update visual color during flash
-        float healthRatio = static_cast<float>(hp_) / static_cast<float>(maxHp_);
-        auto baseColor = material_.color;
-        float flashIntensity = damageFlash_ / 0.2f;
+        float flashIntensity = flash / EntityTable::kDamageFlashTime;
         shape_.setFillColor(sf::Color(
             static_cast<std::uint8_t>(baseColor.r + (255 - baseColor.r) * flashIntensity * 0.5f),
             static_cast<std::uint8_t>(baseColor.g * (1.0f - flashIntensity * 0.3f)),
             static_cast<std::uint8_t>(baseColor.b * (1.0f - flashIntensity * 0.3f)),
-            static_cast<std::uint8_t>(material_.opacity * 255)
+            alpha
         ));
-    } else if (!sprite_.has_value() && hp_ < maxHp_) {
-        // Update visual color based on health (when not flashing)
-        float healthRatio = static_cast<float>(hp_) / static_cast<float>(maxHp_);
-        auto baseColor = material_.color;
+    } else {
+        // Update visual color based on health (when not flashing; full health = base color)
+        float healthRatio = static_cast<float>(table.hp(row)) / static_cast<float>(table.maxHp(row));
         shape_.setFillColor(sf::Color(
             static_cast<std::uint8_t>(baseColor.r * (0.5f + 0.5f * healthRatio)),
             static_cast<std::uint8_t>(baseColor.g * (0.5f + 0.5f * healthRatio)),
             static_cast<std::uint8_t>(baseColor.b * (0.5f + 0.5f * healthRatio)),
-            static_cast<std::uint8_t>(material_.opacity * 255)
+            alpha
         ));
     }
-    
-    // Apply damage from hitStrength (legacy system for bird impacts)
-    if (age_ >= kSpawnInvincibleTime && body_.hitStrength() > material_.strength) {
-        body_.setActive(false);
-        destroyed_ = true;
-    }
-    
-    // Check if block is destroyed due to health
-    if (hp_ <= 0) {
-        body_.setActive(false);
-        destroyed_ = true;
-    }
+}
+
+int Block::health() const {
+    const EntityTable& table = tableOf(body_);
+    return table.hp(table.row(handle_));
+}
+
+int Block::maxHealth() const {
+    const EntityTable& table = tableOf(body_);
+    return table.maxHp(table.row(handle_));
 }
 
 void Block::takeDamage(float damage) {
-    if (age_ < kSpawnInvincibleTime) return;  // Invincible during spawn
-    
-    hp_ -= static_cast<int>(damage);
-    hp_ = std::max(0, hp_);
-    damageFlash_ = 0.2f;  // Flash for 0.2 seconds
+    // 无敌判定、扣血、闪烁并请求进入唤醒集合（休眠中被伤害也要处理闪烁与销毁）
     // Visual update will happen in update() method
+    EntityTable& table = tableOf(body_);
+    table.applyDamage(table.row(handle_), damage, body_.worldTime());
 }
 
 void Block::draw(sf::RenderWindow& window) {
@@ -118,7 +173,41 @@ void Block::draw(sf::RenderWindow& window) {
     }
 }
 
+void Block::savePreviousTransform() {
+    if (body_.active()) savePrevious(body_, prev_);
+}
+
+void Block::interpolateVisual(float alpha) {
+    if (destroyed_ || !body_.active()) return;
+    sf::Vector2f pos;
+    float angle = 0.0f;
+    lerpTransform(body_, prev_, alpha, pos, angle);
+    if (sprite_.has_value()) {
+        sprite_->setPosition(pos);
+        sprite_->setRotation(sf::radians(angle));
+    } else {
+        shape_.setPosition(pos);
+        shape_.setRotation(sf::radians(angle));
+    }
+}
+
+bool Block::appendToBatch(SpriteBatch& batch) const {
+    if (destroyed_) return true;  // 已销毁：无需绘制
+    return sprite_.has_value() && batch.add(*sprite_, texture_);
+}
+
+void Block::appendDrawables(RenderSnapshot& snapshot) const {
+    if (destroyed_) return;
+    if (sprite_.has_value()) {
+        snapshot.addDrawable(*sprite_);
+    } else {
+        snapshot.addDrawable(shape_);
+    }
+}
+
 void Block::loadTexture() {
+    if (Entity::headless()) return;  // 无窗口模式不加载贴图，使用备用shape
+
     std::string texturePath;
     
     // 根据材质类型选择对应的贴图
@@ -135,26 +224,26 @@ void Block::loadTexture() {
         return;
     }
     
-    // 加载纹理
-    if (!texture_.loadFromFile(texturePath)) {
-        std::cerr << "警告: 无法加载材质贴图 " << texturePath << "\n";
+    // 从共享缓存取纹理（同材质的方块共用一份）
+    texture_ = TextureCache::instance().get(texturePath);
+    if (!texture_) {
         return;
     }
     
     // 创建sprite
-    sprite_ = sf::Sprite(texture_);
+    sprite_ = sf::Sprite(*texture_);
     sprite_->setOrigin(size_ * 0.5f);  // 设置原点为中心
     sprite_->setPosition(body_.position());
     sprite_->setRotation(sf::radians(body_.angle()));
 }
 
 void Block::updateTextureRect() {
-    if (!sprite_.has_value()) {
+    if (!sprite_.has_value() || !texture_) {
         return;
     }
     
     // 获取纹理尺寸
-    sf::Vector2u textureSize = texture_.getSize();
+    sf::Vector2u textureSize = texture_->getSize();
     float textureWidth = static_cast<float>(textureSize.x);
     float textureHeight = static_cast<float>(textureSize.y);
     
@@ -162,8 +251,8 @@ void Block::updateTextureRect() {
     float blockWidth = size_.x;
     float blockHeight = size_.y;
     
-    // 设置纹理为可重复模式（SFML 3.0使用setRepeated）
-    texture_.setRepeated(true);
+    // 设置纹理为可重复模式（SFML 3.0使用setRepeated；共享纹理上重复设置无副作用）
+    texture_->setRepeated(true);
     
     // 设置纹理矩形：使用Block的实际尺寸，纹理会自动重复
     // 如果Block比贴图小，纹理会被裁剪到Block大小
@@ -183,8 +272,8 @@ Pig::Pig(PigType type, const sf::Vector2f& pos, PhysicsWorld& world) : type_(typ
     int baseHp = (type == PigType::Large)
                      ? config::kPigHpLargeBase
                      : (type == PigType::Medium ? config::kPigHpMediumBase : config::kPigHpSmallBase);
-    maxHp_ = static_cast<int>(baseHp * config::kPigHpFactor);  // 整体提升 30%
-    hp_ = maxHp_;
+    int maxHp = static_cast<int>(baseHp * config::kPigHpFactor);  // 整体提升 30%
+    handle_ = world.entities().add(EntityKind::Pig, this, body_.userData_, body_.body_, kUnknownMaterialId, 0.0f, maxHp);
     
     // 加载贴图
     loadTextures();
@@ -198,12 +287,21 @@ Pig::Pig(PigType type, const sf::Vector2f& pos, PhysicsWorld& world) : type_(typ
     }
 }
 
+Pig::~Pig() {
+    releaseEntity(body_, handle_);
+}
+
+void* Pig::operator new(std::size_t size) {
+    return poolAllocate<Pig>(size);
+}
+
+void Pig::operator delete(void* p, std::size_t size) {
+    poolDeallocate<Pig>(p, size);
+}
+
 void Pig::update(float dt) {
-    age_ += dt;
-    if (!body_.active()) {
-        destroyed_ = true;
-        return;
-    }
+    // 出生计时、受伤闪烁倒计时、撞击与血量判定已由 EntityTable::tick 在本步整表处理
+    if (destroyed_) return;
     
     // Apply air resistance: -0.25 m/s^2 acceleration in opposite direction of velocity
     if (body_.active() && body_.body_) {
@@ -229,76 +327,52 @@ void Pig::update(float dt) {
         sprite_->setRotation(sf::radians(currentRotation_));  // SFML 3.0 uses sf::radians()
     }
     
-    // Update damage flash effect and texture if health changed
-    bool healthChanged = false;
-    if (damageFlash_ > 0.0f) {
-        damageFlash_ -= dt;
-        updateVisuals();
-    }
-    
-    // Legacy damage system for bird impacts (keep for compatibility)
-    float damage = body_.hitStrength() * 0.1f;
-    if (age_ >= kSpawnInvincibleTime && damage > 1.0f) {
-        int oldHp = hp_;
-        hp_ -= static_cast<int>(damage);
-        hp_ = std::max(0, hp_);
-        healthChanged = (oldHp != hp_);
-        // hitStrength is cleared by PhysicsWorld each frame, so we don't need to reset it
-        updateVisuals();
-        if (hp_ <= 0) {
-            body_.setActive(false);
-            destroyed_ = true;
-        }
-    }
-    
-    // Check if pig is destroyed due to health
-    if (hp_ <= 0) {
-        body_.setActive(false);
-        destroyed_ = true;
-    }
-    
-    // Update texture if health level changed
-    if (healthChanged) {
-        updateVisuals();
-    }
+    // 血量阶段贴图与闪烁颜色只在本步有变化时刷新
+    EntityTable& table = tableOf(body_);
+    const std::uint32_t row = table.row(handle_);
+    if (table.takeVisualDirty(row)) updateVisuals();
+
+    finishUpdate(body_, prev_, table.flash(row) > 0.0f);
+}
+
+int Pig::health() const {
+    const EntityTable& table = tableOf(body_);
+    return table.hp(table.row(handle_));
+}
+
+int Pig::maxHealth() const {
+    const EntityTable& table = tableOf(body_);
+    return table.maxHp(table.row(handle_));
 }
 
 void Pig::takeDamage(float damage) {
-    if (age_ < kSpawnInvincibleTime) return;  // Invincible during spawn
-    
-    hp_ -= static_cast<int>(damage);
-    hp_ = std::max(0, hp_);
-    damageFlash_ = 0.2f;  // Flash for 0.2 seconds
-    updateVisuals();
+    // 贴图在下一次 update() 中按 visualDirty 刷新
+    EntityTable& table = tableOf(body_);
+    table.applyDamage(table.row(handle_), damage, body_.worldTime());
 }
 
 void Pig::loadTextures() {
     textures_.clear();
-    textures_.resize(4);  // 4个健康等级：100%, 75%, 50%, 25%
-    
-    // 加载4个健康等级的贴图
-    std::vector<std::string> texturePaths = {
+    if (Entity::headless()) return;  // 无窗口模式不加载贴图
+
+    // 4个健康等级的贴图：100%, 75%, 50%, 25%（所有猪共享缓存中的同一份）
+    static const char* const kTexturePaths[] = {
         "image/pig_nor_100.png",
         "image/pig_nor_75.png",
         "image/pig_nor_50.png",
         "image/pig_nor_25.png"
     };
     
-    bool textureLoaded = false;
-    for (size_t i = 0; i < textures_.size(); ++i) {
-        if (!textures_[i].loadFromFile(texturePaths[i])) {
-            std::cerr << "警告: 无法加载猪贴图: " << texturePaths[i] << "\n";
-            // 如果加载失败，创建一个简单的占位符（可选）
-        } else if (!textureLoaded && i == 0) {
-            textureLoaded = true;
-        }
+    textures_.reserve(4);
+    for (const char* path : kTexturePaths) {
+        textures_.push_back(TextureCache::instance().get(path));  // 加载失败为 nullptr
     }
     
-    // 如果至少有一个贴图加载成功，设置sprite
-    if (textureLoaded && !textures_.empty() && textures_[0].getSize().x > 0) {
+    // 第一个贴图可用时设置sprite
+    if (textures_[0] && textures_[0]->getSize().x > 0) {
         // 初始化sprite_使用第一个贴图（SFML 3.0要求使用纹理构造）
-        sprite_ = sf::Sprite(textures_[0]);
-        sf::Vector2u textureSize = textures_[0].getSize();
+        sprite_ = sf::Sprite(*textures_[0]);
+        sf::Vector2u textureSize = textures_[0]->getSize();
         sprite_->setOrigin(sf::Vector2f(textureSize.x * 0.5f, textureSize.y * 0.5f));
         float targetSize = radius_ * 2.0f;
         float scale = targetSize / static_cast<float>(std::max(textureSize.x, textureSize.y));
@@ -308,7 +382,10 @@ void Pig::loadTextures() {
 
 void Pig::updateVisuals() {
     // 根据血量确定贴图索引
-    float ratio = std::max(0.0f, static_cast<float>(hp_) / static_cast<float>(maxHp_));
+    const EntityTable& table = tableOf(body_);
+    const std::uint32_t row = table.row(handle_);
+    const float damageFlash = table.flash(row);
+    float ratio = std::max(0.0f, static_cast<float>(table.hp(row)) / static_cast<float>(table.maxHp(row)));
     int newTextureIndex = 0;
     
     if (ratio > 0.75f) {
@@ -323,13 +400,13 @@ void Pig::updateVisuals() {
     
     // 如果贴图索引改变，更新贴图
     if (newTextureIndex != currentTextureIndex_ && newTextureIndex < static_cast<int>(textures_.size()) && 
-        textures_[newTextureIndex].getSize().x > 0) {
+        textures_[newTextureIndex] && textures_[newTextureIndex]->getSize().x > 0) {
         currentTextureIndex_ = newTextureIndex;
         // 创建新的sprite（SFML 3.0要求使用纹理构造）
-        sprite_ = sf::Sprite(textures_[currentTextureIndex_]);
+        sprite_ = sf::Sprite(*textures_[currentTextureIndex_]);
         
         // 设置贴图原点为中心
-        sf::Vector2u textureSize = textures_[currentTextureIndex_].getSize();
+        sf::Vector2u textureSize = textures_[currentTextureIndex_]->getSize();
         sprite_->setOrigin(sf::Vector2f(textureSize.x * 0.5f, textureSize.y * 0.5f));
         
         // 根据猪的类型缩放贴图，确保和当前显示大小差不多
@@ -344,8 +421,8 @@ void Pig::updateVisuals() {
     }
     
     // 受伤闪烁效果（可选，通过颜色调制实现）
-    if (sprite_.has_value() && damageFlash_ > 0.0f) {
-        float flashIntensity = damageFlash_ / 0.2f;
+    if (sprite_.has_value() && damageFlash > 0.0f) {
+        float flashIntensity = damageFlash / EntityTable::kDamageFlashTime;
         // 在受伤时稍微变红
         sprite_->setColor(sf::Color(
             255,
@@ -363,6 +440,29 @@ void Pig::draw(sf::RenderWindow& window) {
     }
 }
 
+void Pig::savePreviousTransform() {
+    if (body_.active()) savePrevious(body_, prev_);
+}
+
+void Pig::interpolateVisual(float alpha) {
+    if (destroyed_ || !body_.active() || !sprite_.has_value()) return;
+    sf::Vector2f pos;
+    float angle = 0.0f;
+    lerpTransform(body_, prev_, alpha, pos, angle);
+    sprite_->setPosition(pos);
+    sprite_->setRotation(sf::radians(angle));
+}
+
+bool Pig::appendToBatch(SpriteBatch& batch) const {
+    if (destroyed_ || !sprite_.has_value()) return true;  // 与 draw() 一致：没有贴图时不绘制
+    if (currentTextureIndex_ >= static_cast<int>(textures_.size())) return false;
+    return batch.add(*sprite_, textures_[currentTextureIndex_]);
+}
+
+void Pig::appendDrawables(RenderSnapshot& snapshot) const {
+    if (!destroyed_ && sprite_.has_value()) snapshot.addDrawable(*sprite_);
+}
+
 Bird::Bird(BirdType type, const sf::Vector2f& pos, PhysicsWorld& world) : type_(type), world_(&world) {
     radius_ = 14.f;
     // Birds start as static (not dynamic) until launched
@@ -476,6 +576,18 @@ void Bird::activateSkill() {
     }
 }
 
+Bird::~Bird() {
+    body_.release();
+}
+
+void* Bird::operator new(std::size_t size) {
+    return poolAllocate<Bird>(size);
+}
+
+void Bird::operator delete(void* p, std::size_t size) {
+    poolDeallocate<Bird>(p, size);
+}
+
 void Bird::update(float dt) {
     // Apply air resistance: -0.1 m/s^2 acceleration in opposite direction of velocity
     if (body_.active() && launched_ && body_.body_) {
@@ -589,52 +701,53 @@ void Bird::update(float dt) {
             if (explosionTimer_ <= 0 && world_) {
                 sf::Vector2f bombPos = body_.position();
                 b2Body* bombBody = body_.body_;
-                for (b2Body* other = world_->world()->GetBodyList(); other; other = other->GetNext()) {
+                // 通过宽相位只取爆炸半径内的刚体，开销与范围内刚体数成正比，而非关卡刚体总数
+                const float radius = 120.0f;
+                std::vector<b2Body*> bodiesInRange;
+                world_->queryRadius(bombPos, radius, bodiesInRange);
+                for (b2Body* other : bodiesInRange) {
                     if (other == bombBody) continue;
                     sf::Vector2f otherPos = PhysicsWorld::meterToPixel(other->GetPosition());
                     sf::Vector2f delta = otherPos - bombPos;
                     float distSq = delta.x * delta.x + delta.y * delta.y;
-                    float radius = 120.0f;
-                    if (distSq < radius * radius) {
-                        float dist = std::max(4.0f, std::sqrt(distSq));
-                        sf::Vector2f dir = delta / dist;
-                        // Much stronger explosion power to destroy all materials
-                        // Power is in pixels, need to convert to meters for Box2D impulse
-                        float powerPixels = 1000000.0f / dist;  // Massive explosion power
-                        // Damage calculation:
-                        // - For blocks: damage must > material.strength (glass=120, stone=800)
-                        // - For pigs: damage * 0.1 must > maxHp (max 50), so damage > 500
-                        // Set damage to be much higher than needed to ensure destruction
-                        float damage = powerPixels * 2.0f;  // Very high damage multiplier (2M at close range)
-                        
-                        // Apply impulse to dynamic bodies - convert pixel force to Box2D impulse
-                        // Box2D uses kg*m/s for impulse, so we need to scale by pixels-per-meter
-                        if (other->GetType() == b2_dynamicBody) {
-                            // Convert pixel force to Box2D impulse (force * time = impulse)
-                            // powerPixels is in pixels, convert to meters and apply as impulse
-                            b2Vec2 impulseDir = PhysicsWorld::pixelToMeter(dir);
-                            // Use larger impulse magnitude for stronger explosion effect
-                            float impulseMagnitude = (powerPixels / config::kPixelsPerMeter) * 3.0f;  // Triple the impulse
-                            b2Vec2 impulse = impulseMagnitude * impulseDir;
-                            other->ApplyLinearImpulse(impulse, other->GetWorldCenter(), true);
-                        }
-                        
-                        // Apply damage to ALL bodies (including static ones) through user data
-                        // This is critical - damage must be applied to fixtures for blocks/pigs to take damage
-                        // Apply damage to ALL fixtures of the body to ensure it's registered
-                        b2Fixture* fixture = other->GetFixtureList();
-                        while (fixture) {
-                            FixtureUserData* data = reinterpret_cast<FixtureUserData*>(
-                                fixture->GetUserData().pointer);
-                            if (data) {
-                                // Apply massive damage - ensure it exceeds material strength and pig HP
-                                // For blocks: damage must > material.strength (max ~800 for stone)
-                                // For pigs: damage * 0.1 must > maxHp (max 50), so damage > 500
-                                // Set damage to be much higher than needed
-                                data->hitStrength = std::max(data->hitStrength, damage);
-                            }
-                            fixture = fixture->GetNext();
+                    float dist = std::max(4.0f, std::sqrt(distSq));
+                    sf::Vector2f dir = delta / dist;
+                    // Much stronger explosion power to destroy all materials
+                    // Power is in pixels, need to convert to meters for Box2D impulse
+                    float powerPixels = 1000000.0f / dist;  // Massive explosion power
+                    // Damage calculation:
+                    // - For blocks: damage must > material.strength (glass=120, stone=800)
+                    // - For pigs: damage * 0.1 must > maxHp (max 50), so damage > 500
+                    // Set damage to be much higher than needed to ensure destruction
+                    float damage = powerPixels * 2.0f;  // Very high damage multiplier (2M at close range)
+                    
+                    // Apply impulse to dynamic bodies - convert pixel force to Box2D impulse
+                    // Box2D uses kg*m/s for impulse, so we need to scale by pixels-per-meter
+                    if (other->GetType() == b2_dynamicBody) {
+                        // Convert pixel force to Box2D impulse (force * time = impulse)
+                        // powerPixels is in pixels, convert to meters and apply as impulse
+                        b2Vec2 impulseDir = PhysicsWorld::pixelToMeter(dir);
+                        // Use larger impulse magnitude for stronger explosion effect
+                        float impulseMagnitude = (powerPixels / config::kPixelsPerMeter) * 3.0f;  // Triple the impulse
+                        b2Vec2 impulse = impulseMagnitude * impulseDir;
+                        other->ApplyLinearImpulse(impulse, other->GetWorldCenter(), true);
+                    }
+                    
+                    // Apply damage to ALL bodies (including static ones) through user data
+                    // This is critical - damage must be applied to fixtures for blocks/pigs to take damage
+                    // Apply damage to ALL fixtures of the body to ensure it's registered
+                    b2Fixture* fixture = other->GetFixtureList();
+                    while (fixture) {
+                        FixtureUserData* data = reinterpret_cast<FixtureUserData*>(
+                            fixture->GetUserData().pointer);
+                        if (data) {
+                            // Apply massive damage - ensure it exceeds material strength and pig HP
+                            // For blocks: damage must > material.strength (max ~800 for stone)
+                            // For pigs: damage * 0.1 must > maxHp (max 50), so damage > 500
+                            // Set damage to be much higher than needed
+                            data->hitStrength = std::max(data->hitStrength, damage);
                         }
+                        fixture = fixture->GetNext();
                     }
                 }
                 exploded_ = true;
@@ -646,6 +759,8 @@ void Bird::update(float dt) {
 }
 
 void Bird::loadTexture() {
+    if (Entity::headless()) return;  // 无窗口模式不加载贴图
+
     std::string texturePath;
     switch (type_) {
         case BirdType::Red:
@@ -659,16 +774,16 @@ void Bird::loadTexture() {
             break;
     }
     
-    if (!texture_.loadFromFile(texturePath)) {
-        std::cerr << "警告: 无法加载鸟贴图: " << texturePath << "\n";
+    texture_ = TextureCache::instance().get(texturePath);
+    if (!texture_) {
         return;  // 如果加载失败，sprite将无法使用，但不会崩溃
     }
     
     // 设置贴图（SFML 3.0要求sprite必须有一个纹理）
-    sprite_ = sf::Sprite(texture_);
+    sprite_ = sf::Sprite(*texture_);
     
     // 设置贴图原点为中心
-    sf::Vector2u textureSize = texture_.getSize();
+    sf::Vector2u textureSize = texture_->getSize();
     sprite_->setOrigin(sf::Vector2f(textureSize.x * 0.5f, textureSize.y * 0.5f));
     
     // 缩放贴图以适应半径（假设贴图原始大小约为28x28，需要缩放到radius_*2）
@@ -682,24 +797,74 @@ void Bird::loadTexture() {
 void Bird::draw(sf::RenderWindow& window) {
     if (destroyed_) return;
     // Bomb explosion visual
-    if (type_ == BirdType::Bomb && exploded_ && explosionVisualTime_ > 0.0f) {
-        float t = explosionVisualTime_ / 0.5f;  // 0..1
-        float radius = 120.0f * (1.0f - t);
-        sf::CircleShape boom(radius);
-        boom.setOrigin({radius, radius});
-        boom.setPosition(body_.position());
-        sf::Color c(255, 200, 0, static_cast<std::uint8_t>(255 * t));
-        boom.setFillColor(sf::Color(255, 200, 0, static_cast<std::uint8_t>(120 * t)));
-        boom.setOutlineColor(c);
-        boom.setOutlineThickness(4.0f);
-        window.draw(boom);
-    }
+    if (auto boom = explosionShape()) window.draw(*boom);
     // 只有在sprite已初始化时才绘制
     if (sprite_.has_value()) {
         window.draw(*sprite_);
     }
 }
 
+std::optional<sf::CircleShape> Bird::explosionShape() const {
+    if (type_ != BirdType::Bomb || !exploded_ || explosionVisualTime_ <= 0.0f) return std::nullopt;
+    float t = explosionVisualTime_ / 0.5f;  // 0..1
+    float radius = 120.0f * (1.0f - t);
+    sf::CircleShape boom(radius);
+    boom.setOrigin({radius, radius});
+    boom.setPosition(body_.position());
+    sf::Color c(255, 200, 0, static_cast<std::uint8_t>(255 * t));
+    boom.setFillColor(sf::Color(255, 200, 0, static_cast<std::uint8_t>(120 * t)));
+    boom.setOutlineColor(c);
+    boom.setOutlineThickness(4.0f);
+    return boom;
+}
+
+void Bird::appendDrawables(RenderSnapshot& snapshot) const {
+    if (destroyed_) return;
+    if (auto boom = explosionShape()) snapshot.addDrawable(*boom);
+    if (sprite_.has_value()) snapshot.addDrawable(*sprite_);
+}
+
+void Bird::savePreviousTransform() {
+    if (body_.active()) savePrevious(body_, prev_);
+}
+
+void Bird::interpolateVisual(float alpha) {
+    if (destroyed_ || !body_.active() || !sprite_.has_value()) return;
+    // 未发射的鸟会被直接摆到弹弓上（非物理移动），由 update() 同步位置即可
+    if (!launched_) return;
+    sf::Vector2f pos;
+    float angle = 0.0f;
+    lerpTransform(body_, prev_, alpha, pos, angle);
+    sprite_->setPosition(pos);
+    sprite_->setRotation(sf::radians(angle));
+}
+
+bool Bird::appendToBatch(SpriteBatch& batch) const {
+    if (destroyed_) return true;
+    // 炸弹爆炸特效需要在精灵之前画圆，交给 draw() 单独绘制
+    if (type_ == BirdType::Bomb && exploded_ && explosionVisualTime_ > 0.0f) return false;
+    if (!sprite_.has_value()) return true;
+    return batch.add(*sprite_, texture_);
+}
+
+const std::vector<std::string>& entityTexturePaths() {
+    // 与 Block::loadTexture / Pig::loadTextures / Bird::loadTexture 中的路径保持一致
+    static const std::vector<std::string> paths = {
+        "image/log.png",
+        "image/glass.png",
+        "image/stone_lab.png",
+        "image/stone.png",
+        "image/pig_nor_100.png",
+        "image/pig_nor_75.png",
+        "image/pig_nor_50.png",
+        "image/pig_nor_25.png",
+        "image/bird_red.png",
+        "image/bird_yellow.png",
+        "image/bird_black.png",
+    };
+    return paths;
+}
+
 ScorePopups::ScorePopups(const sf::Font& font) : font_(font) {}
 
 void ScorePopups::spawn(const sf::Vector2f& pos, int points) {
@@ -721,6 +886,6 @@ void ScorePopups::update(float dt) {
                   popups_.end());
 }
 
-void ScorePopups::draw(sf::RenderWindow& window) {
-    for (auto& p : popups_) window.draw(p.text);
+void ScorePopups::appendTexts(std::vector<sf::Text>& out) const {
+    for (const auto& p : popups_) out.push_back(p.text);
 }
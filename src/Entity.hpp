@@ -2,14 +2,26 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Material.hpp"
 #include "Physics.hpp"
 
+class RenderSnapshot;
+class SpriteBatch;
+
+// 上一物理步的刚体变换（用于渲染插值）
+struct PreviousTransform {
+    sf::Vector2f position;
+    float angle{0.0f};
+    bool valid{false};
+};
+
 enum class BirdType { Red, Yellow, Bomb };
 enum class PigType { Small, Medium, Large };
 
@@ -24,77 +36,120 @@ public:
     virtual ~Entity() = default;
     virtual void update(float dt) = 0;
     virtual void draw(sf::RenderWindow& window) = 0;
+    // 批量渲染：把精灵追加到 batch；需要单独绘制（无贴图、有特效）时返回 false，由调用方调用 draw()
+    virtual bool appendToBatch(SpriteBatch& batch) const { return false; }
+    // 写入渲染快照：优先进快照的图集批次，否则复制一份可单独绘制的精灵/形状（与 draw() 画出的内容一致）
+    void appendToSnapshot(RenderSnapshot& snapshot) const;
+    // 渲染插值（固定步长循环）：每个物理步之前记录当前变换，渲染前在上一步与当前步之间按 alpha 插值
+    virtual void savePreviousTransform() {}
+    virtual void interpolateVisual(float alpha) {}
     bool isDestroyed() const { return destroyed_; }
 
+    // 无窗口模式（批量模拟/基准测试）：实体构造时跳过贴图加载，只保留物理与逻辑
+    static void setHeadless(bool headless) { headless_ = headless; }
+    // 仅对当前线程生效（后台线程构造只用于沉降的实体时，不能触碰贴图/OpenGL）
+    static void setThreadHeadless(bool headless) { threadHeadless_ = headless; }
+    static bool headless() { return headless_ || threadHeadless_; }
+
 protected:
+    // appendToBatch 返回 false 时调用：把 draw() 会画的对象按顺序复制进快照
+    virtual void appendDrawables(RenderSnapshot& snapshot) const {}
+
     bool destroyed_{false};
+
+private:
+    friend class EntityTable;  // EntityTable::tick 在血量归零/被撞碎时直接标记销毁
+
+    static inline bool headless_{false};
+    static inline thread_local bool threadHeadless_{false};
 };
 
 class Block : public Entity {
 public:
     Block(const Material& material, const sf::Vector2f& pos, const sf::Vector2f& size, PhysicsWorld& world);
+    ~Block() override;  // 析构时把刚体归还给 PhysicsWorld
+    static void* operator new(std::size_t size);  // 从 ObjectPool 分配，见 ObjectPool.hpp
+    static void operator delete(void* p, std::size_t size);
     void update(float dt) override;
     void draw(sf::RenderWindow& window) override;
+    bool appendToBatch(SpriteBatch& batch) const override;
+    void savePreviousTransform() override;
+    void interpolateVisual(float alpha) override;
     PhysicsBody* body() { return &body_; }
     const PhysicsBody* body() const { return &body_; }
     float strength() const { return material_.strength; }
     sf::Vector2f position() const { return body_.position(); }
     const Material& material() const { return material_; }
-    int health() const { return hp_; }
-    int maxHealth() const { return maxHp_; }
+    const sf::Vector2f& size() const { return size_; }  // 未旋转时的宽高（像素），朝向见 body()->angle()
+    // 血量与受伤闪烁存放在所属世界的 EntityTable 中（结构数组），这里经句柄读取
+    int health() const;
+    int maxHealth() const;
+    EntityHandle handle() const { return handle_; }
     void takeDamage(float damage);  // Apply damage to block
 
 private:
+    void appendDrawables(RenderSnapshot& snapshot) const override;
     void loadTexture();  // Load texture based on material type
     void updateTextureRect();  // Update texture rect for tiling/cropping
+    void updateShapeColor(const EntityTable& table, std::uint32_t row);  // 备用 shape：受伤闪烁与血量变暗
     
     Material material_;
     PhysicsBody body_;
+    PreviousTransform prev_;
     sf::Vector2f size_;  // Store block size for texture calculations
     sf::RectangleShape shape_;  // Fallback shape (if texture fails)
     std::optional<sf::Sprite> sprite_;  // Texture sprite
-    sf::Texture texture_;  // Block texture
-    float age_{0.0f};
-    int hp_{100};  // Health points
-    int maxHp_{100};  // Maximum health points
-    float damageFlash_{0.0f};  // Visual feedback timer
+    sf::Texture* texture_{nullptr};  // Block texture (shared, owned by TextureCache)
+    EntityHandle handle_;  // 受击状态（血量、闪烁、出生时间）在 EntityTable 中的行
 };
 
 class Pig : public Entity {
 public:
     Pig(PigType type, const sf::Vector2f& pos, PhysicsWorld& world);
+    ~Pig() override;
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p, std::size_t size);
     void update(float dt) override;
     void draw(sf::RenderWindow& window) override;
+    bool appendToBatch(SpriteBatch& batch) const override;
+    void savePreviousTransform() override;
+    void interpolateVisual(float alpha) override;
     PhysicsBody* body() { return &body_; }
     const PhysicsBody* body() const { return &body_; }
-    int health() const { return hp_; }
-    int maxHealth() const { return maxHp_; }
+    int health() const;
+    int maxHealth() const;
+    EntityHandle handle() const { return handle_; }
     PigType type() const { return type_; }
     sf::Vector2f position() const { return body_.position(); }
     void takeDamage(float damage);  // Apply damage to pig
 
 private:
+    void appendDrawables(RenderSnapshot& snapshot) const override;
     void updateVisuals();  // Update visual appearance based on health and damage flash
     void loadTextures();  // Load pig textures based on health level
     
     PigType type_;
     PhysicsBody body_;
-    int hp_{10};
-    int maxHp_{10};
+    PreviousTransform prev_;
+    EntityHandle handle_;
     float radius_{16.0f};
     std::optional<sf::Sprite> sprite_;  // Optional because SFML 3.0 requires texture for sprite construction
-    std::vector<sf::Texture> textures_;  // Textures for different health levels
+    std::vector<const sf::Texture*> textures_;  // Textures for different health levels (owned by TextureCache)
     int currentTextureIndex_{0};  // Current texture index based on health
-    float age_{0.0f};
-    float damageFlash_{0.0f};  // Visual feedback timer
     float currentRotation_{0.0f};  // Store rotation angle for texture switching
 };
 
 class Bird : public Entity {
 public:
     Bird(BirdType type, const sf::Vector2f& pos, PhysicsWorld& world);
+    ~Bird() override;
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p, std::size_t size);
     void update(float dt) override;
     void draw(sf::RenderWindow& window) override;
+    bool appendToBatch(SpriteBatch& batch) const override;
+    void savePreviousTransform() override;
+    void interpolateVisual(float alpha) override;
 
     BirdType type() const { return type_; }
     PhysicsBody* body() { return &body_; }
@@ -104,10 +159,13 @@ public:
     void activateSkill();
 
 private:
+    void appendDrawables(RenderSnapshot& snapshot) const override;
+    std::optional<sf::CircleShape> explosionShape() const;  // 炸弹爆炸的扩散圆（特效结束后为空）
     void loadTexture();  // Load bird texture based on type
     
     BirdType type_;
     PhysicsBody body_;
+    PreviousTransform prev_;
     PhysicsWorld* world_{nullptr};
     bool launched_{false};
     bool skillUsed_{false};
@@ -116,18 +174,37 @@ private:
     float explosionVisualTime_{0.0f};
     float radius_{14.0f};
     std::optional<sf::Sprite> sprite_;  // Optional because SFML 3.0 requires texture for sprite construction
-    sf::Texture texture_;
+    const sf::Texture* texture_{nullptr};  // Shared, owned by TextureCache
     float restTimer_{0.0f};
     float maxSpeed_{800.0f};  // Per-bird max speed limit (initialized in constructor)
 };
 
+// 删除已销毁的实体：与末尾元素交换后弹出（swap-and-pop），每次删除 O(1)，一次爆炸清掉几十个也不会退化成平方
+// 只交换 unique_ptr，实体对象本身在对象池中不移动，entityPtr 与 EntityTable 句柄保持有效（列表顺序会改变）
+// onRemove 在实体析构前调用（计分、弹出分数等）
+template <typename T, typename OnRemove>
+void removeDestroyed(std::vector<std::unique_ptr<T>>& entities, OnRemove&& onRemove) {
+    for (std::size_t i = 0; i < entities.size();) {
+        if (!entities[i]->isDestroyed()) {
+            ++i;
+            continue;
+        }
+        onRemove(*entities[i]);
+        if (i + 1 != entities.size()) std::swap(entities[i], entities.back());
+        entities.pop_back();
+    }
+}
+
+// 实体使用的全部贴图路径（启动时打包进图集，见 SpriteBatch.hpp）
+const std::vector<std::string>& entityTexturePaths();
+
 // Simple popup manager for score animations.
 class ScorePopups {
 public:
     explicit ScorePopups(const sf::Font& font);
     void spawn(const sf::Vector2f& pos, int points);
     void update(float dt);
-    void draw(sf::RenderWindow& window);
+    void appendTexts(std::vector<sf::Text>& out) const;  // 复制当前飘字（写入渲染快照）
 
 private:
     struct Popup {
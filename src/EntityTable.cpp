@@ -0,0 +1,178 @@
+// 方块/猪受击状态表实现
+#include "EntityTable.hpp"
+
+#include <algorithm>
+
+#include "Entity.hpp"
+#include "Physics.hpp"
+
+EntityHandle EntityTable::add(EntityKind kind, Entity* entity, FixtureUserData* data, b2Body* body,
+                              std::uint32_t materialId, float strength, int maxHp) {
+    const auto row = static_cast<std::uint32_t>(kind_.size());
+    kind_.push_back(kind);
+    entity_.push_back(entity);
+    data_.push_back(data);
+    body_.push_back(body);
+    materialId_.push_back(materialId);
+    strength_.push_back(strength);
+    hp_.push_back(maxHp);
+    maxHp_.push_back(maxHp);
+    flash_.push_back(0.0f);
+    spawnTime_.push_back(-1.0);
+    visualDirty_.push_back(0);
+    dead_.push_back(0);
+
+    EntityHandle handle;
+    if (!freeSlots_.empty()) {
+        handle.slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        rowOfSlot_[handle.slot] = row;
+    } else {
+        handle.slot = static_cast<std::uint32_t>(rowOfSlot_.size());
+        rowOfSlot_.push_back(row);
+        generation_.push_back(0);
+    }
+    handle.generation = generation_[handle.slot];
+    slotOfRow_.push_back(handle.slot);
+
+    if (data) data->handle = handle;
+    return handle;
+}
+
+bool EntityTable::contains(EntityHandle handle) const {
+    return handle.valid() && handle.slot < rowOfSlot_.size() &&
+           generation_[handle.slot] == handle.generation &&
+           rowOfSlot_[handle.slot] != EntityHandle::kInvalidSlot;
+}
+
+void EntityTable::remove(EntityHandle handle) {
+    if (!contains(handle)) return;
+
+    const std::uint32_t row = rowOfSlot_[handle.slot];
+    const auto last = static_cast<std::uint32_t>(kind_.size() - 1);
+    if (data_[row]) data_[row]->handle = EntityHandle{};
+    if (row != last) moveRow(last, row);
+
+    kind_.pop_back();
+    entity_.pop_back();
+    data_.pop_back();
+    body_.pop_back();
+    materialId_.pop_back();
+    strength_.pop_back();
+    hp_.pop_back();
+    maxHp_.pop_back();
+    flash_.pop_back();
+    spawnTime_.pop_back();
+    visualDirty_.pop_back();
+    dead_.pop_back();
+    slotOfRow_.pop_back();
+
+    rowOfSlot_[handle.slot] = EntityHandle::kInvalidSlot;
+    ++generation_[handle.slot];
+    freeSlots_.push_back(handle.slot);
+}
+
+void EntityTable::moveRow(std::uint32_t from, std::uint32_t to) {
+    kind_[to] = kind_[from];
+    entity_[to] = entity_[from];
+    data_[to] = data_[from];
+    body_[to] = body_[from];
+    materialId_[to] = materialId_[from];
+    strength_[to] = strength_[from];
+    hp_[to] = hp_[from];
+    maxHp_[to] = maxHp_[from];
+    flash_[to] = flash_[from];
+    spawnTime_[to] = spawnTime_[from];
+    visualDirty_[to] = visualDirty_[from];
+    dead_[to] = dead_[from];
+    slotOfRow_[to] = slotOfRow_[from];
+    rowOfSlot_[slotOfRow_[to]] = to;
+}
+
+void EntityTable::clear() {
+    for (FixtureUserData* data : data_) {
+        if (data) data->handle = EntityHandle{};
+    }
+    kind_.clear();
+    entity_.clear();
+    data_.clear();
+    body_.clear();
+    materialId_.clear();
+    strength_.clear();
+    hp_.clear();
+    maxHp_.clear();
+    flash_.clear();
+    spawnTime_.clear();
+    visualDirty_.clear();
+    dead_.clear();
+    slotOfRow_.clear();
+
+    // 槽位全部回收，代数递增使旧句柄失效
+    freeSlots_.clear();
+    for (std::uint32_t slot = static_cast<std::uint32_t>(rowOfSlot_.size()); slot-- > 0;) {
+        rowOfSlot_[slot] = EntityHandle::kInvalidSlot;
+        ++generation_[slot];
+        freeSlots_.push_back(slot);
+    }
+}
+
+bool EntityTable::takeVisualDirty(std::uint32_t row) {
+    const bool dirty = visualDirty_[row] != 0;
+    visualDirty_[row] = 0;
+    return dirty;
+}
+
+float EntityTable::age(std::uint32_t row, double now) const {
+    return spawnTime_[row] < 0.0 ? 0.0f : static_cast<float>(now - spawnTime_[row]);
+}
+
+std::size_t EntityTable::tick(float dt, double now) {
+    // 原先分散在 Block::update / Pig::update 中的逐实体判定；休眠实体同样参与（出生计时、闪烁不依赖唤醒）
+    constexpr float kPigHitDamageScale = 0.1f;  // 小鸟撞猪：hitStrength 的 10% 计为伤害
+    std::size_t destroyed = 0;
+    const std::size_t rows = kind_.size();
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (dead_[row]) continue;
+        if (spawnTime_[row] < 0.0) spawnTime_[row] = std::max(0.0, now - static_cast<double>(dt));
+        if (flash_[row] > 0.0f) {
+            flash_[row] -= dt;
+            visualDirty_[row] = 1;  // 闪烁推进（含结束的那一步）都要刷新颜色
+        }
+
+        // 小鸟直接撞击（DamageContactListener::resolveBirdImpact / 炸弹爆炸写入 hitStrength）
+        const float hit = data_[row] ? data_[row]->hitStrength : 0.0f;
+        b2Body* body = body_[row];
+        bool kill = body && !body->IsEnabled();
+        if (hit > 0.0f && now - spawnTime_[row] >= kSpawnInvincibleTime) {
+            if (kind_[row] == EntityKind::Block) {
+                kill = kill || hit > strength_[row];
+            } else {
+                const float damage = hit * kPigHitDamageScale;
+                if (damage > 1.0f) {
+                    const int oldHp = hp_[row];
+                    setHp(row, oldHp - static_cast<int>(damage));
+                    if (hp_[row] != oldHp) visualDirty_[row] = 1;
+                }
+            }
+        }
+        if (hp_[row] <= 0) kill = true;
+
+        if (kill) {
+            if (body) body->SetEnabled(false);
+            entity_[row]->destroyed_ = true;
+            dead_[row] = 1;
+            ++destroyed;
+        }
+    }
+    return destroyed;
+}
+
+bool EntityTable::applyDamage(std::uint32_t row, float damage, double now) {
+    if (age(row, now) < kSpawnInvincibleTime) return false;  // Invincible during spawn
+
+    setHp(row, hp_[row] - static_cast<int>(damage));
+    flash_[row] = kDamageFlashTime;
+    visualDirty_[row] = 1;
+    if (data_[row]) data_[row]->needsUpdate = true;
+    return true;
+}
@@ -0,0 +1,91 @@
+// 方块/猪的受击状态表（结构数组）：血量、受伤闪烁、出生时间、材质编号和刚体用户数据按列连续存放
+// 伤害结算（DamageContactListener::resolve）只访问这几列紧凑数组，不再经过 dynamic_cast 和材质名比较；
+// 每个物理步的出生计时、闪烁倒计时、撞击/血量判定由 tick() 对整张表做一次连续遍历，
+// 实体的 update() 只剩精灵/贴图刷新（由 visualDirty 列告知）
+// 删除行时与末行交换（swap-and-pop，O(1)）；实体与 FixtureUserData 持有的句柄经槽位表间接寻址，
+// 行被移动后句柄依然有效，被删除后由代数（generation）识别为失效
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Entity;
+class b2Body;
+struct FixtureUserData;
+
+enum class EntityKind : std::uint8_t { Block, Pig };
+
+struct EntityHandle {
+    static constexpr std::uint32_t kInvalidSlot = 0xFFFFFFFFu;
+    std::uint32_t slot{kInvalidSlot};
+    std::uint32_t generation{0};
+    bool valid() const { return slot != kInvalidSlot; }
+};
+
+class EntityTable {
+public:
+    static constexpr float kSpawnInvincibleTime = 2.5f;  // 出生后的无敌时间（秒）
+    static constexpr float kDamageFlashTime = 0.2f;      // 受伤闪烁时长（秒）
+
+    // 登记实体并把句柄写入其刚体的用户数据（data 可为 nullptr）
+    // strength：方块被小鸟直接撞碎的 hitStrength 阈值（材质强度），猪不使用
+    EntityHandle add(EntityKind kind, Entity* entity, FixtureUserData* data, b2Body* body, std::uint32_t materialId,
+                     float strength, int maxHp);
+    void remove(EntityHandle handle);  // 失效句柄忽略
+    void clear();
+
+    bool contains(EntityHandle handle) const;
+    std::size_t size() const { return kind_.size(); }
+
+    // 句柄 -> 当前行号；其他行被删除后行号可能改变，不要跨删除保存
+    std::uint32_t row(EntityHandle handle) const { return rowOfSlot_[handle.slot]; }
+
+    EntityKind kind(std::uint32_t row) const { return kind_[row]; }
+    Entity* entity(std::uint32_t row) const { return entity_[row]; }
+    std::uint32_t materialId(std::uint32_t row) const { return materialId_[row]; }
+    int hp(std::uint32_t row) const { return hp_[row]; }
+    int maxHp(std::uint32_t row) const { return maxHp_[row]; }
+    float flash(std::uint32_t row) const { return flash_[row]; }
+
+    void setHp(std::uint32_t row, int hp) { hp_[row] = hp < 0 ? 0 : hp; }
+
+    // 本步血量或闪烁有变化、实体需要刷新贴图/颜色；读取后清除
+    bool takeVisualDirty(std::uint32_t row);
+
+    // 出生后经过的时间：按世界时钟（PhysicsWorld::time）计算，刚体休眠、update() 被跳过期间照常计时
+    // 出生时刻在登记后的第一次 tick() 时记为该步的开始（与逐帧累加 dt 一致，不包含关卡沉降）；此前视为刚出生
+    float age(std::uint32_t row, double now) const;
+
+    // 每个物理步调用一次（物理步与小鸟更新之后、实体 update 之前），按行顺序遍历所有列：
+    // 出生计时、闪烁倒计时、小鸟撞击（hitStrength）判定，血量归零或刚体已停用的行停用刚体并标记实体销毁
+    // 返回本次新标记销毁的实体数（为 0 时调用方可以跳过删除遍历）
+    std::size_t tick(float dt, double now);
+
+    // 出生无敌期之外扣血并开始受伤闪烁，同时请求实体进入唤醒集合（刚体可能正在休眠）
+    // 返回 false 表示处于无敌期、伤害被忽略
+    bool applyDamage(std::uint32_t row, float damage, double now);
+
+private:
+    void moveRow(std::uint32_t from, std::uint32_t to);
+
+    // 按行连续存放的列
+    std::vector<EntityKind> kind_;
+    std::vector<Entity*> entity_;
+    std::vector<FixtureUserData*> data_;
+    std::vector<b2Body*> body_;
+    std::vector<std::uint32_t> materialId_;
+    std::vector<float> strength_;
+    std::vector<int> hp_;
+    std::vector<int> maxHp_;
+    std::vector<float> flash_;
+    std::vector<double> spawnTime_;  // < 0：尚未更新过
+    std::vector<std::uint8_t> visualDirty_;
+    std::vector<std::uint8_t> dead_;  // tick() 已标记销毁（等待实体析构时删除行）
+    std::vector<std::uint32_t> slotOfRow_;
+
+    // 槽位表：句柄的稳定间接层
+    std::vector<std::uint32_t> rowOfSlot_;
+    std::vector<std::uint32_t> generation_;
+    std::vector<std::uint32_t> freeSlots_;
+};
@@ -13,7 +13,10 @@
 #include "Material.hpp"
 #include "LevelEditor.hpp"
 #include "AIController.hpp"
+#include "LevelSettle.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "TextureCache.hpp"
 
 namespace {
 sf::Vector2f clampVec(const sf::Vector2f& v, float maxLen) {
@@ -59,46 +62,59 @@ Game::Game()
         std::cerr << "  3. " << config::kFontPathFallback << "\n";
     }
     
-    // Load background image
-    if (!backgroundTexture_.loadFromFile("image/background.png")) {
-        std::cerr << "警告: 无法加载背景图片 image/background.png\n";
-    } else {
+    // 贴图、音频交给启动资源流水线在后台解码，首帧不等待磁盘；开屏场景期间逐帧上传
+    queueStartupAssets();
+    startupAssets_.start();
+    
+    // 初始化AI控制器
+    aiController_ = std::make_unique<AIController>();
+}
+
+void Game::queueStartupAssets() {
+    // 开屏只用背景图，排在最前面最先解码
+    startupAssets_.addTexture("image/background.png", backgroundTexture_, [this] {
         backgroundSprite_ = sf::Sprite(backgroundTexture_);
         // Scale background to fit window
         sf::Vector2u textureSize = backgroundTexture_.getSize();
         float scaleX = static_cast<float>(config::kWindowWidth) / static_cast<float>(textureSize.x);
         float scaleY = static_cast<float>(config::kWindowHeight) / static_cast<float>(textureSize.y);
         backgroundSprite_->setScale(sf::Vector2f(scaleX, scaleY));
-    }
+    });
+    
+    // 加载主界面动画用的天空、地面、草和 Logo 贴图
+    startupAssets_.addTexture("image/sky.png", skyTexture_, [this] {
+        skyTextureWidth_ = static_cast<float>(skyTexture_.getSize().x);
+    });
+    startupAssets_.addTexture("image/ground.png", groundTexture_, [this] {
+        groundTextureWidth_ = static_cast<float>(groundTexture_.getSize().x);
+    });
+    startupAssets_.addTexture("image/grass.png", grassTexture_, [this] {
+        grassTextureWidth_ = static_cast<float>(grassTexture_.getSize().x);
+    });
+    startupAssets_.addTexture("image/logo.png", logoTexture_, [this] {
+        logoSprite_ = sf::Sprite(logoTexture_);
+        // 缩小50%
+        logoSprite_->setScale(sf::Vector2f(0.5f, 0.5f));
+        // 设置Logo位置：在窗口上方居中（考虑缩放后的尺寸）
+        sf::Vector2u logoSize = logoTexture_.getSize();
+        float scaledWidth = static_cast<float>(logoSize.x) * 0.5f;
+        float logoX = (static_cast<float>(config::kWindowWidth) - scaledWidth) * 0.5f;
+        float logoY = 60.0f;  // 距离顶部60像素
+        logoSprite_->setPosition({logoX, logoY});
+    });
     
     // Load choice background texture (level select)
-    if (!choiceBackgroundTexture_.loadFromFile("image/choice_background.png")) {
-        std::cerr << "警告: 无法加载选关界面背景图片 image/choice_background.png\n";
-    } else {
+    startupAssets_.addTexture("image/choice_background.png", choiceBackgroundTexture_, [this] {
         choiceBackgroundSprite_ = sf::Sprite(choiceBackgroundTexture_);
         // Scale background to fit window
         sf::Vector2u textureSize = choiceBackgroundTexture_.getSize();
         float scaleX = static_cast<float>(config::kWindowWidth) / static_cast<float>(textureSize.x);
         float scaleY = static_cast<float>(config::kWindowHeight) / static_cast<float>(textureSize.y);
         choiceBackgroundSprite_->setScale(sf::Vector2f(scaleX, scaleY));
-    }
-    
-    // Load win background texture (score screen)
-    if (!winBackgroundTexture_.loadFromFile("image/win_back.png")) {
-        std::cerr << "警告: 无法加载胜利界面背景图片 image/win_back.png\n";
-    } else {
-        winBackgroundSprite_ = sf::Sprite(winBackgroundTexture_);
-        // Scale background to fit window
-        sf::Vector2u textureSize = winBackgroundTexture_.getSize();
-        float scaleX = static_cast<float>(config::kWindowWidth) / static_cast<float>(textureSize.x);
-        float scaleY = static_cast<float>(config::kWindowHeight) / static_cast<float>(textureSize.y);
-        winBackgroundSprite_->setScale(sf::Vector2f(scaleX, scaleY));
-    }
+    });
     
     // Load slingshot texture
-    if (!slingshotTexture_.loadFromFile("image/dangong.png")) {
-        std::cerr << "警告: 无法加载弹弓贴图 image/dangong.png\n";
-    } else {
+    startupAssets_.addTexture("image/dangong.png", slingshotTexture_, [this] {
         slingshotSprite_ = sf::Sprite(slingshotTexture_);
         // Set origin to center
         sf::Vector2u textureSize = slingshotTexture_.getSize();
@@ -111,49 +127,53 @@ Game::Game()
         const float targetHeight = birdRadius * 3.0f;  // 两个鸟重叠的高度：1.5个直径 = 42像素
         float scale = targetHeight / static_cast<float>(textureSize.y);
         slingshotSprite_->setScale(sf::Vector2f(scale, scale));
-    }
-
-    // 主界面动画用小鸟贴图（纯视觉，不参与物理/声音）
-    if (!splashBirdRedTexture_.loadFromFile("image/bird_red.png")) {
-        std::cerr << "警告: 无法加载主界面动画红鸟贴图 image/bird_red.png\n";
-    }
-    if (!splashBirdYellowTexture_.loadFromFile("image/bird_yellow.png")) {
-        std::cerr << "警告: 无法加载主界面动画黄鸟贴图 image/bird_yellow.png\n";
-    }
-    if (!splashBirdBlackTexture_.loadFromFile("image/bird_black.png")) {
-        std::cerr << "警告: 无法加载主界面动画黑鸟贴图 image/bird_black.png\n";
-    }
+    });
     
-    // 加载主界面动画用的地面、草和天空贴图
-    if (!groundTexture_.loadFromFile("image/ground.png")) {
-        std::cerr << "警告: 无法加载地面贴图 image/ground.png\n";
-    } else {
-        groundTextureWidth_ = static_cast<float>(groundTexture_.getSize().x);
-    }
-    if (!grassTexture_.loadFromFile("image/grass.png")) {
-        std::cerr << "警告: 无法加载草贴图 image/grass.png\n";
-    } else {
-        grassTextureWidth_ = static_cast<float>(grassTexture_.getSize().x);
-    }
-    if (!skyTexture_.loadFromFile("image/sky.png")) {
-        std::cerr << "警告: 无法加载天空贴图 image/sky.png\n";
-    } else {
-        skyTextureWidth_ = static_cast<float>(skyTexture_.getSize().x);
-    }
+    // 实体贴图（方块材质、猪血量阶段、鸟，含主界面动画用的小鸟）解码后登记到 TextureCache
+    for (const auto& path : entityTexturePaths()) {
+        startupAssets_.addCachedTexture(path);
+    }
+    // 按钮木纹背景同样登记到 TextureCache；按钮在 finishStartup 中创建（开屏期间不显示按钮）
+    startupAssets_.addCachedTexture(Button::kWoodTexturePath);
+    
+    // 音乐只打开流（读取文件头），音效解码到各自的缓冲区；主线程在 finishStartup 之前不访问它们
+    auto openMusic = [this](sf::Music& music, const char* path) {
+        startupAssets_.add([&music, path] { return music.openFromFile(path); },
+                           [path](bool ok) {
+                               if (!ok) std::cerr << "警告: 无法加载音乐文件 " << path << "\n";
+                           });
+    };
+    openMusic(titleTheme_, "music/title_theme.mp3");
+    openMusic(gameComplete_, "music/game_complete.mp3");
+    openMusic(birdsOutro_, "music/birds_outro.mp3");
+    
+    auto loadSound = [this](sf::SoundBuffer& buffer, const char* path) {
+        startupAssets_.add([&buffer, path] { return buffer.loadFromFile(path); },
+                           [path](bool ok) {
+                               if (!ok) std::cerr << "警告: 无法加载音效文件 " << path << "\n";
+                           });
+    };
+    // Bird select / flying sound buffers (Red, Yellow, Bomb)
+    loadSound(birdSelectBuffers_[0], "music/bird 01 select.wav");
+    loadSound(birdSelectBuffers_[1], "music/bird 02 select.wav");
+    loadSound(birdSelectBuffers_[2], "music/bird 03 select.wav");
+    loadSound(birdFlyingBuffers_[0], "music/bird 01 flying.wav");
+    loadSound(birdFlyingBuffers_[1], "music/bird 02 flying.wav");
+    loadSound(birdFlyingBuffers_[2], "music/bird 03 flying.wav");
+    
+    // 胜利界面背景只在结算界面使用，开屏结束后由 deferredAssets_ 在后台解码（见 finishStartup）；
+    // 关卡编辑器在第一次打开时才创建，其贴图全部来自上面的 TextureCache
+}
+
+void Game::finishStartup() {
+    // 主界面动画用小鸟贴图（纯视觉，不参与物理/声音；与关卡中的鸟共用缓存中的同一份贴图）
+    splashBirdRedTexture_ = TextureCache::instance().get("image/bird_red.png");
+    splashBirdYellowTexture_ = TextureCache::instance().get("image/bird_yellow.png");
+    splashBirdBlackTexture_ = TextureCache::instance().get("image/bird_black.png");
     
-    // 加载Logo贴图
-    if (!logoTexture_.loadFromFile("image/logo.png")) {
-        std::cerr << "警告: 无法加载Logo贴图 image/logo.png\n";
-    } else {
-        logoSprite_ = sf::Sprite(logoTexture_);
-        // 缩小50%
-        logoSprite_->setScale(sf::Vector2f(0.5f, 0.5f));
-        // 设置Logo位置：在窗口上方居中（考虑缩放后的尺寸）
-        sf::Vector2u logoSize = logoTexture_.getSize();
-        float scaledWidth = static_cast<float>(logoSize.x) * 0.5f;
-        float logoX = (static_cast<float>(config::kWindowWidth) - scaledWidth) * 0.5f;
-        float logoY = 60.0f;  // 距离顶部60像素
-        logoSprite_->setPosition({logoX, logoY});
+    // 实体贴图打包进图集，关卡内所有方块/猪/鸟合并为一次绘制
+    if (!entityAtlas_.build(entityTexturePaths())) {
+        std::cerr << "警告: 实体图集创建失败，实体将逐个绘制\n";
     }
     
     // 计算地面和草贴图的最小公倍数周期（考虑50%缩放）
@@ -178,16 +198,30 @@ Game::Game()
     }
     
     initAudio();
-    initButtons();
+    initButtons();  // 木纹贴图此时已在 TextureCache 中
     
-    // 初始化AI控制器
-    aiController_ = std::make_unique<AIController>();
-    aiController_->setGame(this);
+    // 进入游戏的每条路径都会调用 loadLevel，启动时不再预先同步加载第一关；
+    // 改为在后台预取（实体贴图此时已在缓存中，预取线程中创建的实体不会自己加载贴图）
+    levelPrefetcher_.request(levelIndex_);
+    
+    // 胜利界面背景不影响开屏，之后在后台解码、就绪后上传；此前结算界面只显示清屏颜色
+    deferredAssets_.addTexture("image/win_back.png", winBackgroundTexture_, [this] {
+        winBackgroundSprite_ = sf::Sprite(winBackgroundTexture_);
+        // Scale background to fit window
+        sf::Vector2u textureSize = winBackgroundTexture_.getSize();
+        float scaleX = static_cast<float>(config::kWindowWidth) / static_cast<float>(textureSize.x);
+        float scaleY = static_cast<float>(config::kWindowHeight) / static_cast<float>(textureSize.y);
+        winBackgroundSprite_->setScale(sf::Vector2f(scaleX, scaleY));
+    });
+    deferredAssets_.start();
     
-    loadLevel(levelIndex_);
+    startupDone_ = true;
+    Logger::getInstance().info("启动资源加载完成: " + std::to_string(startupAssets_.total()) + " 项, 耗时 " +
+                               std::to_string(startupClock_.getElapsedTime().asMilliseconds()) + " ms");
 }
 
 Game::~Game() {
+    simulationThread_.wait();
     Logger::getInstance().info("游戏关闭");
     Logger::getInstance().close();
 }
@@ -195,10 +229,29 @@ Game::~Game() {
 void Game::run() {
     sf::Clock clock;
     while (window_.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        processEvents();
-        update(dt);
-        render();
+        // 物理以固定步长推进（见 update 中的累加器），这里的 dt 只用于界面和动画
+        float dt = std::min(clock.restart().asSeconds(), config::kMaxFrameTime);
+        Profiler& profiler = Profiler::instance();
+        profiler.beginFrame();
+        // 流水线模式：上一帧的模拟任务与上一帧的绘制并行执行，处理输入前必须先汇合
+        syncSimulation();
+        {
+            ScopedTimer timer(ProfileZone::ProcessEvents);
+            processEvents();
+        }
+        {
+            ScopedTimer timer(ProfileZone::Update);
+            update(dt);
+        }
+        {
+            ScopedTimer timer(ProfileZone::Render);
+            render();
+        }
+        profiler.endFrame();
+        if (!firstFrameLogged_) {
+            firstFrameLogged_ = true;
+            Logger::getInstance().info("首帧耗时: " + std::to_string(startupClock_.getElapsedTime().asMilliseconds()) + " ms");
+        }
     }
 }
 
@@ -215,6 +268,35 @@ void Game::processEvents() {
     }
     prevTPressed = tPressed;
     
+    // P 键切换性能分析叠加图，F2 导出最近的帧耗时历史（任意场景）
+    static bool prevPPressed = false;
+    bool pPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::P);
+    if (scene_ == Scene::Playing && pPressed && !prevPPressed) {
+        showProfiler_ = !showProfiler_;
+    }
+    prevPPressed = pPressed;
+    
+    // F3 键切换模拟/渲染流水线（此时上一帧的模拟任务已汇合，可以安全切换）
+    static bool prevF3Pressed = false;
+    bool f3Pressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::F3);
+    if (scene_ == Scene::Playing && f3Pressed && !prevF3Pressed) {
+        pipelineEnabled_ = !pipelineEnabled_;
+        Logger::getInstance().info("模拟/渲染流水线: " + std::string(pipelineEnabled_ ? "开启" : "关闭"));
+    }
+    prevF3Pressed = f3Pressed;
+    
+    static bool prevF2Pressed = false;
+    bool f2Pressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::F2);
+    if (f2Pressed && !prevF2Pressed) {
+        const std::string csvPath = "profile.csv";
+        if (Profiler::instance().exportCsv(csvPath)) {
+            Logger::getInstance().info("性能数据已导出: " + csvPath);
+        } else {
+            Logger::getInstance().warning("性能数据导出失败: " + csvPath);
+        }
+    }
+    prevF2Pressed = f2Pressed;
+    
     // Track A key for AI mode toggle
     bool aPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A);
     if (scene_ == Scene::Playing && aPressed && !prevAPressed_) {
@@ -255,12 +337,22 @@ void Game::processEvents() {
 }
 
 void Game::update(float dt) {
+    // 开屏期间逐帧上传已解码的启动资源（每帧有时间预算，开屏画面保持流畅）
+    if (!startupDone_ && startupAssets_.pump(config::kStartupUploadBudgetMs)) {
+        finishStartup();
+    }
+    // 开屏之后延迟加载的资源（胜利界面背景）同样逐帧上传
+    if (startupDone_ && !deferredAssets_.done()) {
+        deferredAssets_.pump(config::kStartupUploadBudgetMs);
+    }
+    
     // Update music based on scene changes
     updateMusic();
     switch (scene_) {
         case Scene::Splash:
             splashTimer_ -= dt;
-            if (splashTimer_ <= 0) {
+            // 启动资源全部就绪后才离开开屏（慢盘上开屏会相应延长）
+            if (splashTimer_ <= 0 && startupDone_) {
                 scene_ = Scene::MainMenu;
                 Logger::getInstance().info("场景切换: Splash -> MainMenu");
             }
@@ -272,6 +364,15 @@ void Game::update(float dt) {
             break;
         case Scene::LevelSelect:
             updateButtons(dt);
+            // 预取悬停的关卡及其前后关卡，点击时直接使用预取结果
+            for (int i = 0; i < config::kLevelSelectCount && i < static_cast<int>(levelSelectButtons_.size()); ++i) {
+                if (levelSelectButtons_[i]->isHovered()) {
+                    levelPrefetcher_.request(i + 1);
+                    levelPrefetcher_.request(i);
+                    levelPrefetcher_.request(i + 2);
+                    break;
+                }
+            }
             break;
         case Scene::Playing: {
             gameTime_ += dt;
@@ -298,6 +399,7 @@ void Game::update(float dt) {
             
             // Update AI controller
             if (aiController_ && aiModeEnabled_) {
+                ScopedTimer aiTimer(ProfileZone::AI);
                 updateAI(dt);
                 handleAIControl(dt);
             }
@@ -465,158 +567,78 @@ void Game::update(float dt) {
                 prevMouseDown_ = mouseDown;
                 
                 // Update trajectory preview while dragging
-                previewPath_.clear();
                 // Use saved draggingBird_ reference for preview (avoids interference from launched birds)
-                if (launchState_ == LaunchState::Dragging && draggingBird_ && !draggingBird_->isLaunched()) {
+                if (launchState_ == LaunchState::Dragging && draggingBird_ && !draggingBird_->isLaunched() &&
+                    draggingBird_->body()) {
+                    ScopedTimer previewTimer(ProfileZone::PreviewPath);
                     auto* birdBody = draggingBird_->body();
-                    if (birdBody) {
-                        // 获取当前鼠标位置（使用游戏视图）
-                        sf::Vector2i pixelPos = sf::Mouse::getPosition(window_);
-                        // 使用游戏视图进行坐标转换
-                        sf::Vector2f dragCurrentInGameView = window_.mapPixelToCoords(pixelPos, gameView_);
-                        
-                        // Calculate pull and initial velocity exactly as in launchCurrentBird()
-                        sf::Vector2f pull = dragStart_ - dragCurrentInGameView;
-                        // 对于黄鸟，只在AI模式下允许2倍拉弓距离（手动模式下使用正常距离）
-                        float maxPullDist = config::kMaxPullDistance;
-                        if (draggingBird_->type() == BirdType::Yellow && aiModeEnabled_) {
-                            maxPullDist = config::kMaxPullDistance * 2.0f;
-                        }
-                        pull = clampVec(pull, maxPullDist);
-                        // 修正：pull向量指向从拖拽点回到弹弓的方向（向后拉的方向）
-                        // 初速度应该指向发射方向（向前，与pull相反），所以应该是pull方向，而不是-pull
-                        sf::Vector2f v0 = pull * config::kSlingshotStiffness;
-                        
-                        // Clamp preview speed based on bird type (same as Bird::launch())
-                        float speedSq = v0.x * v0.x + v0.y * v0.y;
-                        float speed = std::sqrt(speedSq);
-                        
-                        // Get bird-specific initial max speed
-                        float initialMaxSpeed = config::kMaxBodySpeed;
-                        BirdType birdType = draggingBird_->type();
-                        switch (birdType) {
-                            case BirdType::Red:
-                                initialMaxSpeed = config::bird_speed::kRedInitialMax;
-                                break;
-                            case BirdType::Yellow:
-                                initialMaxSpeed = config::bird_speed::kYellowInitialMax;
-                                break;
-                            case BirdType::Bomb:
-                                initialMaxSpeed = config::bird_speed::kBombInitialMax;
-                                break;
-                        }
-                        
-                        // Clamp to bird-specific initial max speed (same as Bird::launch())
-                        if (speed > initialMaxSpeed) {
-                            v0 = v0 * (initialMaxSpeed / speed);
-                        }
-                        
-                        // Simulate trajectory with physics (same as actual bird flight)
-                        // 包括重力和空气阻力，与实际物理模拟一致
-                        sf::Vector2f pos = birdBody->position();
-                        sf::Vector2f vel = v0;
-                        const int steps = 60;  // More steps for accuracy
-                        const float stepDt = 0.05f;
-                        for (int i = 0; i < steps; ++i) {
-                            vel.y += config::kGravity * stepDt;
-                            
-                            // 应用空气阻力（与实际物理模拟一致）
-                            // kAirResistanceAccel是m/s²，需要转换为像素/秒²
-                            float speed = std::sqrt(vel.x * vel.x + vel.y * vel.y);
-                            if (speed > 0.001f) {
-                                const float airResistanceAccelPixels = config::kAirResistanceAccel * config::kPixelsPerMeter;
-                                sf::Vector2f resistanceDir = sf::Vector2f(vel.x / speed, vel.y / speed);
-                                // 空气阻力方向必须与速度方向相反（阻力阻碍运动）
-                                sf::Vector2f resistanceAccel = -resistanceDir * airResistanceAccelPixels;
-                                vel += resistanceAccel * stepDt;
-                            }
-                            
-                            pos += vel * stepDt;
-                            if (pos.y > static_cast<float>(config::kWindowHeight) + 100.0f) break;
-                            previewPath_.emplace_back(pos, sf::Color(80, 80, 80, 200));
-                        }
+                    // 获取当前鼠标位置（使用游戏视图）
+                    sf::Vector2i pixelPos = sf::Mouse::getPosition(window_);
+                    // 使用游戏视图进行坐标转换
+                    sf::Vector2f dragCurrentInGameView = window_.mapPixelToCoords(pixelPos, gameView_);
+                    
+                    // Calculate pull and initial velocity exactly as in launchCurrentBird()
+                    sf::Vector2f pull = dragStart_ - dragCurrentInGameView;
+                    // 对于黄鸟，只在AI模式下允许2倍拉弓距离（手动模式下使用正常距离）
+                    float maxPullDist = config::kMaxPullDistance;
+                    if (draggingBird_->type() == BirdType::Yellow && aiModeEnabled_) {
+                        maxPullDist = config::kMaxPullDistance * 2.0f;
                     }
-                }
-            }
-
-            // IMPORTANT: Update order matters for explosion damage
-            // 1. First step physics (clears hitStrength from previous frame)
-            // 2. Update birds (may trigger explosions, setting hitStrength)
-            // 3. Update blocks and pigs (read hitStrength to apply damage)
-            physics_.step(config::kFixedDelta);
-            for (auto& b : birds_) b->update(dt);  // Birds update first (explosions set hitStrength)
-            for (auto& b : blocks_) b->update(dt);  // Blocks read hitStrength
-            for (auto& p : pigs_) p->update(dt);    // Pigs read hitStrength
-
-            for (auto it = blocks_.begin(); it != blocks_.end();) {
-                if ((*it)->isDestroyed()) {
-                    int pts = static_cast<int>((*it)->material().strength * 5);
-                    scoreSystem_.addPoints(pts);
-                    popups_.spawn((*it)->position(), pts);
-                    it = blocks_.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-
-            for (auto it = pigs_.begin(); it != pigs_.end();) {
-                if ((*it)->isDestroyed()) {
-                    int pts = 0;
-                    switch ((*it)->type()) {
-                        case PigType::Small: pts = 1000; break;
-                        case PigType::Medium: pts = 3000; break;
-                        case PigType::Large: pts = 5000; break;
+                    pull = clampVec(pull, maxPullDist);
+                    // 修正：pull向量指向从拖拽点回到弹弓的方向（向后拉的方向）
+                    // 初速度应该指向发射方向（向前，与pull相反），所以应该是pull方向，而不是-pull
+                    sf::Vector2f v0 = pull * config::kSlingshotStiffness;
+                    
+                    // Clamp preview speed based on bird type (same as Bird::launch())
+                    float speedSq = v0.x * v0.x + v0.y * v0.y;
+                    float speed = std::sqrt(speedSq);
+                    
+                    // Get bird-specific initial max speed
+                    float initialMaxSpeed = config::kMaxBodySpeed;
+                    BirdType birdType = draggingBird_->type();
+                    switch (birdType) {
+                        case BirdType::Red:
+                            initialMaxSpeed = config::bird_speed::kRedInitialMax;
+                            break;
+                        case BirdType::Yellow:
+                            initialMaxSpeed = config::bird_speed::kYellowInitialMax;
+                            break;
+                        case BirdType::Bomb:
+                            initialMaxSpeed = config::bird_speed::kBombInitialMax;
+                            break;
                     }
-                    scoreSystem_.addPoints(pts);
-                    popups_.spawn((*it)->position(), pts);
-                    it = pigs_.erase(it);
+                    
+                    // Clamp to bird-specific initial max speed (same as Bird::launch())
+                    if (speed > initialMaxSpeed) {
+                        v0 = v0 * (initialMaxSpeed / speed);
+                    }
+                    
+                    // 与 AI 共用同一飞行积分器（重力 + 空气阻力 + 速度上限）；
+                    // 拖拽量化后没有变化时不重新积分。飞行中的鸟按 Bird 的 maxSpeed_ 限速（黄鸟技能前后相同）
+                    playerPreview_.update(birdBody->position(), v0, birdFlightMaxSpeed(birdType, true));
                 } else {
-                    ++it;
+                    playerPreview_.clear();
                 }
             }
-            // Remove destroyed birds immediately
-            // Also remove birds that have been launched and are inactive (destroyed)
-            // Note: Next bird should already be at slingshot position (moved when previous bird was launched)
-            while (!birds_.empty() && birds_.front()->isDestroyed()) {
-                birds_.pop_front();
-                // When a bird is removed, next bird (now at front) should already be at slingshot
-                // But ensure it's properly positioned and ready
-                if (!birds_.empty()) {
-                    auto& nextBird = *birds_.front();
-                    if (auto* body = nextBird.body()) {
-                        // Ensure it's at slingshot position (should already be there)
-                        body->setPosition(slingshotPos_);
-                        body->setDynamic(false);  // Reset to static until launched
-                        body->setVelocity({0.0f, 0.0f});  // Clear any velocity
-                    }
-                    launchState_ = LaunchState::Ready;
+
+            if (pipelineActive()) {
+                // 流水线：模拟线程推进本帧并写入后台快照，主线程随后绘制前台快照（上一帧的画面）
+                // 输入状态（预览、拖拽线）在这里写入后台快照，与它的模拟结果一起在下一帧显示
+                if (snapshotStale_) {
+                    RenderSnapshot& front = snapshots_[frontSnapshot_];
+                    captureWorld(front);
+                    captureInput(front);
+                    snapshotStale_ = false;
                 }
-            }
-            
-            popups_.update(dt);
-            scoreSystem_.update(dt);
-
-            // Check win/lose conditions AFTER removing destroyed objects
-            // IMPORTANT: Check win first (pigs empty), then lose (birds empty)
-            // This ensures explosion that kills last pig triggers win, not lose
-            // KEY FIX: Check immediately after updating pigs to ensure victory is detected right away
-            bool won = pigs_.empty();
-            bool lost = birds_.empty() && !won;  // Only lose if no birds AND not won (to prioritize win)
-            
-            if (won) {
-                scoreSystem_.addBonusForRemainingBirds(static_cast<int>(birds_.size()));
-                int finalScore = scoreSystem_.score();
-                Logger::getInstance().info("关卡完成 - 关卡: " + std::to_string(levelIndex_) + 
-                                          ", 最终分数: " + std::to_string(finalScore) +
-                                          ", 剩余小鸟: " + std::to_string(birds_.size()));
-                scene_ = Scene::Score;
-                // Break immediately to prevent further updates
-                break;
-            } else if (lost) {
-                Logger::getInstance().info("游戏失败 - 关卡: " + std::to_string(levelIndex_));
-                scene_ = Scene::GameOver;
-                // Break immediately to prevent further updates
-                break;
+                RenderSnapshot& back = snapshots_[1 - frontSnapshot_];
+                captureInput(back);
+                simulationThread_.launch([this, dt, &back] {
+                    simulateFrame(dt);
+                    captureWorld(back);
+                });
+            } else {
+                simulateFrame(dt);
+                applyLevelOutcome();
             }
             break;
         }
@@ -635,6 +657,140 @@ void Game::update(float dt) {
     }
 }
 
+// 一帧的模拟阶段：串行模式下在 update 中执行，流水线模式下在模拟线程上执行
+// 只访问物理世界、实体、计分与飘字；胜负写入 levelOutcome_，不直接切换场景
+void Game::simulateFrame(float dt) {
+    // 物理固定步长推进：与显示帧率无关，高刷新率屏幕不会让物理变快
+    // 每帧追赶步数有上限，超出时丢弃积压时间（卡顿时游戏变慢而不是越追越卡）
+    physicsAccumulator_ += dt;
+    int physicsSteps = 0;
+    while (physicsAccumulator_ >= config::kFixedDelta && levelOutcome_ == Scene::Playing) {
+        if (physicsSteps >= config::kMaxPhysicsStepsPerFrame) {
+            physicsAccumulator_ = 0.0f;
+            break;
+        }
+        stepWorld(config::kFixedDelta);
+        physicsAccumulator_ -= config::kFixedDelta;
+        ++physicsSteps;
+    }
+
+    popups_.update(dt);
+    scoreSystem_.update(dt);
+}
+
+void Game::applyLevelOutcome() {
+    if (levelOutcome_ == Scene::Playing) return;
+    scene_ = levelOutcome_;
+    levelOutcome_ = Scene::Playing;
+}
+
+bool Game::pipelineActive() const {
+    // 碰撞框调试直接读取物理世界，只能串行绘制
+    return pipelineEnabled_ && !showDebugCollisionBoxes_;
+}
+
+void Game::syncSimulation() {
+    if (!simulationThread_.busy()) return;
+    float simulationMs;
+    {
+        ScopedTimer timer(ProfileZone::SimulationWait);
+        simulationMs = simulationThread_.wait();
+    }
+    Profiler::instance().add(ProfileZone::Simulation, simulationMs);
+    frontSnapshot_ = 1 - frontSnapshot_;
+    applyLevelOutcome();
+}
+
+// 固定步长的一步世界模拟：物理 -> 实体更新 -> 清理 -> 胜负判定（由 update 中的累加器调用）
+void Game::stepWorld(float dt) {
+    // 记录上一物理步的变换，供渲染插值使用
+    // 休眠实体退出唤醒集合时已把上一步变换对齐到当前变换，这里只需处理上一步更新过的实体
+    for (auto& b : birds_) b->savePreviousTransform();
+    for (Entity* e : awakeEntities_) e->savePreviousTransform();
+
+    // IMPORTANT: Update order matters for explosion damage
+    // 1. First step physics (clears hitStrength from previous frame)
+    // 2. Update birds (may trigger explosions, setting hitStrength)
+    // 3. EntityTable::tick resolves hitStrength/hp for all blocks and pigs in one pass
+    // 4. Update blocks and pigs (sprite/texture refresh only)
+    {
+        ScopedTimer timer(ProfileZone::Physics);
+        physics_.step(dt);
+    }
+    std::size_t destroyedCount = 0;
+    {
+        ScopedTimer timer(ProfileZone::EntityUpdate);
+        for (auto& b : birds_) b->update(dt);  // Birds update first (explosions set hitStrength)
+        destroyedCount = physics_.entities().tick(dt, physics_.time());
+        // 方块和猪只处理唤醒集合：未休眠、本步受击或仍在播放受伤效果的实体
+        // （两者只读写自己的状态，集合内按刚体创建顺序更新即可）
+        physics_.collectAwakeEntities(awakeEntities_);
+        for (Entity* e : awakeEntities_) e->update(dt);
+    }
+
+    {
+        ScopedTimer timer(ProfileZone::EntityErase);
+        // 本步没有方块/猪被销毁时跳过整表删除遍历
+        if (destroyedCount > 0) {
+            // 先从唤醒集合中移除即将销毁的实体，避免留下悬空指针
+            std::erase_if(awakeEntities_, [](const Entity* e) { return e->isDestroyed(); });
+            removeDestroyed(blocks_, [this](const Block& block) {
+                int pts = static_cast<int>(block.material().strength * 5);
+                scoreSystem_.addPoints(pts);
+                popups_.spawn(block.position(), pts);
+            });
+
+            removeDestroyed(pigs_, [this](const Pig& pig) {
+                int pts = 0;
+                switch (pig.type()) {
+                    case PigType::Small: pts = 1000; break;
+                    case PigType::Medium: pts = 3000; break;
+                    case PigType::Large: pts = 5000; break;
+                }
+                scoreSystem_.addPoints(pts);
+                popups_.spawn(pig.position(), pts);
+            });
+        }
+        // Remove destroyed birds immediately
+        // Also remove birds that have been launched and are inactive (destroyed)
+        // Note: Next bird should already be at slingshot position (moved when previous bird was launched)
+        while (!birds_.empty() && birds_.front()->isDestroyed()) {
+            birds_.pop_front();
+            // When a bird is removed, next bird (now at front) should already be at slingshot
+            // But ensure it's properly positioned and ready
+            if (!birds_.empty()) {
+                auto& nextBird = *birds_.front();
+                if (auto* body = nextBird.body()) {
+                    // Ensure it's at slingshot position (should already be there)
+                    body->setPosition(slingshotPos_);
+                    body->setDynamic(false);  // Reset to static until launched
+                    body->setVelocity({0.0f, 0.0f});  // Clear any velocity
+                }
+                launchState_ = LaunchState::Ready;
+            }
+        }
+    }
+    
+    // Check win/lose conditions AFTER removing destroyed objects
+    // IMPORTANT: Check win first (pigs empty), then lose (birds empty)
+    // This ensures explosion that kills last pig triggers win, not lose
+    // KEY FIX: Check immediately after updating pigs to ensure victory is detected right away
+    bool won = pigs_.empty();
+    bool lost = birds_.empty() && !won;  // Only lose if no birds AND not won (to prioritize win)
+    
+    if (won) {
+        scoreSystem_.addBonusForRemainingBirds(static_cast<int>(birds_.size()));
+        int finalScore = scoreSystem_.score();
+        Logger::getInstance().info("关卡完成 - 关卡: " + std::to_string(levelIndex_) + 
+                                  ", 最终分数: " + std::to_string(finalScore) +
+                                  ", 剩余小鸟: " + std::to_string(birds_.size()));
+        levelOutcome_ = Scene::Score;
+    } else if (lost) {
+        Logger::getInstance().info("游戏失败 - 关卡: " + std::to_string(levelIndex_));
+        levelOutcome_ = Scene::GameOver;
+    }
+}
+
 void Game::render() {
     // Draw background based on scene
     if (scene_ == Scene::Splash) {
@@ -694,13 +850,18 @@ void Game::render() {
             // 保存当前视图（原始视图）
             sf::View originalView = window_.getView();
             
+            // 流水线模式下模拟线程此时正在推进下一帧：这里只绘制快照，不访问实体、物理世界和计分状态
+            const RenderSnapshot& snapshot = prepareSnapshot();
+            
             // ========== 在原始视图下绘制UI元素（不受缩放影响） ==========
             // 先绘制UI元素，这样它们不会被缩放和平移影响
-            renderHUD();
+            renderHUD(snapshot.hud);
             for (const auto& btn : gameButtons_) {
                 btn->draw(window_);
             }
-            popups_.draw(window_);
+            for (const auto& text : snapshot.popups) {
+                window_.draw(text);
+            }
             
             // ========== 现在应用游戏视图（缩放和平移） ==========
             if (zoomAnimationActive_ || zoomAnimationTime_ > 0.0f) {
@@ -767,34 +928,24 @@ void Game::render() {
                 window_.draw(*slingshotSprite_);
             }
             
-            for (auto& b : blocks_) b->draw(window_);
-            for (auto& p : pigs_) p->draw(window_);
-            for (auto& b : birds_) b->draw(window_);
+            snapshot.drawWorld(window_);
 
             // Trajectory preview (player mode)
-            if (!previewPath_.empty() && !aiModeEnabled_) {
-                window_.draw(previewPath_.data(),
-                             previewPath_.size(),
+            if (!snapshot.playerPreview.empty()) {
+                window_.draw(snapshot.playerPreview.data(),
+                             snapshot.playerPreview.size(),
                              sf::PrimitiveType::LineStrip);
             }
             
             // AI trajectory preview
-            if (aiModeEnabled_ && aiController_) {
-                const auto& aiTrajectory = aiController_->getTrajectoryPreview();
-                if (!aiTrajectory.empty()) {
-                    window_.draw(aiTrajectory.data(),
-                                aiTrajectory.size(),
-                                sf::PrimitiveType::LineStrip);
-                }
+            if (!snapshot.aiPreview.empty()) {
+                window_.draw(snapshot.aiPreview.data(),
+                             snapshot.aiPreview.size(),
+                             sf::PrimitiveType::LineStrip);
             }
 
-            if (launchState_ == LaunchState::Dragging && !birds_.empty()) {
-                // 获取当前鼠标位置（使用游戏视图，与渲染时一致）
-                sf::Vector2i pixelPos = sf::Mouse::getPosition(window_);
-                dragCurrent_ = window_.mapPixelToCoords(pixelPos, gameView_);
-                sf::Vertex line[] = {sf::Vertex(dragStart_, sf::Color::Black),
-                                     sf::Vertex(dragCurrent_, sf::Color::Black)};
-                window_.draw(line, 2, sf::PrimitiveType::Lines);
+            if (snapshot.hasDragLine) {
+                window_.draw(snapshot.dragLine, 2, sf::PrimitiveType::Lines);
             }
             
             // Debug: Draw collision boxes if T key is pressed
@@ -807,7 +958,7 @@ void Game::render() {
             break;
         }
         case Scene::Score:
-            // Draw win background
+            // Draw win background（后台解码完成前只有清屏颜色）
             if (winBackgroundSprite_.has_value()) {
                 window_.draw(*winBackgroundSprite_);
             }
@@ -839,8 +990,10 @@ void Game::render() {
             // 保存当前视图（原始视图）
             sf::View originalView = window_.getView();
             
+            const RenderSnapshot& snapshot = prepareSnapshot();
+            
             // ========== 在原始视图下绘制UI元素（不受缩放影响） ==========
-            renderHUD();
+            renderHUD(snapshot.hud);
             
             // ========== 现在应用游戏视图（缩放和平移） ==========
             if (zoomAnimationActive_ || zoomAnimationTime_ > 0.0f) {
@@ -906,9 +1059,7 @@ void Game::render() {
                 window_.draw(*slingshotSprite_);
             }
             
-            for (auto& b : blocks_) b->draw(window_);
-            for (auto& p : pigs_) p->draw(window_);
-            for (auto& b : birds_) b->draw(window_);
+            snapshot.drawWorld(window_);
             
             // 恢复原始视图
             window_.setView(originalView);
@@ -922,7 +1073,67 @@ void Game::render() {
             }
             break;
     }
-    window_.display();
+    
+    // 性能分析叠加图（屏幕坐标，绘制在所有内容之上）
+    if (showProfiler_ && scene_ == Scene::Playing) {
+        sf::View previousView = window_.getView();
+        window_.setView(window_.getDefaultView());
+        Profiler::instance().drawOverlay(window_, font_, {10.0f, 60.0f});
+        window_.setView(previousView);
+    }
+    
+    {
+        ScopedTimer timer(ProfileZone::Present);
+        window_.display();
+    }
+}
+
+void Game::captureWorld(RenderSnapshot& snapshot) {
+    // 在最近两次物理状态之间插值，显示帧率高于物理频率时画面依然平滑
+    float alpha = std::clamp(physicsAccumulator_ / config::kFixedDelta, 0.0f, 1.0f);
+    // 休眠的方块和猪不在唤醒集合中，其精灵停在休眠位置，不需要逐帧改写
+    for (Entity* e : awakeEntities_) e->interpolateVisual(alpha);
+    for (auto& b : birds_) b->interpolateVisual(alpha);
+
+    // 保持原有绘制顺序：方块 -> 猪 -> 鸟；无法批量的实体在快照中与批次交错记录
+    snapshot.clearWorld();
+    for (auto& b : blocks_) b->appendToSnapshot(snapshot);
+    for (auto& p : pigs_) p->appendToSnapshot(snapshot);
+    for (auto& b : birds_) b->appendToSnapshot(snapshot);
+
+    snapshot.hud = {scoreSystem_.score(), scoreSystem_.highScore(), scoreSystem_.pulse(),
+                    birds_.size(), pigs_.size()};
+    popups_.appendTexts(snapshot.popups);
+}
+
+void Game::captureInput(RenderSnapshot& snapshot) {
+    snapshot.playerPreview.clear();
+    snapshot.aiPreview.clear();
+    if (!aiModeEnabled_) {
+        snapshot.playerPreview = playerPreview_.vertices();
+    } else if (aiController_) {
+        snapshot.aiPreview = aiController_->getTrajectoryPreview();
+    }
+
+    snapshot.hasDragLine = launchState_ == LaunchState::Dragging && !birds_.empty();
+    if (snapshot.hasDragLine) {
+        // 获取当前鼠标位置（使用游戏视图，与渲染时一致）
+        sf::Vector2i pixelPos = sf::Mouse::getPosition(window_);
+        dragCurrent_ = window_.mapPixelToCoords(pixelPos, gameView_);
+        snapshot.dragLine[0] = sf::Vertex(dragStart_, sf::Color::Black);
+        snapshot.dragLine[1] = sf::Vertex(dragCurrent_, sf::Color::Black);
+    }
+}
+
+const RenderSnapshot& Game::prepareSnapshot() {
+    RenderSnapshot& front = snapshots_[frontSnapshot_];
+    if (!simulationThread_.busy()) {
+        // 串行模式（或暂停等没有模拟任务的帧）：直接用当前状态生成
+        captureWorld(front);
+        captureInput(front);
+        snapshotStale_ = false;
+    }
+    return front;
 }
 
 void Game::renderMenu() {
@@ -945,15 +1156,15 @@ void Game::renderLevelSelect() {
     // Level select buttons are drawn in render() function
 }
 
-void Game::renderHUD() {
-    scoreSystem_.draw(window_, 20, 20);
-    sf::Text birdsText(font_, "Birds: " + std::to_string(birds_.size()), 20);
+void Game::renderHUD(const HudSnapshot& hud) {
+    scoreSystem_.draw(window_, 20, 20, hud.score, hud.highScore, hud.scorePulse);
+    sf::Text birdsText(font_, "Birds: " + std::to_string(hud.birds), 20);
     birdsText.setFillColor(sf::Color::Black);
     birdsText.setPosition({20.f, 50.f});
     window_.draw(birdsText);
     
     // Display pig count in top-left corner
-    sf::Text pigsText(font_, "count_pig: " + std::to_string(pigs_.size()), 20);
+    sf::Text pigsText(font_, "count_pig: " + std::to_string(hud.pigs), 20);
     pigsText.setFillColor(sf::Color::Black);
     pigsText.setPosition({20.f, 80.f});
     window_.draw(pigsText);
@@ -1158,15 +1369,19 @@ void Game::loadLevel(int index) {
     // Reset bird selection state when loading new level
     birdSelected_ = false;
     levelIndex_ = index;
+    awakeEntities_.clear();
     blocks_.clear();
     pigs_.clear();
     birds_.clear();
     gameTime_ = 0.0f;  // Reset game time
+    physicsAccumulator_ = 0.0f;
+    levelOutcome_ = Scene::Playing;
+    snapshotStale_ = true;  // 流水线模式下前台快照还是上一关的画面
     lastBirdLaunchTime_ = 0.0f;  // Reset launch timer
     launchState_ = LaunchState::Ready;  // Reset launch state
     nextBirdMovedToSlingshot_ = false;  // Reset next bird movement flag
     draggingBird_ = nullptr;  // Clear dragging bird reference
-    physics_ = PhysicsWorld({0.f, config::kGravity});  // Uses move assignment
+    physics_.reset({0.f, config::kGravity});  // 保留用户数据池与侧表容量，避免每次重试重新分配
 
     // Ground plane (static Box2D body) with very high friction to stop rolling
     // Extend ground to cover full game world (from x=-200 to x=1600)
@@ -1179,7 +1394,13 @@ void Game::loadLevel(int index) {
     physics_.createBoxBody(groundPos, groundSize, 0.0f, 2.0f, 0.1f, false, false, true, nullptr);
 
     try {
-        currentLevel_ = levelLoader_.load(config::levelPath(index));
+        // 优先使用后台预取的结果（已解析且带沉降后的变换），否则同步加载
+        if (auto prefetched = levelPrefetcher_.take(index)) {
+            currentLevel_ = std::move(*prefetched);
+            Logger::getInstance().info("使用预取关卡: " + std::to_string(index));
+        } else {
+            currentLevel_ = levelLoader_.load(config::levelPath(index));
+        }
     } catch (const std::exception& e) {
         Logger::getInstance().error("关卡加载失败: " + std::string(e.what()));
         std::cerr << e.what() << "\n";
@@ -1212,31 +1433,13 @@ void Game::loadLevel(int index) {
                                ", 小鸟数: " + std::to_string(birds_.size()));
 
     // Let the physics world settle to resolve any initial overlaps
-    // Box2D will automatically resolve overlaps during settle phase
-    // Use more iterations for better overlap resolution
-    // KEY FIX: Increased settle time and iterations to fix collision box overlaps
-    for (int i = 0; i < 600; ++i) {  // 10 seconds at 60 FPS - more time for better settling
-        physics_.step(config::kFixedDelta);
-        
-        // Additional check: ensure no overlaps persist
-        // This helps with "gray rectangles" (stone/stoneslab) overlapping issues
-        if (i % 60 == 0) {  // Check every second
-            // Force position updates to ensure collision boxes are correct
-            for (auto& block : blocks_) {
-                if (block->body() && block->body()->active()) {
-                    // Get current position and ensure it's correct
-                    sf::Vector2f pos = block->position();
-                    block->body()->setPosition(pos);  // Force update
-                }
-            }
-            for (auto& pig : pigs_) {
-                if (pig->body() && pig->body()->active()) {
-                    sf::Vector2f pos = pig->position();
-                    pig->body()->setPosition(pos);  // Force update
-                }
-            }
-        }
-    }
+    // 自适应沉降：刚体全部静止后提前结束；同一关卡再次加载（含重新开始）时直接使用沉降缓存
+    LevelSettle::settleOrLoadCache(config::levelPath(index), currentLevel_, physics_, blocks_, pigs_);
+    // 新建实体都请求过一次更新：第一步之前全部进入集合，沉降后的精灵在首帧即被同步
+    physics_.collectAwakeEntities(awakeEntities_);
+    // 重新开始与下一关同样走预取路径
+    levelPrefetcher_.request(index);
+    levelPrefetcher_.request(index + 1);
 
     scoreSystem_.resetRound();
     
@@ -1345,7 +1548,7 @@ void Game::initButtons() {
     float spacingX = 150.0f;
     float spacingY = 60.0f;
     
-    for (int i = 1; i <= 8; ++i) {
+    for (int i = 1; i <= config::kLevelSelectCount; ++i) {
         float x = startX + ((i - 1) % 4) * spacingX;
         float y = startYLevel + ((i - 1) / 4) * spacingY;
         
@@ -1472,38 +1675,7 @@ void Game::renderPauseMenu() {
 }
 
 void Game::initAudio() {
-    // Load music files
-    if (!titleTheme_.openFromFile("music/title_theme.mp3")) {
-        std::cerr << "警告: 无法加载音乐文件 music/title_theme.mp3\n";
-    }
-    if (!gameComplete_.openFromFile("music/game_complete.mp3")) {
-        std::cerr << "警告: 无法加载音乐文件 music/game_complete.mp3\n";
-    }
-    if (!birdsOutro_.openFromFile("music/birds_outro.mp3")) {
-        std::cerr << "警告: 无法加载音乐文件 music/birds_outro.mp3\n";
-    }
-    
-    // Load bird select sound buffers
-    if (!birdSelectBuffers_[0].loadFromFile("music/bird 01 select.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 01 select.wav\n";
-    }
-    if (!birdSelectBuffers_[1].loadFromFile("music/bird 02 select.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 02 select.wav\n";
-    }
-    if (!birdSelectBuffers_[2].loadFromFile("music/bird 03 select.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 03 select.wav\n";
-    }
-    
-    // Load bird flying sound buffers
-    if (!birdFlyingBuffers_[0].loadFromFile("music/bird 01 flying.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 01 flying.wav\n";
-    }
-    if (!birdFlyingBuffers_[1].loadFromFile("music/bird 02 flying.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 02 flying.wav\n";
-    }
-    if (!birdFlyingBuffers_[2].loadFromFile("music/bird 03 flying.wav")) {
-        std::cerr << "警告: 无法加载音效文件 music/bird 03 flying.wav\n";
-    }
+    // 音乐与音效缓冲区已由启动资源流水线在后台打开/解码（见 queueStartupAssets）
     
     // Set up sounds - initialize with first buffer if available
     if (birdSelectBuffers_[0].getSampleCount() > 0) {
@@ -1738,9 +1910,9 @@ void Game::updateMenuAnimation(float dt) {
         // 选择贴图
         const sf::Texture* tex = nullptr;
         switch (birdTypeDist(rng)) {
-            case 0: tex = splashBirdRedTexture_.getSize().x ? &splashBirdRedTexture_ : nullptr; break;
-            case 1: tex = splashBirdYellowTexture_.getSize().x ? &splashBirdYellowTexture_ : nullptr; break;
-            case 2: tex = splashBirdBlackTexture_.getSize().x ? &splashBirdBlackTexture_ : nullptr; break;
+            case 0: tex = splashBirdRedTexture_; break;
+            case 1: tex = splashBirdYellowTexture_; break;
+            case 2: tex = splashBirdBlackTexture_; break;
         }
 
         if (!tex) {
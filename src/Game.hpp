@@ -7,12 +7,18 @@
 #include <memory>
 #include <string>
 
+#include "AssetPipeline.hpp"
 #include "Button.hpp"
 #include "Config.hpp"
 #include "Entity.hpp"
 #include "Level.hpp"
+#include "LevelPrefetch.hpp"
 #include "Physics.hpp"
+#include "RenderSnapshot.hpp"
 #include "ScoreSystem.hpp"
+#include "SimulationThread.hpp"
+#include "SpriteBatch.hpp"
+#include "TrajectoryPreview.hpp"
 #include "Logger.hpp"
 
 // Forward declarations
@@ -49,12 +55,22 @@ public:
 private:
     void processEvents();
     void update(float dt);
+    void stepWorld(float dt);  // 固定步长推进一次物理与实体
+    void simulateFrame(float dt);  // 一帧的模拟阶段：按累加器推进若干固定步长 + 飘字/计分动画
+    void applyLevelOutcome();      // 把 stepWorld 判定的胜负切换到 scene_（流水线模式下在汇合后执行）
     void render();
 
+    // 模拟/渲染流水线（见 SimulationThread.hpp、RenderSnapshot.hpp）
+    bool pipelineActive() const;
+    void syncSimulation();  // 等待模拟任务完成并交换前后台快照；每帧处理输入前调用
+    void captureWorld(RenderSnapshot& snapshot);  // 模拟阶段：实体插值 + 顶点/精灵、HUD 数值、飘字
+    void captureInput(RenderSnapshot& snapshot);  // 主线程：轨迹预览与拖拽线
+    const RenderSnapshot& prepareSnapshot();  // 串行模式下现场生成本帧快照；返回要绘制的前台快照
+
     // Scene handlers
     void renderMenu();
     void renderLevelSelect();
-    void renderHUD();
+    void renderHUD(const HudSnapshot& hud);
     void renderScoreScreen();
     void renderPauseMenu();
     void renderDebugCollisionBoxes();  // Debug: draw collision boxes
@@ -63,6 +79,10 @@ private:
     void updateMenuAnimation(float dt);
     void renderMenuAnimation();
 
+    // 启动资源：构造时排队后台解码，开屏期间逐帧上传，全部就绪后 finishStartup 完成剩余初始化
+    void queueStartupAssets();
+    void finishStartup();
+
     void loadLevel(int index);
     void resetCurrent();
     void launchCurrentBird();
@@ -80,22 +100,30 @@ private:
     std::optional<sf::Sprite> slingshotSprite_;  // Slingshot sprite (optional because SFML 3.0 requires texture for construction)
     
     // Splash 场景用的小鸟贴图（只用于视觉，不参与物理/声音）
-    sf::Texture splashBirdRedTexture_;
-    sf::Texture splashBirdYellowTexture_;
-    sf::Texture splashBirdBlackTexture_;
+    const sf::Texture* splashBirdRedTexture_{nullptr};     // 与Bird实体共享（TextureCache）
+    const sf::Texture* splashBirdYellowTexture_{nullptr};
+    const sf::Texture* splashBirdBlackTexture_{nullptr};
     
     // 主界面动画用的地面和草贴图（无限拼接）
     sf::Texture groundTexture_;   // 地面贴图
     sf::Texture grassTexture_;    // 草贴图
     sf::Texture skyTexture_;      // 天空贴图（主界面背景）
     sf::Texture logoTexture_;     // Logo贴图
+    TextureAtlas entityAtlas_;    // 实体贴图图集（方块材质、猪血量阶段、鸟）
+    // 渲染快照双缓冲：frontSnapshot_ 为正在绘制的一份，模拟线程写另一份
+    RenderSnapshot snapshots_[2]{RenderSnapshot(entityAtlas_), RenderSnapshot(entityAtlas_)};
+    int frontSnapshot_{0};
+    bool snapshotStale_{true};  // 载入关卡后前台快照还是旧关卡的画面
     std::optional<sf::Sprite> logoSprite_;  // Logo精灵
 
     Scene scene_{Scene::Splash};
     float splashTimer_{3.0f};  // 开屏动画时长（秒），后续可调
     float gameTime_{0.0f};  // Total game time for bird launch cooldown
+    float physicsAccumulator_{0.0f};  // 尚未推进的物理时间（固定步长累加器）
+    Scene levelOutcome_{Scene::Playing};  // stepWorld 判定的胜负（Score / GameOver），由 applyLevelOutcome 生效
 
     LevelLoader levelLoader_;
+    LevelPrefetcher levelPrefetcher_;  // 选关界面后台预取（解析 + 沉降）
     LevelData currentLevel_;
     int levelIndex_{1};
 
@@ -103,6 +131,7 @@ private:
     std::vector<std::unique_ptr<Block>> blocks_;
     std::vector<std::unique_ptr<Pig>> pigs_;
     std::deque<std::unique_ptr<Bird>> birds_;
+    std::vector<Entity*> awakeEntities_;  // 最近一步更新过的方块/猪（唤醒集合，见 PhysicsWorld::collectAwakeEntities）
 
     ScoreSystem scoreSystem_;
     ScorePopups popups_;
@@ -129,7 +158,7 @@ private:
     bool prevSpaceDown_{false};
 
     // Trajectory preview
-    std::vector<sf::Vertex> previewPath_;
+    TrajectoryPreview playerPreview_;  // 玩家拖拽轨迹预览（默认样式：60步 x 0.05秒，灰色）
 
     // 主界面动画状态（无限滚动地面和草 + 纯视觉小鸟）
     float menuGroundOffset_{0.0f};          // 地面水平偏移
@@ -160,6 +189,8 @@ private:
     bool escPressed_{false};
     bool prevEscPressed_{false};
     bool showDebugCollisionBoxes_{false};  // Toggle collision box debug display
+    bool showProfiler_{false};  // P 键切换逐帧性能分析叠加图
+    bool pipelineEnabled_{config::kPipelinedSimulation};  // F3 键切换模拟/渲染流水线
     
     // Helper methods for cleaner code
     bool canLaunchBird() const;
@@ -201,5 +232,15 @@ private:
     void calculateAndStartZoomAnimation();  // 计算并启动缩放动画
     void updateZoomAnimation(float dt);     // 更新缩放动画
     float easeInOutCubic(float t);          // 缓动函数（慢->快->慢）
+    
+    // 启动资源流水线：放在资源成员之后声明，析构时先等待后台解码结束（解码写入的是上面的贴图/音频成员）
+    AssetPipeline startupAssets_;
+    AssetPipeline deferredAssets_;  // 开屏结束后才开始解码的资源（胜利界面背景），见 finishStartup
+    sf::Clock startupClock_;  // 启动耗时统计（首帧、资源全部就绪）
+    bool startupDone_{false};
+    bool firstFrameLogged_{false};
+
+    // 模拟线程：最后声明、最先析构，确保任务结束后才销毁它访问的实体与物理世界
+    SimulationThread simulationThread_;
 };
 
@@ -1,10 +1,14 @@
 // Parse level JSON into runtime structures.
 #include "Level.hpp"
 
+#include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 
+#include "LevelBinary.hpp"
+#include "Logger.hpp"
+
 namespace {
 BirdType birdFromString(const std::string& s) {
     if (s == "yellow") return BirdType::Yellow;
@@ -20,6 +24,23 @@ PigType pigFromString(const std::string& s) {
 }  // namespace
 
 LevelData LevelLoader::load(const std::string& path) {
+    LevelData data;
+    if (LevelBinary::isBinaryPath(path)) {
+        if (!LevelBinary::load(path, data)) {
+            throw std::runtime_error("无法读取二进制关卡: " + path);
+        }
+        return data;
+    }
+
+    const std::string binaryPath = LevelBinary::binaryPath(path);
+    if (LevelBinary::isUpToDate(binaryPath, path)) {
+        if (LevelBinary::load(binaryPath, data)) return data;
+        Logger::getInstance().warning("二进制关卡无效，改用JSON: " + binaryPath);
+    }
+    return loadJson(path);
+}
+
+LevelData LevelLoader::loadJson(const std::string& path) {
     std::ifstream in(path);
     if (!in.is_open()) {
         throw std::runtime_error("无法打开关卡文件: " + path);
@@ -1,4 +1,4 @@
-// Level loading and management from JSON files.
+// Level loading and management from JSON files (or their compact binary form, see LevelBinary.hpp).
 #pragma once
 
 #include <SFML/Graphics.hpp>
@@ -26,6 +26,12 @@ struct BirdSpec {
     sf::Vector2f position;
 };
 
+// 预先沉降好的刚体变换（只有二进制关卡可能携带，见 LevelBinary.hpp）
+struct SettledTransform {
+    sf::Vector2f position;  // 刚体中心（像素）
+    float angle{0.0f};      // 弧度
+};
+
 struct LevelData {
     int id{1};
     int targetScore{10000};
@@ -33,11 +39,18 @@ struct LevelData {
     std::vector<BlockSpec> blocks;
     std::vector<PigSpec> pigs;
     std::vector<BirdSpec> birds;
+    // 为空表示没有预沉降数据；非空时数量与 blocks/pigs 一一对应
+    std::vector<SettledTransform> settledBlocks;
+    std::vector<SettledTransform> settledPigs;
 };
 
 class LevelLoader {
 public:
+    // 加载关卡：path 为 .lvb 时直接读取二进制；为 JSON 时若同名 .lvb 存在且不比 JSON 旧，
+    // 优先读取二进制（读取失败自动回退 JSON）
     LevelData load(const std::string& path);
+    // 只解析 JSON（关卡转换工具使用）
+    LevelData loadJson(const std::string& path);
 };
 
 
@@ -0,0 +1,217 @@
+// 二进制关卡格式读写
+#include "LevelBinary.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Material.hpp"
+
+namespace {
+static_assert(sizeof(LevelBinary::Header) == 40, "Header layout changed");
+static_assert(sizeof(LevelBinary::PackedBlock) == 20, "PackedBlock layout changed");
+static_assert(sizeof(LevelBinary::PackedPig) == 12, "PackedPig layout changed");
+static_assert(sizeof(LevelBinary::PackedBird) == 12, "PackedBird layout changed");
+static_assert(sizeof(LevelBinary::PackedTransform) == 12, "PackedTransform layout changed");
+
+const std::string kBinaryExtension = ".lvb";
+
+PigType pigFromCode(std::uint32_t code) {
+    switch (code) {
+        case 1: return PigType::Medium;
+        case 2: return PigType::Large;
+        default: return PigType::Small;
+    }
+}
+
+std::uint32_t pigToCode(PigType type) {
+    switch (type) {
+        case PigType::Medium: return 1;
+        case PigType::Large: return 2;
+        default: return 0;
+    }
+}
+
+BirdType birdFromCode(std::uint32_t code) {
+    switch (code) {
+        case 1: return BirdType::Yellow;
+        case 2: return BirdType::Bomb;
+        default: return BirdType::Red;
+    }
+}
+
+std::uint32_t birdToCode(BirdType type) {
+    switch (type) {
+        case BirdType::Yellow: return 1;
+        case BirdType::Bomb: return 2;
+        default: return 0;
+    }
+}
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+template <typename T>
+void writeRecords(std::ofstream& out, const T* records, std::size_t count) {
+    out.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(sizeof(T) * count));
+}
+}  // namespace
+
+namespace LevelBinary {
+
+bool parse(const unsigned char* data, std::size_t size, View& out) {
+    if (!data || size < sizeof(Header)) return false;
+    const auto* header = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        return false;
+    }
+
+    const std::size_t blocks = header->blockCount;
+    const std::size_t pigs = header->pigCount;
+    const std::size_t birds = header->birdCount;
+    std::size_t expected = sizeof(Header) + blocks * sizeof(PackedBlock) +
+                           pigs * sizeof(PackedPig) + birds * sizeof(PackedBird);
+    const bool hasSettled = (header->flags & kHasSettledTransforms) != 0;
+    if (hasSettled) expected += (blocks + pigs) * sizeof(PackedTransform);
+    if (size < expected) return false;
+
+    const unsigned char* cursor = data + sizeof(Header);
+    out.header = header;
+    out.blocks = reinterpret_cast<const PackedBlock*>(cursor);
+    cursor += blocks * sizeof(PackedBlock);
+    out.pigs = reinterpret_cast<const PackedPig*>(cursor);
+    cursor += pigs * sizeof(PackedPig);
+    out.birds = reinterpret_cast<const PackedBird*>(cursor);
+    cursor += birds * sizeof(PackedBird);
+    out.settled = hasSettled ? reinterpret_cast<const PackedTransform*>(cursor) : nullptr;
+    return true;
+}
+
+bool load(const std::string& path, LevelData& out) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+
+    View view;
+    if (!parse(file.data(), file.size(), view)) return false;
+
+    const Header& h = *view.header;
+    LevelData data;
+    data.id = h.id;
+    data.targetScore = h.targetScore;
+    data.slingshot = {h.slingshotX, h.slingshotY};
+
+    data.blocks.resize(h.blockCount);
+    for (std::size_t i = 0; i < h.blockCount; ++i) {
+        const PackedBlock& b = view.blocks[i];
+        data.blocks[i].material = materialNameFromId(b.material);
+        data.blocks[i].position = {b.x, b.y};
+        data.blocks[i].size = {b.width, b.height};
+    }
+    data.pigs.resize(h.pigCount);
+    for (std::size_t i = 0; i < h.pigCount; ++i) {
+        data.pigs[i].type = pigFromCode(view.pigs[i].type);
+        data.pigs[i].position = {view.pigs[i].x, view.pigs[i].y};
+    }
+    data.birds.resize(h.birdCount);
+    for (std::size_t i = 0; i < h.birdCount; ++i) {
+        data.birds[i].type = birdFromCode(view.birds[i].type);
+        data.birds[i].position = {view.birds[i].x, view.birds[i].y};
+    }
+
+    if (view.settled) {
+        auto toTransform = [](const PackedTransform& t) { return SettledTransform{{t.x, t.y}, t.angle}; };
+        data.settledBlocks.reserve(h.blockCount);
+        data.settledPigs.reserve(h.pigCount);
+        for (std::size_t i = 0; i < h.blockCount; ++i) {
+            data.settledBlocks.push_back(toTransform(view.settled[i]));
+        }
+        for (std::size_t i = 0; i < h.pigCount; ++i) {
+            data.settledPigs.push_back(toTransform(view.settled[h.blockCount + i]));
+        }
+    }
+
+    out = std::move(data);
+    return true;
+}
+
+bool write(const std::string& path, const LevelData& level) {
+    const bool hasSettled = !level.settledBlocks.empty() || !level.settledPigs.empty();
+    if (hasSettled && (level.settledBlocks.size() != level.blocks.size() ||
+                       level.settledPigs.size() != level.pigs.size())) {
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.flags = hasSettled ? kHasSettledTransforms : 0u;
+    header.id = level.id;
+    header.targetScore = level.targetScore;
+    header.slingshotX = level.slingshot.x;
+    header.slingshotY = level.slingshot.y;
+    header.blockCount = static_cast<std::uint32_t>(level.blocks.size());
+    header.pigCount = static_cast<std::uint32_t>(level.pigs.size());
+    header.birdCount = static_cast<std::uint32_t>(level.birds.size());
+
+    std::vector<PackedBlock> blocks;
+    blocks.reserve(level.blocks.size());
+    for (const auto& b : level.blocks) {
+        blocks.push_back({materialIdFromName(b.material), b.position.x, b.position.y, b.size.x, b.size.y});
+    }
+    std::vector<PackedPig> pigs;
+    pigs.reserve(level.pigs.size());
+    for (const auto& p : level.pigs) {
+        pigs.push_back({pigToCode(p.type), p.position.x, p.position.y});
+    }
+    std::vector<PackedBird> birds;
+    birds.reserve(level.birds.size());
+    for (const auto& b : level.birds) {
+        birds.push_back({birdToCode(b.type), b.position.x, b.position.y});
+    }
+    std::vector<PackedTransform> settled;
+    if (hasSettled) {
+        settled.reserve(level.settledBlocks.size() + level.settledPigs.size());
+        for (const auto& t : level.settledBlocks) settled.push_back({t.position.x, t.position.y, t.angle});
+        for (const auto& t : level.settledPigs) settled.push_back({t.position.x, t.position.y, t.angle});
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    writeRecords(out, &header, 1);
+    writeRecords(out, blocks.data(), blocks.size());
+    writeRecords(out, pigs.data(), pigs.size());
+    writeRecords(out, birds.data(), birds.size());
+    writeRecords(out, settled.data(), settled.size());
+    return static_cast<bool>(out);
+}
+
+std::string binaryPath(const std::string& jsonPath) {
+    std::string base = jsonPath;
+    const std::string ext = ".json";
+    if (endsWith(base, ext)) {
+        base.erase(base.size() - ext.size());
+    }
+    return base + kBinaryExtension;
+}
+
+bool isBinaryPath(const std::string& path) {
+    return endsWith(path, kBinaryExtension);
+}
+
+bool isUpToDate(const std::string& binaryPath, const std::string& jsonPath) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::exists(binaryPath, ec)) return false;
+    if (!fs::exists(jsonPath, ec)) return true;  // 只有二进制（生成关卡库）
+    auto binaryTime = fs::last_write_time(binaryPath, ec);
+    if (ec) return false;
+    auto jsonTime = fs::last_write_time(jsonPath, ec);
+    if (ec) return false;
+    return binaryTime >= jsonTime;
+}
+
+}  // namespace LevelBinary
@@ -0,0 +1,82 @@
+// 紧凑二进制关卡格式（.lvb）：批量模拟大量生成关卡时避免 JSON 解析开销
+//
+// 布局（小端，所有字段 4 字节，记录可直接在映射内存上读取）：
+//   Header
+//   PackedBlock[blockCount]
+//   PackedPig[pigCount]
+//   PackedBird[birdCount]
+//   PackedTransform[blockCount + pigCount]   仅当 flags & kHasSettledTransforms
+//
+// 方块位置与 JSON 相同为左上角；预沉降变换为刚体中心与角度（见 LevelSettle）
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Level.hpp"
+
+namespace LevelBinary {
+
+constexpr char kMagic[4] = {'A', 'B', 'L', 'V'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kHasSettledTransforms = 1u << 0;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::int32_t id;
+    std::int32_t targetScore;
+    float slingshotX;
+    float slingshotY;
+    std::uint32_t blockCount;
+    std::uint32_t pigCount;
+    std::uint32_t birdCount;
+};
+
+struct PackedBlock {
+    std::uint32_t material;  // materialIdFromName（Material.hpp）
+    float x, y, width, height;
+};
+
+struct PackedPig {
+    std::uint32_t type;  // 0 = Small, 1 = Medium, 2 = Large
+    float x, y;
+};
+
+struct PackedBird {
+    std::uint32_t type;  // 0 = Red, 1 = Yellow, 2 = Bomb
+    float x, y;
+};
+
+struct PackedTransform {
+    float x, y, angle;
+};
+
+// 指向映射内存内部的只读视图（不拷贝），在底层缓冲区释放前有效
+struct View {
+    const Header* header{nullptr};
+    const PackedBlock* blocks{nullptr};
+    const PackedPig* pigs{nullptr};
+    const PackedBird* birds{nullptr};
+    const PackedTransform* settled{nullptr};  // 没有预沉降数据时为 nullptr
+};
+
+// 校验魔数、版本与长度后建立视图；数据不完整时返回 false
+bool parse(const unsigned char* data, std::size_t size, View& out);
+
+// 映射并读取 .lvb 文件
+bool load(const std::string& path, LevelData& out);
+
+// 写出 .lvb（level.settledBlocks/settledPigs 数量与实体相符时一并写入）
+bool write(const std::string& path, const LevelData& level);
+
+// levels/level1.json -> levels/level1.lvb
+std::string binaryPath(const std::string& jsonPath);
+bool isBinaryPath(const std::string& path);
+
+// 二进制文件存在，且 JSON 不存在或不比二进制新
+bool isUpToDate(const std::string& binaryPath, const std::string& jsonPath);
+
+}  // namespace LevelBinary
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
@@ -11,6 +12,7 @@
 #include "Config.hpp"
 #include "Game.hpp"
 #include "Level.hpp"
+#include "Profiler.hpp"
 #include <nlohmann/json.hpp>
 
 // EditorEntity implementation
@@ -39,11 +41,30 @@ sf::Vector2f EditorEntity::size() const {
     return {};
 }
 
+Entity* EditorEntity::entity() const {
+    if (block) return block.get();
+    if (pig) return pig.get();
+    return bird.get();
+}
+
+EditorSpatialHash::Box EditorEntity::bounds() const {
+    sf::Vector2f pos = position();
+    sf::Vector2f half = size() * 0.5f;
+    if (half.x <= 0 || half.y <= 0) {
+        float radius = pig ? 20.0f : 15.0f;
+        half = {radius, radius};
+    }
+    return {pos - half, pos + half};
+}
+
 void EditorEntity::setPosition(const sf::Vector2f& pos) {
+    // SetTransform 不会唤醒休眠刚体；请求一次更新，让方块/猪的精灵在下一帧跟到新位置
     if (block && block->body()) {
         block->body()->setPosition(pos);
+        block->body()->setNeedsUpdate(true);
     } else if (pig && pig->body()) {
         pig->body()->setPosition(pos);
+        pig->body()->setNeedsUpdate(true);
     } else if (bird && bird->body()) {
         bird->body()->setPosition(pos);
     }
@@ -62,20 +83,13 @@ void EditorEntity::draw(sf::RenderWindow& window) const {
     
     // Draw selection highlight
     if (selected) {
-        sf::Vector2f pos = position();
+        drawOutline(window, sf::Color::Yellow, 3.0f);
+        
         sf::Vector2f sz = size();
         if (sz.x > 0 && sz.y > 0) {
-            // Block selection with resize handles
-            sf::RectangleShape outline(sz);
-            outline.setPosition(pos - sz * 0.5f);
-            outline.setFillColor(sf::Color::Transparent);
-            outline.setOutlineColor(sf::Color::Yellow);
-            outline.setOutlineThickness(3.0f);
-            window.draw(outline);
-            
             // Draw resize handle at bottom-right corner
             float handleSize = 8.0f;
-            sf::Vector2f handlePos = pos + sz * 0.5f;
+            sf::Vector2f handlePos = position() + sz * 0.5f;
             sf::CircleShape handle(handleSize);
             handle.setPosition(handlePos);
             handle.setOrigin(sf::Vector2f(handleSize, handleSize));
@@ -83,20 +97,34 @@ void EditorEntity::draw(sf::RenderWindow& window) const {
             handle.setOutlineColor(sf::Color::Blue);
             handle.setOutlineThickness(2.0f);
             window.draw(handle);
-        } else {
-            // Circle selection (pig/bird)
-            float radius = pig ? 20.0f : 15.0f;
-            sf::CircleShape outline(radius);
-            outline.setPosition(pos);
-            outline.setOrigin(sf::Vector2f(radius, radius));
-            outline.setFillColor(sf::Color::Transparent);
-            outline.setOutlineColor(sf::Color::Yellow);
-            outline.setOutlineThickness(3.0f);
-            window.draw(outline);
         }
     }
 }
 
+void EditorEntity::drawOutline(sf::RenderWindow& window, const sf::Color& color, float thickness) const {
+    sf::Vector2f pos = position();
+    sf::Vector2f sz = size();
+    if (sz.x > 0 && sz.y > 0) {
+        // Block outline
+        sf::RectangleShape outline(sz);
+        outline.setPosition(pos - sz * 0.5f);
+        outline.setFillColor(sf::Color::Transparent);
+        outline.setOutlineColor(color);
+        outline.setOutlineThickness(thickness);
+        window.draw(outline);
+    } else {
+        // Circle outline (pig/bird)
+        float radius = pig ? 20.0f : 15.0f;
+        sf::CircleShape outline(radius);
+        outline.setPosition(pos);
+        outline.setOrigin(sf::Vector2f(radius, radius));
+        outline.setFillColor(sf::Color::Transparent);
+        outline.setOutlineColor(color);
+        outline.setOutlineThickness(thickness);
+        window.draw(outline);
+    }
+}
+
 bool EditorEntity::contains(const sf::Vector2f& point) const {
     sf::Vector2f pos = position();
     sf::Vector2f sz = size();
@@ -270,14 +298,21 @@ void LevelEditor::initUI() {
 }
 
 void LevelEditor::update(float dt) {
+    ScopedTimer timer(ProfileZone::EditorUpdate);
+    
     // Update physics
     updatePhysics(dt);
-    
-    // Update entities
-    for (auto& entity : entities_) {
-        if (entity.block) entity.block->update(dt);
-        if (entity.pig) entity.pig->update(dt);
-        if (entity.bird) entity.bird->update(dt);
+    physics_.entities().tick(dt, physics_.time());  // 出生计时/闪烁/血量判定（与 Game::stepWorld 相同）
+    
+    // Update entities：只更新唤醒集合（与 Game 相同），并把移动过的实体刷新到空间索引
+    // 编辑器里的鸟是静态刚体，不会自己移动，只在被拖动时更新（见 moveEntity）
+    physics_.collectAwakeEntities(awakeEntities_);
+    for (Entity* entity : awakeEntities_) {
+        entity->update(dt);
+        auto it = entityIndex_.find(entity);
+        if (it != entityIndex_.end()) {
+            refreshSpatialEntry(it->second);
+        }
     }
     
     // Update UI
@@ -315,6 +350,25 @@ void LevelEditor::render() {
         entity.draw(window_);
     }
     
+    // Hover highlight（删除工具用红色提示将被删除的实体）
+    if (hoveredIndex_.has_value() && hoveredIndex_.value() < entities_.size() &&
+        !entities_[hoveredIndex_.value()].selected) {
+        sf::Color hoverColor = currentTool_ == EditorTool::Delete ? sf::Color::Red : sf::Color::White;
+        entities_[hoveredIndex_.value()].drawOutline(window_, hoverColor, 2.0f);
+    }
+    
+    // Rubber-band selection rectangle
+    if (isBandSelecting_) {
+        sf::Vector2f bandMin(std::min(bandStart_.x, bandEnd_.x), std::min(bandStart_.y, bandEnd_.y));
+        sf::Vector2f bandMax(std::max(bandStart_.x, bandEnd_.x), std::max(bandStart_.y, bandEnd_.y));
+        sf::RectangleShape band(bandMax - bandMin);
+        band.setPosition(bandMin);
+        band.setFillColor(sf::Color(80, 140, 255, 50));
+        band.setOutlineColor(sf::Color(40, 90, 220));
+        band.setOutlineThickness(1.0f);
+        window_.draw(band);
+    }
+    
     // Draw UI
     renderUI();
 }
@@ -396,7 +450,7 @@ void LevelEditor::renderToolbar() {
     }
     
     // Draw help text
-    std::string helpTextStr = "提示: ESC返回主菜单 | Ctrl+Z撤销 | Ctrl+Y重做 | Delete删除选中 | 拖拽右下角控制点缩放物块";
+    std::string helpTextStr = "提示: ESC返回主菜单 | Ctrl+Z撤销 | Ctrl+Y重做 | Delete删除选中 | 空白处拖动框选（Shift追加） | 拖拽右下角控制点缩放物块";
     sf::Text helpText(font_, sf::String::fromUtf8(helpTextStr.begin(), helpTextStr.end()), 14);
     helpText.setFillColor(sf::Color(100, 100, 100));
     helpText.setPosition({20.0f, config::kWindowHeight - 30.0f});
@@ -633,7 +687,7 @@ void LevelEditor::handleEvent(const sf::Event& event) {
                 }
                 // Return to main menu - handled by Game class via ESC key check
             } else if (keyEvent->code == sf::Keyboard::Key::Delete && selectedIndex_.has_value()) {
-                deleteEntity(selectedIndex_.value());
+                deleteSelected();
             } else if (keyEvent->code == sf::Keyboard::Key::Z && 
                       sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl)) {
                 // Ctrl+Z for undo
@@ -757,7 +811,9 @@ void LevelEditor::handleEvent(const sf::Event& event) {
                         float slingshotDist = std::sqrt((mousePos.x - slingshotPos_.x) * (mousePos.x - slingshotPos_.x) +
                                                        (mousePos.y - slingshotPos_.y) * (mousePos.y - slingshotPos_.y));
                         if (slingshotDist <= 15.0f) {
-                            // Start dragging slingshot
+                            // Start dragging slingshot（取消实体选择，拖动只作用于发射点）
+                            deselectAll();
+                            showPropertyPanel_ = false;
                             dragStartPos_ = mousePos;
                             dragStartEntityPos_ = slingshotPos_;
                             isDragging_ = true;
@@ -767,18 +823,31 @@ void LevelEditor::handleEvent(const sf::Event& event) {
                         EditorEntity* entity = getEntityAt(mousePos);
                         if (entity) {
                             size_t index = entity - &entities_[0];
-                            selectEntity(index);
                             
                             // Check if clicking on resize handle
                             if (entity->type == EditorEntityType::Block && entity->isResizeHandle(mousePos)) {
+                                selectEntity(index);
                                 startResize(mousePos);
+                            } else if (entity->selected && selection_.size() > 1) {
+                                // 按住多选中的任一实体：整组一起拖动
+                                selectedIndex_ = index;
+                                startDrag(mousePos);
                             } else {
+                                selectEntity(index);
                                 startDrag(mousePos);
                             }
-                            showPropertyPanel_ = true;  // Show property panel when selecting
+                            showPropertyPanel_ = selection_.size() == 1;  // Show property panel when selecting
                         } else {
-                            deselectAll();
-                            showPropertyPanel_ = false;
+                            // 空白处按下：开始框选
+                            bandAdditive_ = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift) ||
+                                            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RShift);
+                            if (!bandAdditive_) {
+                                deselectAll();
+                                showPropertyPanel_ = false;
+                            }
+                            isBandSelecting_ = true;
+                            bandStart_ = mousePos;
+                            bandEnd_ = mousePos;
                         }
                         break;
                     }
@@ -825,6 +894,9 @@ void LevelEditor::handleEvent(const sf::Event& event) {
             if (isResizing_) {
                 endResize();
             }
+            if (isBandSelecting_) {
+                endBand();
+            }
         }
     }
     
@@ -838,6 +910,18 @@ void LevelEditor::handleEvent(const sf::Event& event) {
             if (isResizing_) {
                 updateResize(mousePos);
             }
+            if (isBandSelecting_) {
+                updateBand(mousePos);
+            }
+            
+            // Hover：空间索引点选，开销与关卡规模无关
+            hoveredIndex_.reset();
+            if (!isDragging_ && !isResizing_ && !isBandSelecting_ &&
+                (currentTool_ == EditorTool::Select || currentTool_ == EditorTool::Delete)) {
+                if (EditorEntity* hovered = getEntityAt(mousePos)) {
+                    hoveredIndex_ = static_cast<size_t>(hovered - &entities_[0]);
+                }
+            }
         }
     }
 }
@@ -852,90 +936,104 @@ void LevelEditor::addBlock(EditorMaterial material, const sf::Vector2f& pos, con
         case EditorMaterial::Woodboard: materialName = "woodboard"; break;
     }
     
-    Material mat = getMaterialOrDefault(materialName);
-    EditorEntity entity;
-    entity.type = EditorEntityType::Block;
-    entity.block = std::make_unique<Block>(mat, pos, size, physics_);
-    // Mark as editor entity to disable damage
-    if (entity.block->body() && entity.block->body()->userData_) {
-        entity.block->body()->userData_->isEditorEntity = true;
-    }
-    entities_.push_back(std::move(entity));
+    entities_.push_back(makeEntity(EditorEntityType::Block, materialIdFromName(materialName), pos, size));
+    indexEntity(entities_.size() - 1);
     
-    // Push undo action
-    EditorAction action;
-    action.type = EditorAction::Add;
-    action.entityIndex = entities_.size() - 1;
-    pushAction(action);
+    // Push undo command（新建只需记录下标；撤销时再记下实体当前的状态供重做使用）
+    EditorCommand command;
+    command.kind = EditorCommand::Kind::Add;
+    command.entityIndex = static_cast<std::uint32_t>(entities_.size() - 1);
+    pushCommand(command);
 }
 
 void LevelEditor::addPig(PigType type, const sf::Vector2f& pos) {
-    EditorEntity entity;
-    entity.type = EditorEntityType::Pig;
-    entity.pig = std::make_unique<Pig>(type, pos, physics_);
-    // Mark as editor entity to disable damage
-    if (entity.pig->body() && entity.pig->body()->userData_) {
-        entity.pig->body()->userData_->isEditorEntity = true;
-    }
-    entities_.push_back(std::move(entity));
+    entities_.push_back(makeEntity(EditorEntityType::Pig, static_cast<std::uint32_t>(type), pos, {}));
+    indexEntity(entities_.size() - 1);
     
-    EditorAction action;
-    action.type = EditorAction::Add;
-    action.entityIndex = entities_.size() - 1;
-    pushAction(action);
+    EditorCommand command;
+    command.kind = EditorCommand::Kind::Add;
+    command.entityIndex = static_cast<std::uint32_t>(entities_.size() - 1);
+    pushCommand(command);
 }
 
 void LevelEditor::addBird(BirdType type, const sf::Vector2f& pos) {
+    entities_.push_back(makeEntity(EditorEntityType::Bird, static_cast<std::uint32_t>(type), pos, {}));
+    indexEntity(entities_.size() - 1);
+    
+    EditorCommand command;
+    command.kind = EditorCommand::Kind::Add;
+    command.entityIndex = static_cast<std::uint32_t>(entities_.size() - 1);
+    pushCommand(command);
+}
+
+EditorEntity LevelEditor::makeEntity(EditorEntityType type, std::uint32_t variant,
+                                     const sf::Vector2f& pos, const sf::Vector2f& size) {
     EditorEntity entity;
-    entity.type = EditorEntityType::Bird;
-    entity.bird = std::make_unique<Bird>(type, pos, physics_);
+    entity.type = type;
+    PhysicsBody* body = nullptr;
+    switch (type) {
+        case EditorEntityType::Block:
+            entity.block = std::make_unique<Block>(getMaterialOrDefault(materialNameFromId(variant)), pos, size, physics_);
+            body = entity.block->body();
+            break;
+        case EditorEntityType::Pig:
+            entity.pig = std::make_unique<Pig>(static_cast<PigType>(variant), pos, physics_);
+            body = entity.pig->body();
+            break;
+        case EditorEntityType::Bird:
+            entity.bird = std::make_unique<Bird>(static_cast<BirdType>(variant), pos, physics_);
+            body = entity.bird->body();
+            break;
+    }
     // Mark as editor entity to disable damage
-    if (entity.bird->body() && entity.bird->body()->userData_) {
-        entity.bird->body()->userData_->isEditorEntity = true;
+    if (body && body->userData_) {
+        body->userData_->isEditorEntity = true;
     }
-    entities_.push_back(std::move(entity));
-    
-    EditorAction action;
-    action.type = EditorAction::Add;
-    action.entityIndex = entities_.size() - 1;
-    pushAction(action);
+    return entity;
 }
 
-void LevelEditor::deleteEntity(size_t index) {
-    if (index >= entities_.size()) return;
-    
-    // Store snapshot before deletion
-    EditorAction action;
-    action.type = EditorAction::Delete;
-    action.entityIndex = index;
-    
-    // Store entity data for undo
-    const EditorEntity& entity = entities_[index];
-    action.entityType = entity.type;
-    action.entityPos = entity.position();
-    action.entitySize = entity.size();
+void LevelEditor::recordEntity(EditorCommand& command, const EditorEntity& entity) const {
+    command.entityType = entity.type;
+    command.entityPos = entity.position();
+    command.entitySize = entity.size();
     if (entity.block) {
-        action.materialName = entity.block->material().name;
+        command.variant = materialIdFromName(entity.block->material().name);
     } else if (entity.pig) {
-        action.pigType = entity.pig->type();
+        command.variant = static_cast<std::uint32_t>(entity.pig->type());
     } else if (entity.bird) {
-        action.birdType = entity.bird->type();
+        command.variant = static_cast<std::uint32_t>(entity.bird->type());
     }
-    
-    // Destroy physics body before erasing entity
-    b2World* world = physics_.world();
-    if (world) {
-        if (entity.block && entity.block->body() && entity.block->body()->body_) {
-            world->DestroyBody(entity.block->body()->body_);
-        } else if (entity.pig && entity.pig->body() && entity.pig->body()->body_) {
-            world->DestroyBody(entity.pig->body()->body_);
-        } else if (entity.bird && entity.bird->body() && entity.bird->body()->body_) {
-            world->DestroyBody(entity.bird->body()->body_);
-        }
+}
+
+void LevelEditor::deleteEntity(size_t index) {
+    if (index >= entities_.size()) return;
+    eraseEntity(index);
+    rebuildSpatialIndex();
+}
+
+void LevelEditor::deleteSelected() {
+    // 从大到小删除，前面的下标不受影响；撤销时按相反顺序逐个插回原位
+    std::vector<size_t> indices = selection_;
+    std::sort(indices.begin(), indices.end(), std::greater<size_t>());
+    beginGroup();
+    for (size_t index : indices) {
+        eraseEntity(index);
     }
+    endGroup();
+    rebuildSpatialIndex();
+}
+
+void LevelEditor::eraseEntity(size_t index) {
+    if (index >= entities_.size()) return;
     
-    pushAction(action);
+    // Store entity data for undo
+    EditorCommand command;
+    command.kind = EditorCommand::Kind::Delete;
+    command.entityIndex = static_cast<std::uint32_t>(index);
+    recordEntity(command, entities_[index]);
+    pushCommand(command);
     
+    // 实体析构时会把刚体归还给 physics_，这里直接移除即可
     entities_.erase(entities_.begin() + index);
     if (selectedIndex_.has_value()) {
         if (selectedIndex_.value() == index) {
@@ -953,30 +1051,86 @@ void LevelEditor::selectEntity(size_t index) {
     deselectAll();
     selectedIndex_ = index;
     entities_[index].selected = true;
+    selection_.push_back(index);
 }
 
 void LevelEditor::deselectAll() {
-    for (auto& entity : entities_) {
-        entity.selected = false;
+    for (size_t index : selection_) {
+        if (index < entities_.size()) entities_[index].selected = false;
     }
+    selection_.clear();
     selectedIndex_.reset();
 }
 
+void LevelEditor::selectInRect(const sf::Vector2f& a, const sf::Vector2f& b, bool additive) {
+    if (!additive) deselectAll();
+    sf::Vector2f rectMin(std::min(a.x, b.x), std::min(a.y, b.y));
+    sf::Vector2f rectMax(std::max(a.x, b.x), std::max(a.y, b.y));
+    spatialHash_.queryRect(rectMin, rectMax, hitCandidates_);
+    for (size_t index : hitCandidates_) {
+        if (!entities_[index].selected) {
+            entities_[index].selected = true;
+            selection_.push_back(index);
+        }
+    }
+    // 主选中项取最上层（下标最大）的实体
+    if (!selection_.empty()) {
+        selectedIndex_ = *std::max_element(selection_.begin(), selection_.end());
+    }
+    showPropertyPanel_ = selection_.size() == 1;
+}
+
 EditorEntity* LevelEditor::getEntityAt(const sf::Vector2f& pos) {
-    // Check in reverse order (top entities first)
-    for (int i = static_cast<int>(entities_.size()) - 1; i >= 0; --i) {
-        if (entities_[i].contains(pos)) {
-            return &entities_[i];
+    // 空间索引给出包围盒包含该点的候选；按下标从大到小精确测试（top entities first）
+    spatialHash_.queryPoint(pos, hitCandidates_);
+    for (auto it = hitCandidates_.rbegin(); it != hitCandidates_.rend(); ++it) {
+        if (entities_[*it].contains(pos)) {
+            return &entities_[*it];
         }
     }
     return nullptr;
 }
 
+void LevelEditor::rebuildSpatialIndex() {
+    spatialHash_.clear();
+    entityIndex_.clear();
+    selection_.clear();
+    hoveredIndex_.reset();
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        indexEntity(i);
+        if (entities_[i].selected) selection_.push_back(i);
+    }
+}
+
+void LevelEditor::indexEntity(size_t index) {
+    if (Entity* entity = entities_[index].entity()) {
+        entityIndex_[entity] = index;
+    }
+    refreshSpatialEntry(index);
+}
+
+void LevelEditor::refreshSpatialEntry(size_t index) {
+    spatialHash_.set(index, entities_[index].bounds());
+}
+
+void LevelEditor::moveEntity(size_t index, const sf::Vector2f& pos) {
+    if (index >= entities_.size()) return;
+    EditorEntity& entity = entities_[index];
+    entity.setPosition(pos);
+    // 静态的鸟不在唤醒集合里，直接同步精灵
+    if (entity.bird) entity.bird->update(0.0f);
+    refreshSpatialEntry(index);
+}
+
 void LevelEditor::startDrag(const sf::Vector2f& pos) {
     if (!selectedIndex_.has_value()) return;
     isDragging_ = true;
     dragStartPos_ = pos;
     dragStartEntityPos_ = entities_[selectedIndex_.value()].position();
+    dragGroup_.clear();
+    for (size_t index : selection_) {
+        dragGroup_.emplace_back(index, entities_[index].position());
+    }
 }
 
 void LevelEditor::updateDrag(const sf::Vector2f& pos) {
@@ -989,9 +1143,11 @@ void LevelEditor::updateDrag(const sf::Vector2f& pos) {
         return;
     }
     
-    // Dragging entity
+    // Dragging entities（单选时 dragGroup_ 只有主选中项）
     sf::Vector2f delta = pos - dragStartPos_;
-    entities_[selectedIndex_.value()].setPosition(dragStartEntityPos_ + delta);
+    for (const auto& [index, startPos] : dragGroup_) {
+        moveEntity(index, startPos + delta);
+    }
 }
 
 void LevelEditor::endDrag() {
@@ -1007,12 +1163,19 @@ void LevelEditor::endDrag() {
     // Entity was dragged
     isDragging_ = false;
     
-    EditorAction action;
-    action.type = EditorAction::Move;
-    action.entityIndex = selectedIndex_.value();
-    action.oldValue = dragStartEntityPos_;
-    action.newValue = entities_[selectedIndex_.value()].position();
-    pushAction(action);
+    // 多选拖拽的各条移动编为一组，一次撤销整组还原
+    bool grouped = dragGroup_.size() > 1;
+    if (grouped) beginGroup();
+    for (const auto& [index, startPos] : dragGroup_) {
+        EditorCommand command;
+        command.kind = EditorCommand::Kind::Move;
+        command.entityIndex = static_cast<std::uint32_t>(index);
+        command.oldValue = startPos;
+        command.newValue = entities_[index].position();
+        pushCommand(command);
+    }
+    if (grouped) endGroup();
+    dragGroup_.clear();
 }
 
 void LevelEditor::startResize(const sf::Vector2f& pos) {
@@ -1050,17 +1213,31 @@ void LevelEditor::endResize() {
     EditorEntity& entity = entities_[selectedIndex_.value()];
     sf::Vector2f finalSize = entity.size();
     
-    // Push resize action for undo/redo
-    EditorAction action;
-    action.type = EditorAction::Resize;
-    action.entityIndex = selectedIndex_.value();
-    action.oldValue = resizeStartSize_;
-    action.newValue = finalSize;
-    pushAction(action);
+    // Push resize command for undo/redo
+    EditorCommand command;
+    command.kind = EditorCommand::Kind::Resize;
+    command.entityIndex = static_cast<std::uint32_t>(selectedIndex_.value());
+    command.oldValue = resizeStartSize_;
+    command.newValue = finalSize;
+    pushCommand(command);
     
     isResizing_ = false;
 }
 
+void LevelEditor::updateBand(const sf::Vector2f& pos) {
+    bandEnd_ = pos;
+}
+
+void LevelEditor::endBand() {
+    isBandSelecting_ = false;
+    // 几乎没有拖动视为单击空白处（已在按下时取消选择）
+    const float minBandSize = 3.0f;
+    if (std::abs(bandEnd_.x - bandStart_.x) < minBandSize && std::abs(bandEnd_.y - bandStart_.y) < minBandSize) {
+        return;
+    }
+    selectInRect(bandStart_, bandEnd_, bandAdditive_);
+}
+
 void LevelEditor::resizeEntity(size_t index, const sf::Vector2f& newSize) {
     if (index >= entities_.size()) return;
     EditorEntity& entity = entities_[index];
@@ -1070,15 +1247,8 @@ void LevelEditor::resizeEntity(size_t index, const sf::Vector2f& newSize) {
     sf::Vector2f pos = entity.position();  // Get position from current body
     Material mat = entity.block->material();
     
-    // Destroy old physics body before creating new one
-    if (entity.block->body() && entity.block->body()->body_) {
-        b2World* world = entity.block->body()->body_->GetWorld();
-        if (world) {
-            world->DestroyBody(entity.block->body()->body_);
-        }
-    }
-    
-    // Clear the block pointer before creating new one (ensures old body is fully destroyed)
+    // Clear the block pointer before creating new one (destructor releases the old physics body)
+    entityIndex_.erase(entity.block.get());
     entity.block.reset();
     
     // Create new block with new size - this will create a new physics body
@@ -1087,186 +1257,128 @@ void LevelEditor::resizeEntity(size_t index, const sf::Vector2f& newSize) {
     if (entity.block->body() && entity.block->body()->userData_) {
         entity.block->body()->userData_->isEditorEntity = true;
     }
+    indexEntity(index);
 }
 
-void LevelEditor::pushAction(const EditorAction& action) {
-    undoStack_.push_back(action);
-    if (undoStack_.size() > kMaxUndoHistory) {
-        undoStack_.pop_front();
-    }
+void LevelEditor::pushCommand(EditorCommand command) {
+    bool isDelta = command.kind == EditorCommand::Kind::Move || command.kind == EditorCommand::Kind::Resize;
+    // 没有改变任何值的移动/缩放（例如单击选中实体）不进入历史
+    if (isDelta && command.oldValue == command.newValue) return;
+    
     redoStack_.clear();
+    command.group = openGroup_;
+    bool withinWindow = lastCommandClock_.restart().asSeconds() < config::kEditorUndoCoalesceSeconds;
+    
+    // 合并：同一实体首尾相接的移动/缩放（连续的小幅拖动、逐个输入坐标）只保留一条命令
+    if (isDelta && coalesceOpen_ && withinWindow && command.group == 0 && !undoStack_.empty()) {
+        EditorCommand& top = undoStack_.back();
+        if (top.group == 0 && top.kind == command.kind && top.entityIndex == command.entityIndex &&
+            top.newValue == command.oldValue) {
+            top.newValue = command.newValue;
+            return;
+        }
+    }
+    coalesceOpen_ = true;
+    
+    undoStack_.push_back(command);
+    // 超出上限时从最早的命令开始丢弃，同组命令一起丢弃
+    while (undoStack_.size() > config::kEditorUndoHistoryLimit) {
+        std::uint32_t group = undoStack_.front().group;
+        do {
+            undoStack_.pop_front();
+        } while (group != 0 && !undoStack_.empty() && undoStack_.front().group == group);
+    }
 }
 
-void LevelEditor::undo() {
-    if (undoStack_.empty()) return;
-    
-    EditorAction action = undoStack_.back();
-    undoStack_.pop_back();
-    
-    // Apply undo based on action type
-    switch (action.type) {
-        case EditorAction::Add:
-            if (action.entityIndex < entities_.size()) {
-                // Store entity data for redo
-                const EditorEntity& entity = entities_[action.entityIndex];
-                action.entityType = entity.type;
-                action.entityPos = entity.position();
-                action.entitySize = entity.size();
-                if (entity.block) {
-                    action.materialName = entity.block->material().name;
-                } else if (entity.pig) {
-                    action.pigType = entity.pig->type();
-                } else if (entity.bird) {
-                    action.birdType = entity.bird->type();
-                }
-                
-                // Destroy physics body before erasing entity
-                b2World* world = physics_.world();
-                if (world) {
-                    if (entity.block && entity.block->body() && entity.block->body()->body_) {
-                        world->DestroyBody(entity.block->body()->body_);
-                    } else if (entity.pig && entity.pig->body() && entity.pig->body()->body_) {
-                        world->DestroyBody(entity.pig->body()->body_);
-                    } else if (entity.bird && entity.bird->body() && entity.bird->body()->body_) {
-                        world->DestroyBody(entity.bird->body()->body_);
-                    }
+void LevelEditor::beginGroup() {
+    openGroup_ = nextGroup_++;
+    if (nextGroup_ == 0) nextGroup_ = 1;  // 0 表示不分组
+}
+
+void LevelEditor::endGroup() {
+    openGroup_ = 0;
+}
+
+bool LevelEditor::applyCommand(EditorCommand& command, bool forward) {
+    const size_t index = command.entityIndex;
+    switch (command.kind) {
+        case EditorCommand::Kind::Add:
+        case EditorCommand::Kind::Delete: {
+            bool inserting = (command.kind == EditorCommand::Kind::Add) == forward;
+            if (inserting) {
+                // Re-add entity from stored data
+                if (index > entities_.size()) return false;
+                entities_.insert(entities_.begin() + index,
+                                 makeEntity(command.entityType, command.variant, command.entityPos, command.entitySize));
+                if (selectedIndex_.has_value() && selectedIndex_.value() >= index) {
+                    selectedIndex_ = selectedIndex_.value() + 1;
                 }
-                
-                entities_.erase(entities_.begin() + action.entityIndex);
-                if (selectedIndex_.has_value() && selectedIndex_.value() == action.entityIndex) {
+            } else {
+                if (index >= entities_.size()) return false;
+                // 记下实体当前的状态（物理可能移动过它），供反方向操作重建
+                recordEntity(command, entities_[index]);
+                // 实体析构时会把刚体归还给 physics_，这里直接移除即可
+                entities_.erase(entities_.begin() + index);
+                if (selectedIndex_.has_value() && selectedIndex_.value() == index) {
                     selectedIndex_.reset();
                     showPropertyPanel_ = false;
-                } else if (selectedIndex_.has_value() && selectedIndex_.value() > action.entityIndex) {
+                } else if (selectedIndex_.has_value() && selectedIndex_.value() > index) {
                     selectedIndex_ = selectedIndex_.value() - 1;
                 }
             }
-            redoStack_.push_back(action);
-            break;
-        case EditorAction::Delete:
-            // Re-add entity from stored data
-            if (action.entityIndex <= entities_.size()) {
-                EditorEntity restored;
-                restored.type = action.entityType;
-                if (action.entityType == EditorEntityType::Block) {
-                    Material mat = getMaterialOrDefault(action.materialName);
-                    restored.block = std::make_unique<Block>(mat, action.entityPos, action.entitySize, physics_);
-                } else if (action.entityType == EditorEntityType::Pig) {
-                    restored.pig = std::make_unique<Pig>(action.pigType, action.entityPos, physics_);
-                } else if (action.entityType == EditorEntityType::Bird) {
-                    restored.bird = std::make_unique<Bird>(action.birdType, action.entityPos, physics_);
-                }
-                entities_.insert(entities_.begin() + action.entityIndex, std::move(restored));
-            }
-            redoStack_.push_back(action);
-            break;
-        case EditorAction::Move:
-            if (action.entityIndex < entities_.size()) {
-                // Store new position for redo
-                sf::Vector2f currentPos = entities_[action.entityIndex].position();
-                action.newValue = currentPos;
-                entities_[action.entityIndex].setPosition(action.oldValue);
+            return true;
+        }
+        case EditorCommand::Kind::Move:
+            // 只移动刚体，不重建实体
+            if (index < entities_.size()) {
+                // 另一端记为当前位置（物理可能移动过它）
+                sf::Vector2f currentPos = entities_[index].position();
+                (forward ? command.oldValue : command.newValue) = currentPos;
+                moveEntity(index, forward ? command.newValue : command.oldValue);
             }
-            redoStack_.push_back(action);
-            break;
-        case EditorAction::Resize:
-            if (action.entityIndex < entities_.size()) {
-                // Store new size for redo
-                sf::Vector2f currentSize = entities_[action.entityIndex].size();
-                action.newValue = currentSize;
-                resizeEntity(action.entityIndex, action.oldValue);
+            return false;
+        case EditorCommand::Kind::Resize:
+            if (index < entities_.size()) {
+                sf::Vector2f currentSize = entities_[index].size();
+                (forward ? command.oldValue : command.newValue) = currentSize;
+                resizeEntity(index, forward ? command.newValue : command.oldValue);
             }
-            redoStack_.push_back(action);
-            break;
-        default:
-            redoStack_.push_back(action);
-            break;
+            return false;
     }
+    return false;
+}
+
+void LevelEditor::undo() {
+    if (undoStack_.empty()) return;
+    
+    // 同组命令按相反顺序一起撤销；增删实体后统一重建一次空间索引
+    bool structural = false;
+    const std::uint32_t group = undoStack_.back().group;
+    do {
+        EditorCommand command = undoStack_.back();
+        undoStack_.pop_back();
+        structural = applyCommand(command, false) || structural;
+        redoStack_.push_back(command);
+    } while (group != 0 && !undoStack_.empty() && undoStack_.back().group == group);
+    
+    if (structural) rebuildSpatialIndex();
+    coalesceOpen_ = false;
 }
 
 void LevelEditor::redo() {
     if (redoStack_.empty()) return;
     
-    EditorAction action = redoStack_.back();
-    redoStack_.pop_back();
-    
-    // Apply redo based on action type
-    switch (action.type) {
-        case EditorAction::Add:
-            // Re-add entity from stored data
-            if (action.entityIndex <= entities_.size()) {
-                EditorEntity restored;
-                restored.type = action.entityType;
-                if (action.entityType == EditorEntityType::Block) {
-                    Material mat = getMaterialOrDefault(action.materialName);
-                    restored.block = std::make_unique<Block>(mat, action.entityPos, action.entitySize, physics_);
-                } else if (action.entityType == EditorEntityType::Pig) {
-                    restored.pig = std::make_unique<Pig>(action.pigType, action.entityPos, physics_);
-                } else if (action.entityType == EditorEntityType::Bird) {
-                    restored.bird = std::make_unique<Bird>(action.birdType, action.entityPos, physics_);
-                }
-                entities_.insert(entities_.begin() + action.entityIndex, std::move(restored));
-            }
-            undoStack_.push_back(action);
-            break;
-        case EditorAction::Delete:
-            if (action.entityIndex < entities_.size()) {
-                // Store entity data for undo
-                const EditorEntity& entity = entities_[action.entityIndex];
-                action.entityType = entity.type;
-                action.entityPos = entity.position();
-                action.entitySize = entity.size();
-                if (entity.block) {
-                    action.materialName = entity.block->material().name;
-                } else if (entity.pig) {
-                    action.pigType = entity.pig->type();
-                } else if (entity.bird) {
-                    action.birdType = entity.bird->type();
-                }
-                
-                // Destroy physics body before erasing entity
-                b2World* world = physics_.world();
-                if (world) {
-                    if (entity.block && entity.block->body() && entity.block->body()->body_) {
-                        world->DestroyBody(entity.block->body()->body_);
-                    } else if (entity.pig && entity.pig->body() && entity.pig->body()->body_) {
-                        world->DestroyBody(entity.pig->body()->body_);
-                    } else if (entity.bird && entity.bird->body() && entity.bird->body()->body_) {
-                        world->DestroyBody(entity.bird->body()->body_);
-                    }
-                }
-                
-                entities_.erase(entities_.begin() + action.entityIndex);
-                if (selectedIndex_.has_value() && selectedIndex_.value() == action.entityIndex) {
-                    selectedIndex_.reset();
-                    showPropertyPanel_ = false;
-                } else if (selectedIndex_.has_value() && selectedIndex_.value() > action.entityIndex) {
-                    selectedIndex_ = selectedIndex_.value() - 1;
-                }
-            }
-            undoStack_.push_back(action);
-            break;
-        case EditorAction::Move:
-            if (action.entityIndex < entities_.size()) {
-                // Store old position for undo
-                sf::Vector2f currentPos = entities_[action.entityIndex].position();
-                action.oldValue = currentPos;
-                entities_[action.entityIndex].setPosition(action.newValue);
-            }
-            undoStack_.push_back(action);
-            break;
-        case EditorAction::Resize:
-            if (action.entityIndex < entities_.size()) {
-                // Store old size for undo
-                sf::Vector2f currentSize = entities_[action.entityIndex].size();
-                action.oldValue = currentSize;
-                resizeEntity(action.entityIndex, action.newValue);
-            }
-            undoStack_.push_back(action);
-            break;
-        default:
-            undoStack_.push_back(action);
-            break;
-    }
+    bool structural = false;
+    const std::uint32_t group = redoStack_.back().group;
+    do {
+        EditorCommand command = redoStack_.back();
+        redoStack_.pop_back();
+        structural = applyCommand(command, true) || structural;
+        undoStack_.push_back(command);
+    } while (group != 0 && !redoStack_.empty() && redoStack_.back().group == group);
+    
+    if (structural) rebuildSpatialIndex();
+    coalesceOpen_ = false;
 }
 
 void LevelEditor::updatePhysics(float dt) {
@@ -1312,27 +1424,27 @@ void LevelEditor::applyInputFieldChange() {
             case InputField::PosX: {
                 sf::Vector2f pos = entity.position();
                 pos.x = value;
-                entity.setPosition(pos);
-                // Push move action
-                EditorAction action;
-                action.type = EditorAction::Move;
-                action.entityIndex = selectedIndex_.value();
-                action.oldValue = inputStartValue_;
-                action.newValue = pos;
-                pushAction(action);
+                moveEntity(selectedIndex_.value(), pos);
+                // Push move command
+                EditorCommand command;
+                command.kind = EditorCommand::Kind::Move;
+                command.entityIndex = static_cast<std::uint32_t>(selectedIndex_.value());
+                command.oldValue = inputStartValue_;
+                command.newValue = pos;
+                pushCommand(command);
                 break;
             }
             case InputField::PosY: {
                 sf::Vector2f pos = entity.position();
                 pos.y = value;
-                entity.setPosition(pos);
-                // Push move action
-                EditorAction action;
-                action.type = EditorAction::Move;
-                action.entityIndex = selectedIndex_.value();
-                action.oldValue = inputStartValue_;
-                action.newValue = pos;
-                pushAction(action);
+                moveEntity(selectedIndex_.value(), pos);
+                // Push move command
+                EditorCommand command;
+                command.kind = EditorCommand::Kind::Move;
+                command.entityIndex = static_cast<std::uint32_t>(selectedIndex_.value());
+                command.oldValue = inputStartValue_;
+                command.newValue = pos;
+                pushCommand(command);
                 break;
             }
             case InputField::SizeX: {
@@ -1342,13 +1454,13 @@ void LevelEditor::applyInputFieldChange() {
                     const float minSize = 30.0f;
                     size.x = std::max(minSize, std::min(500.0f, value));
                     resizeEntity(selectedIndex_.value(), size);
-                    // Push resize action
-                    EditorAction action;
-                    action.type = EditorAction::Resize;
-                    action.entityIndex = selectedIndex_.value();
-                    action.oldValue = inputStartValue_;
-                    action.newValue = size;
-                    pushAction(action);
+                    // Push resize command
+                    EditorCommand command;
+                    command.kind = EditorCommand::Kind::Resize;
+                    command.entityIndex = static_cast<std::uint32_t>(selectedIndex_.value());
+                    command.oldValue = inputStartValue_;
+                    command.newValue = size;
+                    pushCommand(command);
                 }
                 break;
             }
@@ -1359,13 +1471,13 @@ void LevelEditor::applyInputFieldChange() {
                     const float minSize = 30.0f;
                     size.y = std::max(minSize, std::min(500.0f, value));
                     resizeEntity(selectedIndex_.value(), size);
-                    // Push resize action
-                    EditorAction action;
-                    action.type = EditorAction::Resize;
-                    action.entityIndex = selectedIndex_.value();
-                    action.oldValue = inputStartValue_;
-                    action.newValue = size;
-                    pushAction(action);
+                    // Push resize command
+                    EditorCommand command;
+                    command.kind = EditorCommand::Kind::Resize;
+                    command.entityIndex = static_cast<std::uint32_t>(selectedIndex_.value());
+                    command.oldValue = inputStartValue_;
+                    command.newValue = size;
+                    pushCommand(command);
                 }
                 break;
             }
@@ -1396,13 +1508,16 @@ bool LevelEditor::loadFromJSON(const std::string& path) {
         // Clear existing entities and physics world
         entities_.clear();
         selectedIndex_.reset();  // Clear selection
+        isBandSelecting_ = false;
+        rebuildSpatialIndex();
         showPropertyPanel_ = false;  // Hide property panel
         activeInputField_ = InputField::None;  // Clear input field
         inputText_.clear();
         undoStack_.clear();  // Clear undo/redo history
         redoStack_.clear();
-        // Recreate physics world to clear all bodies
-        physics_ = PhysicsWorld({0.f, config::kGravity});
+        coalesceOpen_ = false;
+        // Reset physics world to clear all bodies (keeps user data pool for reuse)
+        physics_.reset({0.f, config::kGravity});
         createPhysicsWorld();
         
         // Load slingshot position
@@ -1482,11 +1597,13 @@ bool LevelEditor::loadFromJSON(const std::string& path) {
             }
         }
         
+        rebuildSpatialIndex();
         currentLevelPath_ = path;
         std::cerr << "✓ 关卡加载成功: " << path << " (包含 " << entities_.size() << " 个实体)\n";
         return true;
     } catch (const std::exception& e) {
         std::cerr << "✗ 错误: 加载关卡失败: " << e.what() << "\n";
+        rebuildSpatialIndex();  // 已加载的部分实体仍需可点选
         return false;
     }
 }
@@ -2,13 +2,17 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <deque>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
 #include "Config.hpp"
+#include "EditorSpatialHash.hpp"
 #include "Entity.hpp"
 #include "Material.hpp"
 #include "Physics.hpp"
@@ -37,9 +41,13 @@ struct EditorEntity {
     
     sf::Vector2f position() const;
     sf::Vector2f size() const;  // For blocks only
+    Entity* entity() const;
+    // 点选用的轴对齐包围盒（与 contains 的判定范围一致：方块不计旋转，猪/鸟按选择圈半径）
+    EditorSpatialHash::Box bounds() const;
     void setPosition(const sf::Vector2f& pos);
     void setSize(const sf::Vector2f& s);  // For blocks only
     void draw(sf::RenderWindow& window) const;
+    void drawOutline(sf::RenderWindow& window, const sf::Color& color, float thickness) const;
     bool contains(const sf::Vector2f& point) const;
     bool isResizeHandle(const sf::Vector2f& point, float handleSize = 8.0f) const;
 };
@@ -62,19 +70,18 @@ enum class EditorMaterial {
     Woodboard
 };
 
-// Undo/Redo action
-struct EditorAction {
-    enum Type { Add, Delete, Move, Resize, Modify };
-    Type type;
-    size_t entityIndex;
-    // Store entity data instead of full entity (since EditorEntity is not copyable)
-    EditorEntityType entityType;
-    sf::Vector2f entityPos;
-    sf::Vector2f entitySize;
-    std::string materialName;  // For blocks
-    PigType pigType;  // For pigs
-    BirdType birdType;  // For birds
-    sf::Vector2f oldValue;
+// Undo/Redo command：只记录改动本身（增量），不保存实体对象或字符串
+// Add/Delete 只保存重建实体所需的最少数据；Move/Resize 只保存前后两个值
+struct EditorCommand {
+    enum class Kind : std::uint8_t { Add, Delete, Move, Resize };
+    Kind kind{Kind::Move};
+    EditorEntityType entityType{EditorEntityType::Block};
+    std::uint32_t variant{0};      // 方块：材质编号（materialIdFromName）；猪：PigType；鸟：BirdType
+    std::uint32_t entityIndex{0};
+    std::uint32_t group{0};        // 非 0：同组命令一起撤销/重做（多选拖拽、批量删除）
+    sf::Vector2f entityPos;        // Add/Delete：实体位置
+    sf::Vector2f entitySize;       // Add/Delete：方块尺寸
+    sf::Vector2f oldValue;         // Move：位置；Resize：尺寸
     sf::Vector2f newValue;
 };
 
@@ -102,11 +109,24 @@ private:
     void addBlock(EditorMaterial material, const sf::Vector2f& pos, const sf::Vector2f& size);
     void addPig(PigType type, const sf::Vector2f& pos);
     void addBird(BirdType type, const sf::Vector2f& pos);
+    // 按命令中的类型/编号创建实体（新建、撤销删除、重做新建共用）
+    EditorEntity makeEntity(EditorEntityType type, std::uint32_t variant,
+                            const sf::Vector2f& pos, const sf::Vector2f& size);
+    void recordEntity(EditorCommand& command, const EditorEntity& entity) const;
     void deleteEntity(size_t index);
+    void deleteSelected();
+    void eraseEntity(size_t index);  // 记录撤销并移除，不重建空间索引
     void selectEntity(size_t index);
     void deselectAll();
+    void selectInRect(const sf::Vector2f& a, const sf::Vector2f& b, bool additive);
     EditorEntity* getEntityAt(const sf::Vector2f& pos);
     
+    // Spatial index（增删后整体重建；移动、缩放和物理运动只刷新对应实体）
+    void rebuildSpatialIndex();
+    void indexEntity(size_t index);          // 登记新追加到末尾的实体
+    void refreshSpatialEntry(size_t index);
+    void moveEntity(size_t index, const sf::Vector2f& pos);
+    
     // Editing operations
     void startDrag(const sf::Vector2f& pos);
     void updateDrag(const sf::Vector2f& pos);
@@ -114,10 +134,16 @@ private:
     void startResize(const sf::Vector2f& pos);
     void updateResize(const sf::Vector2f& pos);
     void endResize();
+    void updateBand(const sf::Vector2f& pos);
+    void endBand();
     void resizeEntity(size_t index, const sf::Vector2f& newSize);
     
     // Undo/Redo
-    void pushAction(const EditorAction& action);
+    void pushCommand(EditorCommand command);
+    void beginGroup();
+    void endGroup();
+    // forward = true 为重做方向；返回是否增删了实体（需要重建空间索引）
+    bool applyCommand(EditorCommand& command, bool forward);
     void undo();
     void redo();
     
@@ -136,6 +162,10 @@ private:
     
     PhysicsWorld physics_;
     std::vector<EditorEntity> entities_;
+    EditorSpatialHash spatialHash_;
+    std::unordered_map<const Entity*, size_t> entityIndex_;  // 唤醒集合中的实体 -> entities_ 下标
+    std::vector<Entity*> awakeEntities_;
+    std::vector<size_t> hitCandidates_;
     std::vector<std::unique_ptr<Button>> toolbarButtons_;
     std::vector<std::unique_ptr<Button>> propertyButtons_;
     
@@ -146,17 +176,27 @@ private:
     
     // Selection and editing
     std::optional<size_t> selectedIndex_;
+    std::vector<size_t> selection_;  // 所有选中实体的下标，selectedIndex_ 是其中的主选中项（属性面板显示它）
     bool isDragging_{false};
     sf::Vector2f dragStartPos_;
     sf::Vector2f dragStartEntityPos_;
+    std::vector<std::pair<size_t, sf::Vector2f>> dragGroup_;  // 多选拖拽：下标与起始位置
     bool isResizing_{false};
     sf::Vector2f resizeStartPos_;
     sf::Vector2f resizeStartSize_;
+    bool isBandSelecting_{false};  // 框选（在空白处按下左键拖出矩形）
+    bool bandAdditive_{false};     // 按住 Shift 开始框选时保留已有选择
+    sf::Vector2f bandStart_;
+    sf::Vector2f bandEnd_;
+    std::optional<size_t> hoveredIndex_;
     
     // Undo/Redo stacks
-    std::deque<EditorAction> undoStack_;
-    std::deque<EditorAction> redoStack_;
-    static constexpr size_t kMaxUndoHistory = 50;
+    std::deque<EditorCommand> undoStack_;
+    std::deque<EditorCommand> redoStack_;
+    std::uint32_t nextGroup_{1};
+    std::uint32_t openGroup_{0};
+    sf::Clock lastCommandClock_;  // 合并连续的移动/缩放命令
+    bool coalesceOpen_{false};    // 撤销/重做/加载关卡之后不与栈顶合并
     
     // UI state
     bool showPropertyPanel_{false};
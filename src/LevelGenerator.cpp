@@ -0,0 +1,86 @@
+// 程序化压力关卡生成实现
+#include "LevelGenerator.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "Material.hpp"
+
+namespace {
+
+// 方块尺寸（像素）：立柱竖放、横板铺在两根立柱顶上
+constexpr float kPostWidth = 20.0f;
+constexpr float kPostHeight = 60.0f;
+constexpr float kPlankHeight = 20.0f;
+constexpr float kTowerWidth = 100.0f;
+constexpr float kTowerSpacing = 110.0f;
+
+// 标准库分布的实现因平台而异，这里直接用 mt19937 的原始输出保证跨平台一致
+std::uint32_t pick(std::mt19937& rng, std::uint32_t count) {
+    return static_cast<std::uint32_t>(rng() % count);
+}
+
+}  // namespace
+
+namespace LevelGenerator {
+
+LevelData makeStressLevel(const StressOptions& options) {
+    LevelData level;
+    level.id = 0;
+    level.targetScore = options.pigCount * 5000;
+
+    std::mt19937 rng(options.seed);
+    const auto& materials = materialIdTable();
+    const float groundTop = static_cast<float>(config::kWindowHeight) - 20.0f;
+
+    const int towerCount = std::max(1, static_cast<int>((options.right - options.left) / kTowerSpacing));
+    const int blocksPerFloor = 3;
+    const int floorCount = std::max(1, (options.blockCount + towerCount * blocksPerFloor - 1) /
+                                       (towerCount * blocksPerFloor));
+    const float floorHeight = kPostHeight + kPlankHeight;
+
+    // 逐层、逐塔铺设，凑满 blockCount 为止（最后一层可能不完整）
+    std::vector<std::pair<int, int>> floors;  // (塔, 层)，供放置猪
+    level.blocks.reserve(static_cast<std::size_t>(options.blockCount));
+    for (int floor = 0; floor < floorCount; ++floor) {
+        for (int tower = 0; tower < towerCount; ++tower) {
+            const float x = options.left + static_cast<float>(tower) * kTowerSpacing;
+            const float base = groundTop - static_cast<float>(floor) * floorHeight;
+
+            const BlockSpec pieces[3] = {
+                {"", {x, base - kPostHeight}, {kPostWidth, kPostHeight}},
+                {"", {x + kTowerWidth - kPostWidth, base - kPostHeight}, {kPostWidth, kPostHeight}},
+                {"", {x, base - floorHeight}, {kTowerWidth, kPlankHeight}},
+            };
+            for (const auto& piece : pieces) {
+                if (static_cast<int>(level.blocks.size()) >= options.blockCount) break;
+                BlockSpec block = piece;
+                block.material = materials[pick(rng, static_cast<std::uint32_t>(materials.size()))];
+                level.blocks.push_back(block);
+            }
+            floors.push_back({tower, floor});
+        }
+    }
+
+    // 猪放在各层两根立柱之间（层内空间高 kPostHeight，足够放下大猪）
+    const PigType pigTypes[3] = {PigType::Small, PigType::Medium, PigType::Large};
+    for (int i = 0; i < options.pigCount && !floors.empty(); ++i) {
+        auto [tower, floor] = floors[pick(rng, static_cast<std::uint32_t>(floors.size()))];
+        PigType type = pigTypes[pick(rng, 3)];
+        float radius = (type == PigType::Large) ? 26.f : (type == PigType::Medium ? 20.f : 16.f);
+        float x = options.left + static_cast<float>(tower) * kTowerSpacing + kTowerWidth * 0.5f;
+        float y = groundTop - static_cast<float>(floor) * floorHeight - radius;
+        level.pigs.push_back({type, {x, y}});
+    }
+
+    // 鸟在弹弓左侧排队，类型轮换
+    const BirdType birdTypes[3] = {BirdType::Red, BirdType::Yellow, BirdType::Bomb};
+    for (int i = 0; i < options.birdCount; ++i) {
+        level.birds.push_back({birdTypes[i % 3],
+                               {level.slingshot.x - 60.0f - 40.0f * static_cast<float>(i), groundTop - 14.0f}});
+    }
+
+    return level;
+}
+
+}  // namespace LevelGenerator
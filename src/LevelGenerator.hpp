@@ -0,0 +1,22 @@
+// 程序化压力关卡：按固定种子生成由混合材质方块搭成的多座塔楼
+// 用于基准测试（bench_main.cpp）与大关卡压力测试，同一组参数在任何平台上生成完全相同的关卡
+#pragma once
+
+#include <cstdint>
+
+#include "Level.hpp"
+
+namespace LevelGenerator {
+
+struct StressOptions {
+    int blockCount{300};        // 方块总数（每层 = 两根立柱 + 一块横板）
+    int pigCount{8};
+    int birdCount{6};
+    std::uint32_t seed{1};
+    float left{550.0f};         // 塔楼分布的水平范围（像素，需落在地面 -200..1600 内）
+    float right{1550.0f};
+};
+
+LevelData makeStressLevel(const StressOptions& options);
+
+}  // namespace LevelGenerator
@@ -0,0 +1,134 @@
+// 后台关卡预取实现
+#include "LevelPrefetch.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "LevelBinary.hpp"
+#include "LevelSettle.hpp"
+#include "Logger.hpp"
+#include "Simulation.hpp"
+
+LevelPrefetcher::LevelPrefetcher() : worker_([this] { workerLoop(); }) {}
+
+LevelPrefetcher::~LevelPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    wakeCv_.notify_all();
+    worker_.join();
+}
+
+void LevelPrefetcher::request(int index) {
+    std::error_code ec;
+    if (!std::filesystem::exists(config::levelPath(index), ec) &&
+        !std::filesystem::exists(LevelBinary::binaryPath(config::levelPath(index)), ec)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.count(index)) {
+            // 已排队的请求提到队首（最近悬停的关卡最可能被点击）
+            auto it = std::find(queue_.begin(), queue_.end(), index);
+            if (it != queue_.end()) {
+                queue_.erase(it);
+                queue_.push_front(index);
+            }
+            return;
+        }
+        entries_[index].state = State::Queued;
+        queue_.push_front(index);
+    }
+    wakeCv_.notify_one();
+}
+
+std::optional<LevelData> LevelPrefetcher::take(int index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = entries_.find(index);
+    if (it == entries_.end()) return std::nullopt;
+
+    if (it->second.state == State::Queued) {
+        queue_.erase(std::remove(queue_.begin(), queue_.end(), index), queue_.end());
+        entries_.erase(it);
+        return std::nullopt;
+    }
+    // 后台正在处理：等待比重新同步加载更快，也避免两边同时写沉降缓存
+    doneCv_.wait(lock, [&] {
+        auto cur = entries_.find(index);
+        return cur == entries_.end() || cur->second.state != State::Loading;
+    });
+    it = entries_.find(index);
+    if (it == entries_.end()) return std::nullopt;
+
+    Entry entry = std::move(it->second);
+    entries_.erase(it);
+    if (entry.state != State::Ready) return std::nullopt;
+
+    // 关卡编辑器可能在预取之后保存了关卡
+    Entry current;
+    stampFiles(index, current);
+    if (current.jsonTime != entry.jsonTime || current.binaryTime != entry.binaryTime) {
+        return std::nullopt;
+    }
+    return std::move(entry.data);
+}
+
+bool LevelPrefetcher::ready(int index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(index);
+    return it != entries_.end() && it->second.state == State::Ready;
+}
+
+void LevelPrefetcher::workerLoop() {
+    // 预取线程只做解析与沉降，实体不能加载贴图（OpenGL 上下文属于主线程）
+    Entity::setThreadHeadless(true);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeCv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) return;
+
+        int index = queue_.front();
+        queue_.pop_front();
+        entries_[index].state = State::Loading;
+        lock.unlock();
+
+        Entry result;
+        bool ok = prepare(index, result);
+
+        lock.lock();
+        Entry& entry = entries_[index];
+        entry = std::move(result);
+        entry.state = ok ? State::Ready : State::Failed;
+        doneCv_.notify_all();
+    }
+}
+
+void LevelPrefetcher::stampFiles(int index, Entry& entry) {
+    std::error_code ec;
+    const std::string jsonPath = config::levelPath(index);
+    entry.jsonTime = std::filesystem::last_write_time(jsonPath, ec);
+    if (ec) entry.jsonTime = {};
+    entry.binaryTime = std::filesystem::last_write_time(LevelBinary::binaryPath(jsonPath), ec);
+    if (ec) entry.binaryTime = {};
+}
+
+bool LevelPrefetcher::prepare(int index, Entry& entry) {
+    stampFiles(index, entry);
+    try {
+        // 与 Game::loadLevel 相同的关卡文件、地面与沉降流程（同样读写沉降缓存）
+        SimulationSession session;
+        if (!session.loadLevel(config::levelPath(index))) return false;
+        entry.data = session.level();
+        LevelSettle::captureSettled(entry.data, session.blocks(), session.pigs());
+    } catch (const std::exception& e) {
+        Logger::getInstance().warning("关卡预取失败: " + std::string(e.what()));
+        return false;
+    }
+    Logger::getInstance().info("关卡预取完成: " + std::to_string(index));
+    return true;
+}
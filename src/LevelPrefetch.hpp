@@ -0,0 +1,54 @@
+// 后台关卡预取：在选关界面为悬停/相邻关卡提前解析关卡文件并完成初始沉降
+// 主线程进入关卡时只需实例化实体并直接摆放到沉降后的位置（见 LevelSettle::applySettled）
+//
+// 实体贴图已由 TextureCache/实体图集在启动时常驻显存，因此预取只覆盖 CPU 侧的解析和沉降
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+#include "Level.hpp"
+
+class LevelPrefetcher {
+public:
+    LevelPrefetcher();
+    ~LevelPrefetcher();
+
+    LevelPrefetcher(const LevelPrefetcher&) = delete;
+    LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+    // 请求预取关卡（非阻塞）；已就绪/进行中/已排队的关卡忽略。最新请求优先处理
+    void request(int index);
+
+    // 取走预取结果：已就绪则返回（关卡文件在预取后被修改时丢弃）；
+    // 正在后台处理时等待其完成；未请求或仍在排队时返回 nullopt，由调用方同步加载
+    std::optional<LevelData> take(int index);
+
+    bool ready(int index) const;
+
+private:
+    enum class State { Queued, Loading, Ready, Failed };
+    struct Entry {
+        State state{State::Queued};
+        LevelData data;
+        std::filesystem::file_time_type jsonTime{};
+        std::filesystem::file_time_type binaryTime{};
+    };
+
+    void workerLoop();
+    static bool prepare(int index, Entry& entry);
+    static void stampFiles(int index, Entry& entry);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable doneCv_;
+    std::deque<int> queue_;
+    std::unordered_map<int, Entry> entries_;
+    bool stop_{false};
+    std::thread worker_;
+};
@@ -0,0 +1,275 @@
+// 关卡初始沉降实现
+#include "LevelSettle.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <sstream>
+
+#include "Config.hpp"
+#include "Logger.hpp"
+#include "Material.hpp"
+
+namespace {
+// 缓存格式/物理行为版本：下面 settleInputsHash 覆盖不到的物理改动（接触处理顺序、求解流程等）
+// 会改变沉降结果，这类提交必须递增此值，使已有的 levels/*.settled.json 全部失效
+// 2：接触事件改为步后统一结算（user-025），受击状态改为整表结算（user-026）
+constexpr int kCacheVersion = 2;
+
+// FNV-1a 64 位
+class Fnv1a {
+public:
+    void bytes(const void* data, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ ^= p[i];
+            hash_ *= 1099511628211ull;
+        }
+    }
+    template <typename T>
+    void value(T v) { bytes(&v, sizeof(v)); }
+
+    std::string hex() const {
+        std::ostringstream ss;
+        ss << std::hex << hash_;
+        return ss.str();
+    }
+
+private:
+    std::uint64_t hash_{1469598103934665603ull};
+};
+
+// 关卡文件内容的哈希，用于判断缓存是否过期
+bool hashFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    Fnv1a hash;
+    for (std::istreambuf_iterator<char> it(in), end; it != end; ++it) {
+        hash.value(static_cast<unsigned char>(*it));
+    }
+    out = hash.hex();
+    return true;
+}
+
+// 影响沉降结果的参数：步长、迭代次数、重力、限速、地面摩擦、沉降判定阈值与材质物理属性
+// 任一常量被调整时缓存自动失效
+const std::string& settleInputsHash() {
+    static const std::string kHash = [] {
+        Fnv1a hash;
+        hash.value(config::kFixedDelta);
+        hash.value(config::kVelocityIterations);
+        hash.value(config::kPositionIterations);
+        hash.value(config::kGravity);
+        hash.value(config::kPixelsPerMeter);
+        hash.value(config::kMaxBodySpeed);
+        hash.value(config::groundFriction::kBase);
+        hash.value(config::groundFriction::kSlow);
+        hash.value(config::groundFriction::kMedium);
+        hash.value(config::groundFriction::kSlowSpeed);
+        hash.value(config::groundFriction::kMediumSpeed);
+        hash.value(config::settle::kMaxSteps);
+        hash.value(config::settle::kMinSteps);
+        hash.value(config::settle::kCheckInterval);
+        hash.value(config::settle::kStableChecks);
+        hash.value(config::settle::kEnergyPerBody);
+        for (const auto& name : materialIdTable()) {
+            const Material material = getMaterialOrDefault(name);
+            hash.value(material.density);
+            hash.value(material.friction);
+            hash.value(material.restitution);
+        }
+        return hash.hex();
+    }();
+    return kHash;
+}
+
+// 缓存键：关卡文件哈希 + 沉降参数哈希
+bool sourceKey(const std::string& levelPath, std::string& out) {
+    if (!hashFile(levelPath, out)) return false;
+    out += "-" + settleInputsHash();
+    return true;
+}
+
+template <typename T>
+nlohmann::json transformsToJson(const std::vector<std::unique_ptr<T>>& entities) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& e : entities) {
+        const PhysicsBody* body = e->body();
+        sf::Vector2f pos = body->position();
+        arr.push_back({{"x", pos.x}, {"y", pos.y}, {"angle", body->angle()}});
+    }
+    return arr;
+}
+
+template <typename T>
+void applyTransforms(const nlohmann::json& arr, const std::vector<std::unique_ptr<T>>& entities) {
+    std::size_t i = 0;
+    for (const auto& t : arr) {
+        PhysicsBody* body = entities[i++]->body();
+        body->setTransform({t.value("x", 0.0f), t.value("y", 0.0f)}, t.value("angle", 0.0f));
+        body->setVelocity({0.0f, 0.0f});
+        body->setAwake(false);  // 沉降后的堆叠本来就会休眠，被撞击时由 Box2D 唤醒
+    }
+}
+
+template <typename T>
+std::vector<SettledTransform> captureTransforms(const std::vector<std::unique_ptr<T>>& entities) {
+    std::vector<SettledTransform> out;
+    out.reserve(entities.size());
+    for (const auto& e : entities) {
+        const PhysicsBody* body = e->body();
+        out.push_back({body->position(), body->angle()});
+    }
+    return out;
+}
+
+template <typename T>
+void applyTransforms(const std::vector<SettledTransform>& transforms,
+                     const std::vector<std::unique_ptr<T>>& entities) {
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+        PhysicsBody* body = entities[i]->body();
+        body->setTransform(transforms[i].position, transforms[i].angle);
+        body->setVelocity({0.0f, 0.0f});
+        body->setAwake(false);
+    }
+}
+}  // namespace
+
+namespace LevelSettle {
+
+int settle(PhysicsWorld& physics,
+           const std::vector<std::unique_ptr<Block>>& blocks,
+           const std::vector<std::unique_ptr<Pig>>& pigs) {
+    using namespace config::settle;
+    int stableChecks = 0;
+    int steps = 0;
+    for (int i = 0; i < kMaxSteps; ++i) {
+        physics.step(config::kFixedDelta);
+        ++steps;
+
+        // 每秒强制同步一次刚体位置（与原固定沉降流程一致）
+        if (i % 60 == 0) {
+            for (auto& block : blocks) {
+                if (block->body() && block->body()->active()) {
+                    block->body()->setPosition(block->position());
+                }
+            }
+            for (auto& pig : pigs) {
+                if (pig->body() && pig->body()->active()) {
+                    pig->body()->setPosition(pig->position());
+                }
+            }
+        }
+
+        if (steps < kMinSteps || steps % kCheckInterval != 0) continue;
+        // 全部休眠立即结束；否则要求连续几次检查动能都低于阈值
+        if (physics.awakeDynamicBodyCount() == 0) break;
+        int bodyCount = std::max(1, physics.dynamicBodyCount());
+        bool atRest = physics.kineticEnergy() < kEnergyPerBody * static_cast<float>(bodyCount);
+        stableChecks = atRest ? stableChecks + 1 : 0;
+        if (stableChecks >= kStableChecks) break;
+    }
+    return steps;
+}
+
+std::string cachePath(const std::string& levelPath) {
+    std::string base = levelPath;
+    const std::string ext = ".json";
+    if (base.size() > ext.size() && base.compare(base.size() - ext.size(), ext.size(), ext) == 0) {
+        base.erase(base.size() - ext.size());
+    }
+    return base + ".settled.json";
+}
+
+bool applyCache(const std::string& levelPath,
+                const std::vector<std::unique_ptr<Block>>& blocks,
+                const std::vector<std::unique_ptr<Pig>>& pigs) {
+    std::string sourceHash;
+    if (!sourceKey(levelPath, sourceHash)) return false;
+
+    std::ifstream in(cachePath(levelPath));
+    if (!in.is_open()) return false;
+
+    nlohmann::json j;
+    try {
+        in >> j;
+    } catch (const std::exception& e) {
+        Logger::getInstance().warning("沉降缓存损坏，重新沉降: " + std::string(e.what()));
+        return false;
+    }
+
+    if (j.value("version", 0) != kCacheVersion || j.value("source", std::string()) != sourceHash) {
+        return false;
+    }
+    if (!j.contains("blocks") || !j.contains("pigs") ||
+        j["blocks"].size() != blocks.size() || j["pigs"].size() != pigs.size()) {
+        return false;
+    }
+
+    applyTransforms(j["blocks"], blocks);
+    applyTransforms(j["pigs"], pigs);
+    return true;
+}
+
+void writeCache(const std::string& levelPath,
+                const std::vector<std::unique_ptr<Block>>& blocks,
+                const std::vector<std::unique_ptr<Pig>>& pigs) {
+    std::string sourceHash;
+    if (!sourceKey(levelPath, sourceHash)) return;
+
+    nlohmann::json j;
+    j["version"] = kCacheVersion;
+    j["source"] = sourceHash;
+    j["blocks"] = transformsToJson(blocks);
+    j["pigs"] = transformsToJson(pigs);
+
+    std::ofstream out(cachePath(levelPath));
+    if (!out.is_open()) {
+        Logger::getInstance().warning("无法写入沉降缓存: " + cachePath(levelPath));
+        return;
+    }
+    out << j.dump(2);
+}
+
+bool applySettled(const LevelData& level,
+                  const std::vector<std::unique_ptr<Block>>& blocks,
+                  const std::vector<std::unique_ptr<Pig>>& pigs) {
+    if (level.settledBlocks.empty() && level.settledPigs.empty()) return false;
+    if (level.settledBlocks.size() != blocks.size() || level.settledPigs.size() != pigs.size()) {
+        return false;
+    }
+    applyTransforms(level.settledBlocks, blocks);
+    applyTransforms(level.settledPigs, pigs);
+    return true;
+}
+
+void captureSettled(LevelData& level,
+                    const std::vector<std::unique_ptr<Block>>& blocks,
+                    const std::vector<std::unique_ptr<Pig>>& pigs) {
+    level.settledBlocks = captureTransforms(blocks);
+    level.settledPigs = captureTransforms(pigs);
+}
+
+int settleOrLoadCache(const std::string& levelPath, const LevelData& level, PhysicsWorld& physics,
+                      const std::vector<std::unique_ptr<Block>>& blocks,
+                      const std::vector<std::unique_ptr<Pig>>& pigs) {
+    if (applySettled(level, blocks, pigs)) {
+        return 0;
+    }
+    if (!levelPath.empty() && applyCache(levelPath, blocks, pigs)) {
+        Logger::getInstance().info("使用沉降缓存: " + cachePath(levelPath));
+        return 0;
+    }
+
+    int steps = settle(physics, blocks, pigs);
+    Logger::getInstance().info("关卡沉降完成，步数: " + std::to_string(steps));
+    if (!levelPath.empty()) {
+        writeCache(levelPath, blocks, pigs);
+    }
+    return steps;
+}
+
+}  // namespace LevelSettle
@@ -0,0 +1,49 @@
+// 关卡初始沉降：自适应提前结束 + 沉降结果缓存
+// Game::loadLevel 与 SimulationSession 共用，保证窗口游戏与无窗口模拟的初始状态一致
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Entity.hpp"
+#include "Level.hpp"
+#include "Physics.hpp"
+
+namespace LevelSettle {
+
+// 推进物理直到所有动态刚体休眠或动能低于阈值（见 config::settle），返回实际步数
+int settle(PhysicsWorld& physics,
+           const std::vector<std::unique_ptr<Block>>& blocks,
+           const std::vector<std::unique_ptr<Pig>>& pigs);
+
+// 沉降缓存文件路径：levels/level1.json -> levels/level1.settled.json
+std::string cachePath(const std::string& levelPath);
+
+// 读取缓存并直接摆放刚体（置为休眠）；缓存不存在、关卡文件或沉降相关的物理参数已修改、实体数量不符时返回 false
+bool applyCache(const std::string& levelPath,
+                const std::vector<std::unique_ptr<Block>>& blocks,
+                const std::vector<std::unique_ptr<Pig>>& pigs);
+
+// 把当前刚体位置/角度写入缓存（写入失败只记录警告）
+void writeCache(const std::string& levelPath,
+                const std::vector<std::unique_ptr<Block>>& blocks,
+                const std::vector<std::unique_ptr<Pig>>& pigs);
+
+// 使用关卡数据自带的预沉降变换（二进制关卡）；没有或数量不符时返回 false
+bool applySettled(const LevelData& level,
+                  const std::vector<std::unique_ptr<Block>>& blocks,
+                  const std::vector<std::unique_ptr<Pig>>& pigs);
+
+// 把当前刚体变换记录为 level 的预沉降数据（关卡转换工具、后台预取使用）
+void captureSettled(LevelData& level,
+                    const std::vector<std::unique_ptr<Block>>& blocks,
+                    const std::vector<std::unique_ptr<Pig>>& pigs);
+
+// 优先使用关卡自带的预沉降变换，其次是缓存；都没有时沉降并写入缓存。levelPath 为空时不使用缓存
+// 返回沉降步数（使用预沉降数据或命中缓存时为 0）
+int settleOrLoadCache(const std::string& levelPath, const LevelData& level, PhysicsWorld& physics,
+                      const std::vector<std::unique_ptr<Block>>& blocks,
+                      const std::vector<std::unique_ptr<Pig>>& pigs);
+
+}  // namespace LevelSettle
@@ -4,46 +4,222 @@
 #include <iostream>
 #include <filesystem>
 
+namespace {
+constexpr auto kWriterIdleWait = std::chrono::milliseconds(10);
+constexpr int kMaxFullRetries = 1000;
+
+std::tm toLocalTime(std::time_t t) {
+    std::tm result{};
+#if defined(_WIN32)
+    localtime_s(&result, &t);
+#else
+    localtime_r(&t, &result);
+#endif
+    return result;
+}
+}  // namespace
+
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
 }
 
 void Logger::init(const std::string& logFilePath) {
-    if (initialized_) {
-        return; // 已经初始化，直接返回
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (initialized_) {
+            return; // 已经初始化，直接返回
+        }
+        
+        // 打开日志文件（覆盖模式）
+        logFile_.open(logFilePath, std::ios::out | std::ios::trunc);
+        if (!logFile_.is_open()) {
+            std::cerr << "警告: 无法打开日志文件: " << logFilePath << "\n";
+            return;
+        }
+        
+        if (async_) {
+            ring_ = std::make_unique<Slot[]>(kRingSize);
+            for (std::size_t i = 0; i < kRingSize; ++i) {
+                ring_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            enqueuePos_.store(0, std::memory_order_relaxed);
+            dequeuePos_ = 0;
+            writtenPos_.store(0, std::memory_order_relaxed);
+            stopWriter_.store(false, std::memory_order_relaxed);
+            writer_ = std::thread([this] { writerLoop(); });
+            writerRunning_.store(true, std::memory_order_release);
+        }
+        initialized_ = true;
     }
-    
-    // 打开日志文件（覆盖模式）
-    logFile_.open(logFilePath, std::ios::out | std::ios::trunc);
-    if (!logFile_.is_open()) {
-        std::cerr << "警告: 无法打开日志文件: " << logFilePath << "\n";
+    info("=== 游戏日志系统初始化 ===");
+    info("日志文件: " + logFilePath + (async_ ? "（异步）" : ""));
+}
+
+void Logger::log(LogLevel level, const std::string& message) {
+    // 先登记为在途生产者再检查写线程：close() 清除 writerRunning_ 后会等在途计数归零才停止写线程，
+    // 通过检查的记录一定会被写线程取走（两处都用 seq_cst，保证双方至少有一方看到对方的写入）
+    activeProducers_.fetch_add(1, std::memory_order_seq_cst);
+    if (writerRunning_.load(std::memory_order_seq_cst)) {
+        enqueue(level, message);
+        activeProducers_.fetch_sub(1, std::memory_order_release);
         return;
     }
-    
-    initialized_ = true;
-    info("=== 游戏日志系统初始化 ===");
-    info("日志文件: " + logFilePath);
+    activeProducers_.fetch_sub(1, std::memory_order_release);
+    logSync(level, message);
 }
 
-void Logger::log(const std::string& level, const std::string& message) {
+void Logger::logSync(LogLevel level, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (!initialized_ || !logFile_.is_open()) {
         // 如果日志系统未初始化，输出到控制台
-        std::cerr << "[" << level << "] " << message << "\n";
+        if (!consoleOutput_) return;
+        std::cerr << "[" << levelName(level) << "] " << message << "\n";
         return;
     }
     
     std::string timeStr = getCurrentTime();
-    logFile_ << "[" << timeStr << "] [" << level << "] " << message << std::endl;
+    logFile_ << "[" << timeStr << "] [" << levelName(level) << "] " << message << std::endl;
     logFile_.flush(); // 立即刷新到文件
     
     // 同时输出到控制台
-    std::cerr << "[" << timeStr << "] [" << level << "] " << message << "\n";
+    if (!consoleOutput_) return;
+    std::cerr << "[" << timeStr << "] [" << levelName(level) << "] " << message << "\n";
+}
+
+bool Logger::enqueue(LogLevel level, const std::string& message) {
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    int fullRetries = 0;
+    while (true) {
+        slot = &ring_[pos & (kRingSize - 1)];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // 缓冲区已满：唤醒写线程并短暂让出 CPU；仍然满则丢弃而不是无限阻塞调用线程
+            // （写线程会报告丢弃数量）
+            if (++fullRetries > kMaxFullRetries) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            wakeCv_.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->record.level = level;
+    slot->record.time = std::chrono::system_clock::now();
+    slot->record.message = message;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    // 突发大量日志时提前唤醒写线程，避免等到空闲超时才开始清空缓冲区
+    if ((pos & (kRingSize / 4 - 1)) == kRingSize / 4 - 1) wakeCv_.notify_one();
+    return true;
+}
+
+std::size_t Logger::drain(std::string& buffer) {
+    std::size_t count = 0;
+    while (count < kBatchSize) {
+        Slot& slot = ring_[dequeuePos_ & (kRingSize - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) break;
+        formatRecord(buffer, slot.record);
+        slot.record.message.clear();  // 保留容量，槽位复用时无需重新分配
+        slot.sequence.store(dequeuePos_ + kRingSize, std::memory_order_release);
+        ++dequeuePos_;
+        ++count;
+    }
+    return count;
+}
+
+void Logger::writerLoop() {
+    std::string buffer;
+    std::size_t reportedDrops = 0;
+    while (true) {
+        buffer.clear();
+        std::size_t count = drain(buffer);
+
+        std::size_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            buffer += "[WARN] 日志缓冲区已满，丢弃 " + std::to_string(drops - reportedDrops) + " 条日志\n";
+            reportedDrops = drops;
+        }
+
+        if (!buffer.empty()) {
+            logFile_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (consoleOutput_) std::cerr.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        bool flushNow = flushRequested_.exchange(false, std::memory_order_acq_rel);
+        bool stopping = stopWriter_.load(std::memory_order_acquire);
+        if (count == kBatchSize && !flushNow && !stopping) continue;  // 还有积压，继续批量写
+
+        if (flushNow || stopping || count > 0) {
+            if (flushNow || stopping) logFile_.flush();
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                writtenPos_.store(dequeuePos_, std::memory_order_release);
+            }
+            flushedCv_.notify_all();
+        }
+        if (stopping && count == 0) {
+            logFile_.flush();
+            return;
+        }
+
+        if (count == 0) {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCv_.wait_for(lock, kWriterIdleWait);
+        }
+    }
+}
+
+void Logger::flush() {
+    if (!writerRunning_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (logFile_.is_open()) logFile_.flush();
+        return;
+    }
+    // 等待写线程越过当前已分配的全部位置
+    const std::size_t target = enqueuePos_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    flushRequested_.store(true, std::memory_order_release);
+    wakeCv_.notify_one();
+    flushedCv_.wait(lock, [&] {
+        if (writtenPos_.load(std::memory_order_acquire) >= target) return true;
+        // 写线程可能在我们设置请求前已经处理完一轮并进入等待，重新发出请求
+        flushRequested_.store(true, std::memory_order_release);
+        wakeCv_.notify_one();
+        return false;
+    });
+}
+
+void Logger::formatRecord(std::string& out, const Record& record) {
+    std::time_t t = std::chrono::system_clock::to_time_t(record.time);
+    std::tm local = toLocalTime(t);
+    char timeStr[32];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &local);
+    out += '[';
+    out += timeStr;
+    out += "] [";
+    out += levelName(record.level);
+    out += "] ";
+    out += record.message;
+    out += '\n';
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        default: return "INFO";
+    }
 }
 
 std::string Logger::getCurrentTime() const {
-    auto now = std::time(nullptr);
-    auto localTime = *std::localtime(&now);
+    std::tm localTime = toLocalTime(std::time(nullptr));
     
     std::ostringstream oss;
     oss << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S");
@@ -51,26 +227,41 @@ std::string Logger::getCurrentTime() const {
 }
 
 void Logger::info(const std::string& message) {
-    log("INFO", message);
+    if (enabled(LogLevel::Info)) log(LogLevel::Info, message);
 }
 
 void Logger::warning(const std::string& message) {
-    log("WARN", message);
+    if (enabled(LogLevel::Warning)) log(LogLevel::Warning, message);
 }
 
 void Logger::error(const std::string& message) {
-    log("ERROR", message);
+    log(LogLevel::Error, message);
+    flush();  // 错误日志必须在可能的崩溃前落盘
 }
 
 void Logger::close() {
-    if (initialized_ && logFile_.is_open()) {
-        info("=== 游戏结束 ===");
+    if (!initialized_) return;
+    info("=== 游戏结束 ===");
+    // 持有 mutex_ 直到文件关闭：关闭期间其他线程的日志走同步路径并在此等待
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (writerRunning_.exchange(false, std::memory_order_seq_cst)) {
+        // 等待已通过 writerRunning_ 检查的生产者写完槽位，之后的日志都走同步路径
+        while (activeProducers_.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        {
+            std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+            stopWriter_.store(true, std::memory_order_release);
+        }
+        wakeCv_.notify_one();
+        writer_.join();
+    }
+    if (logFile_.is_open()) {
         logFile_.close();
-        initialized_ = false;
     }
+    initialized_ = false;
 }
 
 Logger::~Logger() {
     close();
 }
-
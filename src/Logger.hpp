@@ -1,39 +1,120 @@
 // 日志系统 - 记录游戏运行日志
+// 默认异步模式：调用线程只把日志记录放入无锁环形缓冲区（MPSC），
+// 由后台写线程批量格式化时间戳并写入文件/控制台；error 和 close 会同步等待落盘
 #pragma once
 
-#include <string>
-#include <fstream>
-#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// 编译期日志级别过滤：低于该级别的 LOG_* 宏调用连同消息拼接一起被编译器剔除
+// 0 = 全部，1 = 只保留 warning/error，2 = 只保留 error（例如 -DLOGGER_MIN_LEVEL=1）
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+enum class LogLevel { Info = 0, Warning = 1, Error = 2 };
 
 class Logger {
 public:
     static Logger& getInstance();
     
-    // 初始化日志系统
+    // 初始化日志系统（异步模式下同时启动后台写线程）
     void init(const std::string& logFilePath = "last_run.log");
     
     // 记录信息
     void info(const std::string& message);
     void warning(const std::string& message);
-    void error(const std::string& message);
+    void error(const std::string& message);  // 异步模式下同步等待写入完成
+    
+    // 等待已提交的日志全部写入文件
+    void flush();
     
     // 关闭日志（程序退出时调用）
     void close();
     
+    // 是否同时输出到控制台（批量模拟时关闭，避免刷屏拖慢速度）
+    void setConsoleOutput(bool enabled) { consoleOutput_ = enabled; }
+    // 异步/同步模式，需在 init 之前设置（默认异步）
+    void setAsync(bool enabled) { async_ = enabled; }
+    // 运行期级别过滤（默认全部记录）：大量会话并行自我对局时只保留 warning/error，避免挤满环形缓冲区
+    void setMinLevel(LogLevel level) { minLevel_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    bool enabled(LogLevel level) const {
+        return compiledIn(level) && static_cast<int>(level) >= minLevel_.load(std::memory_order_relaxed);
+    }
+    // 环形缓冲区已满而丢弃的日志条数
+    std::size_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    
+    static constexpr bool compiledIn(LogLevel level) {
+        return static_cast<int>(level) >= LOGGER_MIN_LEVEL;
+    }
+    
     // 禁止拷贝
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
 private:
+    struct Record {
+        LogLevel level{LogLevel::Info};
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+    // Vyukov 有界队列的槽位：sequence 标记槽位可写（== pos）或可读（== pos + 1）
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        Record record;
+    };
+    static constexpr std::size_t kRingSize = 4096;  // 必须是 2 的幂
+    static constexpr std::size_t kBatchSize = 256;  // 每次批量写入的最大条数
+    
     Logger() = default;
     ~Logger();
     
-    void log(const std::string& level, const std::string& message);
+    void log(LogLevel level, const std::string& message);
+    void logSync(LogLevel level, const std::string& message);
+    bool enqueue(LogLevel level, const std::string& message);
+    void writerLoop();
+    std::size_t drain(std::string& buffer);
+    static void formatRecord(std::string& out, const Record& record);
+    static const char* levelName(LogLevel level);
     std::string getCurrentTime() const;
     
+    std::mutex mutex_;  // 同步模式写入、以及后台线程的启停
     std::ofstream logFile_;
     bool initialized_{false};
+    std::atomic<bool> consoleOutput_{true};
+    std::atomic<int> minLevel_{static_cast<int>(LogLevel::Info)};
+    bool async_{true};
+    
+    // 异步模式
+    std::unique_ptr<Slot[]> ring_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::size_t dequeuePos_{0};     // 只由写线程访问
+    std::atomic<std::size_t> writtenPos_{0};     // 已写入文件的位置（flush 等待它追上）
+    std::atomic<std::size_t> dropped_{0};
+    std::atomic<bool> flushRequested_{false};
+    std::atomic<bool> stopWriter_{false};
+    std::atomic<bool> writerRunning_{false};
+    std::atomic<int> activeProducers_{0};  // 已通过 writerRunning_ 检查、尚未写完槽位的 log() 调用数
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;   // 唤醒写线程（flush/close）
+    std::condition_variable flushedCv_;
+    std::thread writer_;
 };
 
+// 热路径日志：被编译期或运行期级别过滤掉时不会计算消息表达式
+#define LOG_INFO(message) \
+    do { if constexpr (Logger::compiledIn(LogLevel::Info)) { \
+        if (Logger::getInstance().enabled(LogLevel::Info)) Logger::getInstance().info(message); } } while (0)
+#define LOG_WARNING(message) \
+    do { if constexpr (Logger::compiledIn(LogLevel::Warning)) { \
+        if (Logger::getInstance().enabled(LogLevel::Warning)) Logger::getInstance().warning(message); } } while (0)
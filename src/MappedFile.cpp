@@ -0,0 +1,96 @@
+// 只读内存映射文件实现
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    fileHandle_ = file;
+                    mappingHandle_ = mapping;
+                    data_ = static_cast<const unsigned char*>(view);
+                    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+                    mapped_ = true;
+                    opened_ = true;
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st {};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // 映射建立后即可关闭文件描述符
+            if (view != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(view);
+                size_ = static_cast<std::size_t>(st.st_size);
+                mapped_ = true;
+                opened_ = true;
+                return true;
+            }
+        } else {
+            ::close(fd);
+        }
+    }
+#endif
+
+    // 回退：普通读取（空文件或映射不可用）
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = fallback_.empty() ? nullptr : fallback_.data();
+    size_ = fallback_.size();
+    opened_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_ && data_) {
+#if defined(_WIN32)
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    }
+    fallback_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    opened_ = false;
+}
@@ -0,0 +1,35 @@
+// 只读内存映射文件（Windows: CreateFileMapping，其他平台: mmap）
+// 映射失败时回退为一次性读入内存，调用方始终通过 data()/size() 访问
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 打开并映射文件；失败返回 false（文件不存在或无法读取）
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool isOpen() const { return opened_; }
+
+private:
+    const unsigned char* data_{nullptr};
+    std::size_t size_{0};
+    bool opened_{false};
+    bool mapped_{false};              // true = 真正的内存映射；false = fallback_ 中的拷贝
+    std::vector<unsigned char> fallback_;
+#if defined(_WIN32)
+    void* fileHandle_{nullptr};
+    void* mappingHandle_{nullptr};
+#endif
+};
@@ -2,8 +2,10 @@
 #pragma once
 
 #include <SFML/Graphics/Color.hpp>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct Material {
     std::string name;
@@ -35,4 +37,33 @@ inline Material getMaterialOrDefault(const std::string& name) {
     return {"wood", 1.0f, 0.5f, 0.2f, 30.0f, 1.0f, sf::Color(160, 120, 70)};
 }
 
+// 二进制关卡格式（LevelBinary.hpp）中的材质编号：顺序即编号，只能在末尾追加
+constexpr std::uint32_t kUnknownMaterialId = 0xFFFFFFFFu;
 
+inline const std::vector<std::string>& materialIdTable() {
+    static const std::vector<std::string> kIds = {"glass", "wood", "woodboard", "stone", "stoneslab"};
+    return kIds;
+}
+
+// 常用材质编号（与上表顺序一致），伤害结算按编号判断材质，避免字符串比较
+namespace material_id {
+    constexpr std::uint32_t kGlass     = 0;
+    constexpr std::uint32_t kWood      = 1;
+    constexpr std::uint32_t kWoodboard = 2;
+    constexpr std::uint32_t kStone     = 3;
+    constexpr std::uint32_t kStoneslab = 4;
+}
+
+inline std::uint32_t materialIdFromName(const std::string& name) {
+    const auto& ids = materialIdTable();
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] == name) return static_cast<std::uint32_t>(i);
+    }
+    return kUnknownMaterialId;
+}
+
+// 未知编号返回空名称，getMaterialOrDefault 会给出与 JSON 中未知材质相同的默认材质
+inline std::string materialNameFromId(std::uint32_t id) {
+    const auto& ids = materialIdTable();
+    return id < ids.size() ? ids[id] : std::string();
+}
@@ -0,0 +1,86 @@
+// 固定大小对象池：按块（chunk）批量申请内存，释放的槽位进入空闲链表供下次复用
+// 用于 Block/Pig/Bird 的类内 operator new/delete：AI 批量重试关卡时，
+// 每次重载都会销毁并重建整关实体，池化后稳定状态下不再向系统分配器申请内存
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+template <typename T, std::size_t ChunkSize = 64>
+class ObjectPool {
+public:
+    static ObjectPool& instance() {
+        static ObjectPool pool;
+        return pool;
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!freeList_) grow();
+        Slot* slot = freeList_;
+        freeList_ = slot->next;
+        ++inUse_;
+        return slot;
+    }
+
+    void deallocate(void* p) {
+        if (!p) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot* slot = static_cast<Slot*>(p);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --inUse_;
+    }
+
+    std::size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunks_.size() * ChunkSize;
+    }
+
+    std::size_t inUse() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inUse_;
+    }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    void grow() {
+        auto chunk = std::make_unique<Slot[]>(ChunkSize);
+        for (std::size_t i = 0; i < ChunkSize; ++i) {
+            chunk[i].next = (i + 1 < ChunkSize) ? &chunk[i + 1] : freeList_;
+        }
+        freeList_ = &chunk[0];
+        chunks_.push_back(std::move(chunk));
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot* freeList_{nullptr};
+    std::size_t inUse_{0};
+};
+
+// 类内 operator new/delete 的实现辅助：大小与 T 不符（派生类）时回退到全局分配器
+template <typename T>
+void* poolAllocate(std::size_t size) {
+    return size == sizeof(T) ? ObjectPool<T>::instance().allocate() : ::operator new(size);
+}
+
+template <typename T>
+void poolDeallocate(void* p, std::size_t size) {
+    if (size == sizeof(T)) {
+        ObjectPool<T>::instance().deallocate(p);
+    } else {
+        ::operator delete(p);
+    }
+}
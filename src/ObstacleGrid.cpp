@@ -0,0 +1,254 @@
+// AI 障碍物均匀网格实现
+#include "ObstacleGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+// 网格单元数上限：方块飞出屏幕很远时自动放大单元，避免网格无限膨胀
+constexpr long long kMaxCells = 1 << 16;
+
+}  // namespace
+
+ObstacleGrid::Box ObstacleGrid::Box::oriented(const sf::Vector2f& center, const sf::Vector2f& size, float angle) {
+    Box box;
+    box.center = center;
+    box.halfSize = size * 0.5f;
+    if (angle != 0.0f) box.axis = {std::cos(angle), std::sin(angle)};
+    // 外接 AABB：半宽高投影到世界坐标轴上
+    const float c = std::abs(box.axis.x);
+    const float sn = std::abs(box.axis.y);
+    const sf::Vector2f extent(box.halfSize.x * c + box.halfSize.y * sn, box.halfSize.x * sn + box.halfSize.y * c);
+    box.min = center - extent;
+    box.max = center + extent;
+    return box;
+}
+
+void ObstacleGrid::clear() {
+    boxes_.clear();
+    cellStart_.clear();
+    cellItems_.clear();
+    cols_ = 0;
+    rows_ = 0;
+}
+
+void ObstacleGrid::build(std::vector<Box> boxes, float cellSize) {
+    clear();
+    boxes_ = std::move(boxes);
+    if (boxes_.empty()) return;
+
+    sf::Vector2f lo = boxes_.front().min;
+    sf::Vector2f hi = boxes_.front().max;
+    for (const auto& box : boxes_) {
+        lo.x = std::min(lo.x, box.min.x);
+        lo.y = std::min(lo.y, box.min.y);
+        hi.x = std::max(hi.x, box.max.x);
+        hi.y = std::max(hi.y, box.max.y);
+    }
+
+    cellSize_ = std::max(cellSize, 1.0f);
+    auto countCells = [&](float size) {
+        long long cols = static_cast<long long>(std::floor((hi.x - lo.x) / size)) + 1;
+        long long rows = static_cast<long long>(std::floor((hi.y - lo.y) / size)) + 1;
+        return std::make_pair(cols, rows);
+    };
+    auto [cols, rows] = countCells(cellSize_);
+    while (cols * rows > kMaxCells) {
+        cellSize_ *= 2.0f;
+        std::tie(cols, rows) = countCells(cellSize_);
+    }
+    origin_ = lo;
+    cols_ = static_cast<int>(cols);
+    rows_ = static_cast<int>(rows);
+
+    // 两遍计数构建 CSR：先统计每格盒子数，再填充下标
+    const std::size_t cellCount = static_cast<std::size_t>(cols_) * static_cast<std::size_t>(rows_);
+    cellStart_.assign(cellCount + 1, 0);
+    for (const auto& box : boxes_) {
+        for (int y = cellY(box.min.y); y <= cellY(box.max.y); ++y) {
+            for (int x = cellX(box.min.x); x <= cellX(box.max.x); ++x) {
+                ++cellStart_[static_cast<std::size_t>(y) * cols_ + x + 1];
+            }
+        }
+    }
+    for (std::size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+    cellItems_.resize(cellStart_.back());
+    std::vector<std::size_t> cursor(cellStart_.begin(), cellStart_.end() - 1);
+    for (std::size_t i = 0; i < boxes_.size(); ++i) {
+        const auto& box = boxes_[i];
+        for (int y = cellY(box.min.y); y <= cellY(box.max.y); ++y) {
+            for (int x = cellX(box.min.x); x <= cellX(box.max.x); ++x) {
+                cellItems_[cursor[static_cast<std::size_t>(y) * cols_ + x]++] = i;
+            }
+        }
+    }
+}
+
+int ObstacleGrid::cellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - origin_.x) / cellSize_));
+    return std::clamp(cell, 0, cols_ - 1);
+}
+
+int ObstacleGrid::cellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - origin_.y) / cellSize_));
+    return std::clamp(cell, 0, rows_ - 1);
+}
+
+bool ObstacleGrid::intersectSegment(const Box& box, const sf::Vector2f& start,
+                                    const sf::Vector2f& delta, float& tEnter) {
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    const float origin[2] = {start.x, start.y};
+    const float dir[2] = {delta.x, delta.y};
+    const float lo[2] = {box.min.x, box.min.y};
+    const float hi[2] = {box.max.x, box.max.y};
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::abs(dir[axis]) < 1e-8f) {
+            // 平行于该轴的 slab：起点必须落在 slab 内
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        float inv = 1.0f / dir[axis];
+        float t1 = (lo[axis] - origin[axis]) * inv;
+        float t2 = (hi[axis] - origin[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+
+    tEnter = tMin;
+    return true;
+}
+
+bool ObstacleGrid::intersectBox(const Box& box, const sf::Vector2f& start,
+                                const sf::Vector2f& delta, float& tEnter) {
+    if (!intersectSegment(box, start, delta, tEnter)) return false;  // 外接 AABB 粗筛
+    if (box.axis.y == 0.0f && box.axis.x == 1.0f) return true;        // 轴对齐：AABB 即盒子本身
+
+    // 投影到盒子局部坐标系（x 轴 = axis，y 轴 = axis 逆时针转 90°），线段参数 t 不变
+    const sf::Vector2f& u = box.axis;
+    const sf::Vector2f v(-u.y, u.x);
+    const sf::Vector2f rel = start - box.center;
+    const sf::Vector2f localStart(rel.x * u.x + rel.y * u.y, rel.x * v.x + rel.y * v.y);
+    const sf::Vector2f localDelta(delta.x * u.x + delta.y * u.y, delta.x * v.x + delta.y * v.y);
+    Box local;
+    local.min = -box.halfSize;
+    local.max = box.halfSize;
+    return intersectSegment(local, localStart, localDelta, tEnter);
+}
+
+template <typename Visit>
+void ObstacleGrid::traverse(const sf::Vector2f& start, const sf::Vector2f& end, Visit&& visit) const {
+    if (boxes_.empty()) return;
+
+    // 先把线段裁剪到网格范围内
+    const sf::Vector2f delta = end - start;
+    const Box bounds{origin_, origin_ + sf::Vector2f(cols_ * cellSize_, rows_ * cellSize_)};
+    float t0 = 0.0f;
+    if (!intersectSegment(bounds, start, delta, t0)) return;
+
+    const sf::Vector2f entry = start + delta * t0;
+    int x = cellX(entry.x);
+    int y = cellY(entry.y);
+
+    // Amanatides-Woo DDA：tMax 为到达下一条格线的线段参数，tDelta 为跨过一格所需的参数增量
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    const int stepX = delta.x > 0.0f ? 1 : (delta.x < 0.0f ? -1 : 0);
+    const int stepY = delta.y > 0.0f ? 1 : (delta.y < 0.0f ? -1 : 0);
+    auto firstBoundary = [&](int cell, int step, float originAxis, float startAxis, float deltaAxis) {
+        if (step == 0) return kInf;
+        float boundary = originAxis + static_cast<float>(cell + (step > 0 ? 1 : 0)) * cellSize_;
+        return (boundary - startAxis) / deltaAxis;
+    };
+    float tMaxX = firstBoundary(x, stepX, origin_.x, start.x, delta.x);
+    float tMaxY = firstBoundary(y, stepY, origin_.y, start.y, delta.y);
+    const float tDeltaX = stepX != 0 ? cellSize_ / std::abs(delta.x) : kInf;
+    const float tDeltaY = stepY != 0 ? cellSize_ / std::abs(delta.y) : kInf;
+
+    while (true) {
+        const float tExit = std::min({tMaxX, tMaxY, 1.0f});
+        if (!visit(static_cast<std::size_t>(y) * cols_ + x, tExit)) return;
+        if (tExit >= 1.0f) return;
+
+        if (tMaxX < tMaxY) {
+            x += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            y += stepY;
+            tMaxY += tDeltaY;
+        }
+        if (x < 0 || x >= cols_ || y < 0 || y >= rows_) return;
+    }
+}
+
+void ObstacleGrid::raycast(const sf::Vector2f& start, const sf::Vector2f& end,
+                           std::vector<Hit>& hits) const {
+    hits.clear();
+    const sf::Vector2f delta = end - start;
+    traverse(start, end, [&](std::size_t cell, float) {
+        for (std::size_t k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+            std::size_t index = cellItems_[k];
+            float t = 0.0f;
+            if (intersectBox(boxes_[index], start, delta, t)) {
+                hits.push_back({t, index});
+            }
+        }
+        return true;
+    });
+
+    // 跨多个格子的盒子会被重复收集，按下标去重后再按进入点排序
+    std::sort(hits.begin(), hits.end(),
+              [](const Hit& a, const Hit& b) { return a.index < b.index; });
+    hits.erase(std::unique(hits.begin(), hits.end(),
+                           [](const Hit& a, const Hit& b) { return a.index == b.index; }),
+               hits.end());
+    std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+        return a.t < b.t || (a.t == b.t && a.index < b.index);
+    });
+}
+
+bool ObstacleGrid::firstHit(const sf::Vector2f& start, const sf::Vector2f& end, Hit& hit) const {
+    const sf::Vector2f delta = end - start;
+    bool found = false;
+    traverse(start, end, [&](std::size_t cell, float tExit) {
+        for (std::size_t k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+            std::size_t index = cellItems_[k];
+            float t = 0.0f;
+            if (intersectBox(boxes_[index], start, delta, t) && (!found || t < hit.t)) {
+                hit = {t, index};
+                found = true;
+            }
+        }
+        // 命中点已在当前格子内：后面的格子不可能更近
+        return !(found && hit.t <= tExit);
+    });
+    return found;
+}
+
+void ObstacleGrid::query(const sf::Vector2f& min, const sf::Vector2f& max,
+                         std::vector<std::size_t>& out) const {
+    out.clear();
+    if (boxes_.empty()) return;
+    for (int y = cellY(min.y); y <= cellY(max.y); ++y) {
+        for (int x = cellX(min.x); x <= cellX(max.x); ++x) {
+            std::size_t cell = static_cast<std::size_t>(y) * cols_ + x;
+            for (std::size_t k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+                const Box& box = boxes_[cellItems_[k]];
+                if (box.max.x >= min.x && box.min.x <= max.x &&
+                    box.max.y >= min.y && box.min.y <= max.y) {
+                    out.push_back(cellItems_[k]);
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
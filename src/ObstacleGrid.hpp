@@ -0,0 +1,75 @@
+// AI 障碍物空间索引：静态盒子的均匀网格（盒子可以旋转）
+// 每次关卡布局分析时整体重建一次；射线/线段查询用 DDA 逐格遍历（按外接 AABB 入格），
+// 交点在盒子自身坐标系内用 slab 法精确求解
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include "Config.hpp"
+
+class ObstacleGrid {
+public:
+    // min/max 为外接 AABB（入格与 query 使用）；axis 不是 (1, 0) 时盒子带朝向，
+    // 线段求交在以 center 为原点、axis 为 x 轴的局部坐标系内对 [-halfSize, halfSize] 进行
+    struct Box {
+        sf::Vector2f min;
+        sf::Vector2f max;
+        sf::Vector2f center;
+        sf::Vector2f halfSize;
+        sf::Vector2f axis{1.0f, 0.0f};  // 局部 x 轴（单位向量）
+
+        // 中心 center、未旋转宽高 size、旋转 angle（弧度）的盒子
+        static Box oriented(const sf::Vector2f& center, const sf::Vector2f& size, float angle);
+    };
+
+    // 线段命中：t 为线段参数（0 = 起点，1 = 终点），index 为 build 时的盒子下标
+    struct Hit {
+        float t{0.0f};
+        std::size_t index{0};
+    };
+
+    // 重建索引（清空旧数据）
+    void build(std::vector<Box> boxes, float cellSize = config::kAIObstacleGridCellSize);
+    void clear();
+
+    bool empty() const { return boxes_.empty(); }
+    std::size_t size() const { return boxes_.size(); }
+    const Box& box(std::size_t index) const { return boxes_[index]; }
+
+    // 线段 start->end 穿过的所有盒子，按进入点 t 升序写入 hits（每个盒子只出现一次）
+    void raycast(const sf::Vector2f& start, const sf::Vector2f& end, std::vector<Hit>& hits) const;
+
+    // 线段最先进入的盒子；沿线段逐格推进，找到比当前格子出口更近的命中即提前返回
+    bool firstHit(const sf::Vector2f& start, const sf::Vector2f& end, Hit& hit) const;
+
+    // 外接 AABB 与矩形 [min, max] 重叠的盒子下标（无重复，顺序不保证）
+    void query(const sf::Vector2f& min, const sf::Vector2f& max, std::vector<std::size_t>& out) const;
+
+    // slab 法线段-AABB 相交（只看 min/max）：delta = end - start，命中时 tEnter 为进入参数（起点在盒内时为 0）
+    static bool intersectSegment(const Box& box, const sf::Vector2f& start,
+                                 const sf::Vector2f& delta, float& tEnter);
+
+    // 线段与盒子本体相交：带朝向的盒子先变换到局部坐标系再做 slab 检测，参数含义同上
+    static bool intersectBox(const Box& box, const sf::Vector2f& start,
+                             const sf::Vector2f& delta, float& tEnter);
+
+private:
+    // 对线段经过的每个格子调用 visit(cellIndex, tCellExit)，visit 返回 false 时停止
+    template <typename Visit>
+    void traverse(const sf::Vector2f& start, const sf::Vector2f& end, Visit&& visit) const;
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+    std::vector<Box> boxes_;
+    // CSR 布局：cellStart_[c] .. cellStart_[c + 1] 是格子 c 在 cellItems_ 中的盒子下标区间
+    std::vector<std::size_t> cellStart_;
+    std::vector<std::size_t> cellItems_;
+    sf::Vector2f origin_;
+    float cellSize_{config::kAIObstacleGridCellSize};
+    int cols_{0};
+    int rows_{0};
+};
@@ -19,6 +19,13 @@ sf::Vector2f PhysicsBody::velocity() const {
     return PhysicsWorld::meterToPixel(body_->GetLinearVelocity());
 }
 
+void PhysicsBody::release() {
+    if (owner_ && body_) {
+        owner_->destroyBody(*this);
+    }
+    owner_ = nullptr;
+}
+
 float PhysicsBody::angle() const {
     return body_ ? body_->GetAngle() : 0.0f;
 }
@@ -27,6 +34,10 @@ bool PhysicsBody::active() const {
     return body_ && body_->IsEnabled();
 }
 
+bool PhysicsBody::awake() const {
+    return body_ && body_->IsAwake();
+}
+
 bool PhysicsBody::dynamic() const {
     return body_ && body_->GetType() == b2_dynamicBody;
 }
@@ -35,6 +46,14 @@ float PhysicsBody::hitStrength() const {
     return userData_ ? userData_->hitStrength : 0.0f;
 }
 
+double PhysicsBody::worldTime() const {
+    return owner_ ? owner_->time() : 0.0;
+}
+
+void PhysicsBody::setNeedsUpdate(bool needsUpdate) {
+    if (userData_) userData_->needsUpdate = needsUpdate;
+}
+
 bool PhysicsBody::isBird() const {
     return userData_ && userData_->isBird;
 }
@@ -49,6 +68,22 @@ void PhysicsBody::setPosition(const sf::Vector2f& pos) {
     }
 }
 
+void PhysicsBody::setTransform(const sf::Vector2f& pos, float angle) {
+    if (body_) {
+        body_->SetTransform(PhysicsWorld::pixelToMeter(pos), angle);
+    }
+}
+
+void PhysicsBody::setAwake(bool awake) {
+    if (body_) {
+        body_->SetAwake(awake);
+    }
+}
+
+float PhysicsBody::angularVelocity() const {
+    return body_ ? body_->GetAngularVelocity() : 0.0f;
+}
+
 void PhysicsBody::setVelocity(const sf::Vector2f& vel) {
     if (body_) {
         body_->SetLinearVelocity(PhysicsWorld::pixelToMeter(vel));
@@ -88,8 +123,47 @@ void PhysicsBody::setDynamic(bool dynamic) {
 
 // ========== DamageContactListener implementation ==========
 
+namespace {
+// 小鸟撞击：接近速度超过此值（像素/秒）的部分才计入 hitStrength
+constexpr float kBirdImpactDeadZone = 6.0f;
+
+// 沿接触法线的接近速度（像素/秒）；分离中的接触返回 0
+float approachSpeed(b2Contact* contact, const b2Vec2& relativeVel) {
+    b2WorldManifold worldManifold;
+    contact->GetWorldManifold(&worldManifold);
+    float velAlongNormal = b2Dot(relativeVel, worldManifold.normal);
+    return velAlongNormal < 0.0f ? -velAlongNormal * config::kPixelsPerMeter : 0.0f;
+}
+
+// 按材质编号查伤害参数：启动时由材质名算好一次，结算时只做数组索引
+struct MaterialDamage {
+    float strength;
+    float multiplier;
+};
+
+const MaterialDamage& materialDamage(std::uint32_t id) {
+    static const std::vector<MaterialDamage> kTable = [] {
+        std::vector<MaterialDamage> table;
+        for (const auto& name : materialIdTable()) {
+            table.push_back({config::getMaterialStrength(name), config::getDamageMultiplier(name)});
+        }
+        return table;
+    }();
+    static const MaterialDamage kDefault{config::getMaterialStrength(""), config::getDamageMultiplier("")};
+    return id < kTable.size() ? kTable[id] : kDefault;
+}
+
+bool isStoneMaterial(std::uint32_t id) {
+    return id == material_id::kStone || id == material_id::kStoneslab;
+}
+}  // namespace
+
+DamageContactListener::DamageContactListener(EntityTable& entities) : entities_(&entities) {
+    events_.reserve(static_cast<std::size_t>(config::kContactEventReserve));
+}
+
 void DamageContactListener::BeginContact(b2Contact* contact) {
-    // Damage calculation happens in PreSolve for more accurate impact speed
+    // Damage calculation happens after the step from events recorded in PreSolve
 }
 
 void DamageContactListener::PreSolve(b2Contact* contact, const b2Manifold* oldManifold) {
@@ -104,194 +178,145 @@ void DamageContactListener::PreSolve(b2Contact* contact, const b2Manifold* oldMa
     b2Body* bodyA = fixtureA->GetBody();
     b2Body* bodyB = fixtureB->GetBody();
 
-    // Check if one body is on the ground (environment)
-    bool bodyAOnGround = dataA->environment || dataB->environment;
-    bool bodyBOnGround = dataB->environment || dataA->environment;
-    
-    // Apply ground friction for objects rolling on ground - stronger friction for all speeds
-    if (bodyAOnGround && bodyA->GetType() == b2_dynamicBody) {
-        b2Vec2 vel = bodyA->GetLinearVelocity();
-        float speed = vel.Length();
-        if (speed > 0.0f) {
-            // Apply stronger friction based on speed
-            // Faster objects get less friction, slower objects get more friction
-            float frictionFactor = 0.92f;  // Base friction (8% reduction per frame)
-            if (speed < PhysicsWorld::pixelToMeter(50.0f)) {
-                frictionFactor = 0.85f;  // Stronger friction for slow objects (15% reduction)
-            } else if (speed < PhysicsWorld::pixelToMeter(100.0f)) {
-                frictionFactor = 0.90f;  // Medium friction (10% reduction)
-            }
-            bodyA->SetLinearVelocity(frictionFactor * vel);  // Box2D requires float * b2Vec2
+    // Objects touching the ground (environment) get ground friction after the step
+    if (dataA->environment || dataB->environment) {
+        if (bodyA->GetType() == b2_dynamicBody) {
+            events_.push_back({ContactEvent::Kind::GroundFriction, bodyA, nullptr, dataA, nullptr, 0.0f});
         }
-    }
-    if (bodyBOnGround && bodyB->GetType() == b2_dynamicBody) {
-        b2Vec2 vel = bodyB->GetLinearVelocity();
-        float speed = vel.Length();
-        if (speed > 0.0f) {
-            float frictionFactor = 0.92f;  // Base friction
-            if (speed < PhysicsWorld::pixelToMeter(50.0f)) {
-                frictionFactor = 0.85f;  // Stronger friction for slow objects
-            } else if (speed < PhysicsWorld::pixelToMeter(100.0f)) {
-                frictionFactor = 0.90f;  // Medium friction
-            }
-            bodyB->SetLinearVelocity(frictionFactor * vel);  // Box2D requires float * b2Vec2
+        if (bodyB->GetType() == b2_dynamicBody) {
+            events_.push_back({ContactEvent::Kind::GroundFriction, bodyB, nullptr, dataB, nullptr, 0.0f});
         }
+        return;  // No damage against environment
     }
-
-    // Skip if either is environment or bird (bird damage is handled separately)
-    if (dataA->environment || dataB->environment) return;
     // Skip damage if either entity is in editor mode
     if (dataA->isEditorEntity || dataB->isEditorEntity) return;
-    if (dataA->isBird || dataB->isBird) {
-        // Handle bird collisions (legacy system)
-        b2Vec2 velA = bodyA->GetLinearVelocity();
-        b2Vec2 velB = bodyB->GetLinearVelocity();
-        b2Vec2 relativeVel = velB - velA;
-        b2WorldManifold worldManifold;
-        contact->GetWorldManifold(&worldManifold);
-        b2Vec2 normal = worldManifold.normal;
-        float velAlongNormal = b2Dot(relativeVel, normal);
-        if (velAlongNormal > 0.0f) return;
-        float impactSpeed = -velAlongNormal * config::kPixelsPerMeter;
-        float damageSpeed = std::max(0.0f, impactSpeed - 6.0f);
-        float impact = damageSpeed * 4.0f;
-        if (impact > 0.0f) {
-            if (dataA->isBird && !dataB->isBird) {
-                dataB->hitStrength = std::max(dataB->hitStrength, impact);
-                float slowFactor = 1.0f - std::min(0.8f, impact / 400.0f);
-                bodyA->SetLinearVelocity(slowFactor * velA);
-            } else if (dataB->isBird && !dataA->isBird) {
-                dataA->hitStrength = std::max(dataA->hitStrength, impact);
-                float slowFactor = 1.0f - std::min(0.8f, impact / 400.0f);
-                bodyB->SetLinearVelocity(slowFactor * velB);
-            }
+    if (dataA->isBird && dataB->isBird) return;
+
+    // 接近速度不会超过相对速度的大小：先用相对速度粗筛，静止堆叠的接触不取世界流形
+    const bool birdContact = dataA->isBird || dataB->isBird;
+    const float threshold = birdContact ? kBirdImpactDeadZone : config::damage_speed_threshold::kMinDamageSpeed;
+    b2Vec2 relativeVel = bodyB->GetLinearVelocity() - bodyA->GetLinearVelocity();
+    const float thresholdMeters = threshold / config::kPixelsPerMeter;
+    if (relativeVel.LengthSquared() < thresholdMeters * thresholdMeters) return;
+
+    float impactSpeed = approachSpeed(contact, relativeVel);
+    if (birdContact) {
+        if (impactSpeed <= kBirdImpactDeadZone) return;
+        // 统一记录为 bodyA = 小鸟，bodyB = 被撞的刚体
+        if (dataA->isBird) {
+            events_.push_back({ContactEvent::Kind::BirdImpact, bodyA, bodyB, dataA, dataB, impactSpeed});
+        } else {
+            events_.push_back({ContactEvent::Kind::BirdImpact, bodyB, bodyA, dataB, dataA, impactSpeed});
         }
         return;
     }
 
-    // Both are non-bird, non-environment objects (blocks or pigs)
-    // Calculate collision damage
-    b2Vec2 velA = bodyA->GetLinearVelocity();
-    b2Vec2 velB = bodyB->GetLinearVelocity();
-    b2Vec2 relativeVel = velB - velA;
-
-    // Get contact normal
-    b2WorldManifold worldManifold;
-    contact->GetWorldManifold(&worldManifold);
-    b2Vec2 normal = worldManifold.normal;
-
-    // Project relative velocity onto normal
-    float velAlongNormal = b2Dot(relativeVel, normal);
-
-    // Only process collisions where objects are closing
-    if (velAlongNormal > 0.0f) return;
-
-    // Convert to pixel space for damage calculation
-    float impactSpeed = -velAlongNormal * config::kPixelsPerMeter;  // m/s -> pixels/s
-    
     // Minimum speed threshold for damage
     if (impactSpeed < config::damage_speed_threshold::kMinDamageSpeed) return;
+    events_.push_back({ContactEvent::Kind::Impact, bodyA, bodyB, dataA, dataB, impactSpeed});
+}
 
-    // Get entity pointers
-    Block* blockA = nullptr;
-    Block* blockB = nullptr;
-    Pig* pigA = nullptr;
-    Pig* pigB = nullptr;
-    
-    if (dataA->entityPtr) {
-        blockA = dynamic_cast<Block*>(static_cast<Entity*>(dataA->entityPtr));
-        if (!blockA) pigA = dynamic_cast<Pig*>(static_cast<Entity*>(dataA->entityPtr));
+void DamageContactListener::resolve(double now) {
+    // 按 Box2D 回调顺序处理，结果与线程、内存布局无关
+    for (const ContactEvent& event : events_) {
+        switch (event.kind) {
+            case ContactEvent::Kind::GroundFriction: resolveGroundFriction(event.bodyA); break;
+            case ContactEvent::Kind::BirdImpact: resolveBirdImpact(event); break;
+            case ContactEvent::Kind::Impact: resolveImpact(event, now); break;
+        }
     }
-    if (dataB->entityPtr) {
-        blockB = dynamic_cast<Block*>(static_cast<Entity*>(dataB->entityPtr));
-        if (!blockB) pigB = dynamic_cast<Pig*>(static_cast<Entity*>(dataB->entityPtr));
+    events_.clear();
+}
+
+void DamageContactListener::resolveGroundFriction(b2Body* body) {
+    // Apply stronger friction for objects rolling on ground
+    b2Vec2 vel = body->GetLinearVelocity();
+    float speed = vel.Length();
+    if (speed > 0.0f) {
+        // Faster objects get less friction, slower objects get more friction
+        float frictionFactor = config::groundFriction::kBase;  // Base friction (8% reduction per frame)
+        if (speed < PhysicsWorld::pixelToMeter(config::groundFriction::kSlowSpeed)) {
+            frictionFactor = config::groundFriction::kSlow;  // Stronger friction for slow objects (15% reduction)
+        } else if (speed < PhysicsWorld::pixelToMeter(config::groundFriction::kMediumSpeed)) {
+            frictionFactor = config::groundFriction::kMedium;  // Medium friction (10% reduction)
+        }
+        body->SetLinearVelocity(frictionFactor * vel);  // Box2D requires float * b2Vec2
     }
+}
+
+void DamageContactListener::resolveBirdImpact(const ContactEvent& event) {
+    // Handle bird collisions (legacy system)
+    float impact = (event.impactSpeed - kBirdImpactDeadZone) * 4.0f;
+    event.dataB->hitStrength = std::max(event.dataB->hitStrength, impact);
+    float slowFactor = 1.0f - std::min(0.8f, impact / 400.0f);
+    event.bodyA->SetLinearVelocity(slowFactor * event.bodyA->GetLinearVelocity());
+}
+
+void DamageContactListener::resolveImpact(const ContactEvent& event, double now) {
+    // Both are non-bird, non-environment objects (blocks or pigs)
+    EntityTable& table = *entities_;
+    if (!table.contains(event.dataA->handle) || !table.contains(event.dataB->handle)) return;
+
+    const float impactSpeed = event.impactSpeed;
+    const float speedMultiplier = config::getSpeedDamageMultiplier(impactSpeed);
+    const std::uint32_t rowA = table.row(event.dataA->handle);
+    const std::uint32_t rowB = table.row(event.dataB->handle);
+    const EntityKind kindA = table.kind(rowA);
+    const EntityKind kindB = table.kind(rowB);
 
     // Determine collision type and calculate damage
-    if (blockA && blockB) {
+    if (kindA == EntityKind::Block && kindB == EntityKind::Block) {
         // Block-to-block collision
-        std::string materialA = blockA->material().name;
-        std::string materialB = blockB->material().name;
+        const std::uint32_t materialA = table.materialId(rowA);
+        const std::uint32_t materialB = table.materialId(rowB);
         
-        float strengthA = config::getMaterialStrength(materialA);
-        float strengthB = config::getMaterialStrength(materialB);
-        float multiplierA = config::getDamageMultiplier(materialA);
-        float multiplierB = config::getDamageMultiplier(materialB);
-            // Reduce outgoing damage from stone variants against buildings by 30%
-            if (materialA == "stone" || materialA == "stoneslab") {
-                multiplierA *= 0.7f;
-            }
-            if (materialB == "stone" || materialB == "stoneslab") {
-                multiplierB *= 0.7f;
-            }
-        float speedMultiplier = config::getSpeedDamageMultiplier(impactSpeed);
+        float strengthA = materialDamage(materialA).strength;
+        float strengthB = materialDamage(materialB).strength;
+        float multiplierA = materialDamage(materialA).multiplier;
+        float multiplierB = materialDamage(materialB).multiplier;
+        // Reduce outgoing damage from stone variants against buildings by 30%
+        if (isStoneMaterial(materialA)) multiplierA *= 0.7f;
+        if (isStoneMaterial(materialB)) multiplierB *= 0.7f;
         
         float baseDamage = config::damage_base::kBlockToBlock * speedMultiplier;
         
         if (materialA == materialB) {
             // Same material: both take damage
-            float damageA = baseDamage * multiplierB;
-            float damageB = baseDamage * multiplierA;
-            blockA->takeDamage(damageA);
-            blockB->takeDamage(damageB);
+            table.applyDamage(rowA, baseDamage * multiplierB, now);
+            table.applyDamage(rowB, baseDamage * multiplierA, now);
         } else {
             // Different materials: only weaker one takes damage
             if (strengthA < strengthB) {
-                float damage = baseDamage * multiplierB;
-                blockA->takeDamage(damage);
+                table.applyDamage(rowA, baseDamage * multiplierB, now);
             } else if (strengthB < strengthA) {
-                float damage = baseDamage * multiplierA;
-                blockB->takeDamage(damage);
-            }
-        }
-    } else if (blockA && pigB) {
-        // Block-to-pig collision
-        std::string materialA = blockA->material().name;
-        float multiplierA = config::getDamageMultiplier(materialA);
-            // Reduce stone variants' damage to pigs by 50%
-            if (materialA == "stone" || materialA == "stoneslab") {
-                multiplierA *= 0.5f;
+                table.applyDamage(rowB, baseDamage * multiplierA, now);
             }
-        float speedMultiplier = config::getSpeedDamageMultiplier(impactSpeed);
-        
-        // Special case: glass never kills pigs
-        if (materialA == "glass") {
-            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplierA * 0.3f;  // Reduced damage
-            pigB->takeDamage(damage);
-        } else {
-            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplierA;
-            pigB->takeDamage(damage);
-            // Block also takes damage from pig
-            float blockDamage = config::damage_base::kBlockToPig * speedMultiplier * config::damage_multiplier::kPig * 0.5f;
-            blockA->takeDamage(blockDamage);
         }
-    } else if (blockB && pigA) {
-        // Pig-to-block collision (same as block-to-pig)
-        std::string materialB = blockB->material().name;
-        float multiplierB = config::getDamageMultiplier(materialB);
-            // Reduce stone variants' damage to pigs by 50%
-            if (materialB == "stone" || materialB == "stoneslab") {
-                multiplierB *= 0.5f;
-            }
-        float speedMultiplier = config::getSpeedDamageMultiplier(impactSpeed);
+    } else if (kindA != kindB) {
+        // Block-to-pig collision (either order)
+        const std::uint32_t blockRow = kindA == EntityKind::Block ? rowA : rowB;
+        const std::uint32_t pigRow = kindA == EntityKind::Block ? rowB : rowA;
+        const std::uint32_t material = table.materialId(blockRow);
+        float multiplier = materialDamage(material).multiplier;
+        // Reduce stone variants' damage to pigs by 50%
+        if (isStoneMaterial(material)) multiplier *= 0.5f;
         
         // Special case: glass never kills pigs
-        if (materialB == "glass") {
-            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplierB * 0.3f;  // Reduced damage
-            pigA->takeDamage(damage);
+        if (material == material_id::kGlass) {
+            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplier * 0.3f;  // Reduced damage
+            table.applyDamage(pigRow, damage, now);
         } else {
-            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplierB;
-            pigA->takeDamage(damage);
+            float damage = config::damage_base::kBlockToPig * speedMultiplier * multiplier;
+            table.applyDamage(pigRow, damage, now);
             // Block also takes damage from pig
             float blockDamage = config::damage_base::kBlockToPig * speedMultiplier * config::damage_multiplier::kPig * 0.5f;
-            blockB->takeDamage(blockDamage);
+            table.applyDamage(blockRow, blockDamage, now);
         }
-    } else if (pigA && pigB) {
+    } else {
         // Pig-to-pig collision
-        float speedMultiplier = config::getSpeedDamageMultiplier(impactSpeed);
         float damage = config::damage_base::kPigToPig * speedMultiplier;
-        pigA->takeDamage(damage);
-        pigB->takeDamage(damage);
+        table.applyDamage(rowA, damage, now);
+        table.applyDamage(rowB, damage, now);
     }
 }
 
@@ -299,7 +324,8 @@ void DamageContactListener::PreSolve(b2Contact* contact, const b2Manifold* oldMa
 
 PhysicsWorld::PhysicsWorld(const sf::Vector2f& gravity)
     : world_(std::make_unique<b2World>(pixelToMeter(gravity))),
-      contactListener_(std::make_unique<DamageContactListener>()) {
+      entities_(std::make_unique<EntityTable>()),
+      contactListener_(std::make_unique<DamageContactListener>(*entities_)) {
     world_->SetContactListener(contactListener_.get());
     // Box2D default settings are good, but we can tune if needed
     world_->SetContinuousPhysics(true);  // Better collision detection for fast objects
@@ -307,6 +333,24 @@ PhysicsWorld::PhysicsWorld(const sf::Vector2f& gravity)
 
 PhysicsWorld::~PhysicsWorld() = default;
 
+void PhysicsWorld::reset(const sf::Vector2f& gravity) {
+    // b2World 本身重新创建：复用旧世界时宽相位代理 ID 的分配顺序取决于之前的关卡，
+    // 会让同一关卡的重试结果依赖历史（AI 批量重试需要可复现）
+    world_ = std::make_unique<b2World>(pixelToMeter(gravity));
+    world_->SetContactListener(contactListener_.get());
+    world_->SetContinuousPhysics(true);
+
+    bodies_.clear();
+    pendingDestroy_.clear();
+    entities_->clear();
+    time_ = 0.0;
+    // 所有用户数据槽位重新回到空闲表（包括没有实体持有的地面等刚体）
+    freeUserData_.clear();
+    for (FixtureUserData& data : userDataPool_) {
+        freeUserData_.push_back(&data);
+    }
+}
+
 PhysicsBody PhysicsWorld::createBoxBody(const sf::Vector2f& pos, const sf::Vector2f& size,
                                          float density, float friction, float restitution,
                                          bool isDynamic, bool isBird, bool isEnvironment,
@@ -361,19 +405,7 @@ PhysicsBody PhysicsWorld::createBoxBody(const sf::Vector2f& pos, const sf::Vecto
     fixtureDef.isSensor = false;
     b2Fixture* fixture = body->CreateFixture(&fixtureDef);
 
-    // Create and attach user data
-    auto userData = std::make_unique<FixtureUserData>();
-    userData->isBird = isBird;
-    userData->environment = isEnvironment;
-    userData->isEditorEntity = isEditorEntity;
-    userData->entityPtr = entityPtr;
-    fixture->GetUserData().pointer = reinterpret_cast<uintptr_t>(userData.get());
-    userDataStorage_.push_back(std::move(userData));
-
-    PhysicsBody result;
-    result.body_ = body;
-    result.userData_ = userDataStorage_.back().get();
-    return result;
+    return registerBody(body, fixture, isBird, isEnvironment, entityPtr, isEditorEntity);
 }
 
 PhysicsBody PhysicsWorld::createCircleBody(const sf::Vector2f& pos, float radius,
@@ -404,76 +436,181 @@ PhysicsBody PhysicsWorld::createCircleBody(const sf::Vector2f& pos, float radius
     fixtureDef.restitution = restitution;
     b2Fixture* fixture = body->CreateFixture(&fixtureDef);
 
+    return registerBody(body, fixture, isBird, isEnvironment, entityPtr, isEditorEntity);
+}
+
+PhysicsBody PhysicsWorld::registerBody(b2Body* body, b2Fixture* fixture, bool isBird, bool isEnvironment,
+                                      void* entityPtr, bool isEditorEntity) {
     // Create and attach user data
-    auto userData = std::make_unique<FixtureUserData>();
+    FixtureUserData* userData = acquireUserData();
     userData->isBird = isBird;
     userData->environment = isEnvironment;
     userData->isEditorEntity = isEditorEntity;
     userData->entityPtr = entityPtr;
-    fixture->GetUserData().pointer = reinterpret_cast<uintptr_t>(userData.get());
-    userDataStorage_.push_back(std::move(userData));
+    fixture->GetUserData().pointer = reinterpret_cast<uintptr_t>(userData);
+
+    BodyRecord record;
+    record.body = body;
+    record.data = userData;
+    record.maxSpeed = isBird ? 0.0f : pixelToMeter(config::kMaxBodySpeed);
+    body->GetUserData().pointer = static_cast<uintptr_t>(bodies_.size());
+    bodies_.push_back(record);
 
     PhysicsBody result;
     result.body_ = body;
-    result.userData_ = userDataStorage_.back().get();
+    result.userData_ = userData;
+    result.owner_ = this;
     return result;
 }
 
-void PhysicsWorld::step(float dt) {
-    // Clear hit strength each frame
-    for (auto& data : userDataStorage_) {
-        data->hitStrength = 0.0f;
+FixtureUserData* PhysicsWorld::acquireUserData() {
+    if (!freeUserData_.empty()) {
+        FixtureUserData* data = freeUserData_.back();
+        freeUserData_.pop_back();
+        *data = FixtureUserData{};
+        return data;
     }
+    return &userDataPool_.emplace_back();
+}
 
-    // Clamp velocities to max speed - but this is now handled per-bird in Bird class
-    // We still need global clamp for non-bird objects
-    for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext()) {
-        if (body->GetType() != b2_dynamicBody) continue;
-        
-        // Check if this is a bird (has user data with isBird flag)
-        bool isBird = false;
-        b2Fixture* fixture = body->GetFixtureList();
-        while (fixture) {
-            FixtureUserData* data = reinterpret_cast<FixtureUserData*>(
-                fixture->GetUserData().pointer);
-            if (data && data->isBird) {
-                isBird = true;
-                break;
-            }
-            fixture = fixture->GetNext();
+void PhysicsWorld::destroyBody(PhysicsBody& body) {
+    if (!body.body_) return;
+    if (world_->IsLocked()) {
+        // 在 Step 回调中（例如接触监听器）不能销毁刚体，先排队
+        pendingDestroy_.emplace_back(body.body_, body.userData_);
+    } else {
+        destroyNow(body.body_, body.userData_);
+    }
+    body.body_ = nullptr;
+    body.userData_ = nullptr;
+}
+
+void PhysicsWorld::destroyNow(b2Body* body, FixtureUserData* data) {
+    // 交换删除侧表记录，并修正被移动记录的下标
+    std::size_t index = static_cast<std::size_t>(body->GetUserData().pointer);
+    if (index < bodies_.size() && bodies_[index].body == body) {
+        bodies_[index] = bodies_.back();
+        bodies_[index].body->GetUserData().pointer = static_cast<uintptr_t>(index);
+        bodies_.pop_back();
+    }
+    world_->DestroyBody(body);
+    if (data) {
+        freeUserData_.push_back(data);
+    }
+}
+
+float PhysicsWorld::kineticEnergy() const {
+    float energy = 0.0f;
+    for (const b2Body* body = world_->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() != b2_dynamicBody || !body->IsEnabled() || !body->IsAwake()) continue;
+        const b2Vec2& v = body->GetLinearVelocity();
+        float w = body->GetAngularVelocity();
+        energy += 0.5f * body->GetMass() * (v.x * v.x + v.y * v.y) + 0.5f * body->GetInertia() * w * w;
+    }
+    return energy;
+}
+
+int PhysicsWorld::awakeDynamicBodyCount() const {
+    int count = 0;
+    for (const b2Body* body = world_->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() == b2_dynamicBody && body->IsEnabled() && body->IsAwake()) ++count;
+    }
+    return count;
+}
+
+int PhysicsWorld::dynamicBodyCount() const {
+    int count = 0;
+    for (const b2Body* body = world_->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() == b2_dynamicBody && body->IsEnabled()) ++count;
+    }
+    return count;
+}
+
+namespace {
+// 收集与查询包围盒相交的刚体（一个刚体可能有多个夹具，需去重）
+class BodyQueryCallback : public b2QueryCallback {
+public:
+    explicit BodyQueryCallback(std::vector<b2Body*>& out) : out_(out), begin_(out.size()) {}
+
+    bool ReportFixture(b2Fixture* fixture) override {
+        b2Body* body = fixture->GetBody();
+        if (std::find(out_.begin() + begin_, out_.end(), body) == out_.end()) {
+            out_.push_back(body);
         }
-        
-        // For birds, max speed is handled in Bird class, skip global clamp
-        // For non-birds, use global max speed
-        if (!isBird) {
-            b2Vec2 vel = body->GetLinearVelocity();
-            float speedSq = vel.x * vel.x + vel.y * vel.y;
-            float maxSpeedMeters = pixelToMeter(config::kMaxBodySpeed);
-            if (speedSq > maxSpeedMeters * maxSpeedMeters) {
-                float speed = std::sqrt(speedSq);
-                body->SetLinearVelocity((maxSpeedMeters / speed) * vel);
-            }
+        return true;  // 继续查询
+    }
+
+private:
+    std::vector<b2Body*>& out_;
+    std::size_t begin_;
+};
+}  // namespace
+
+void PhysicsWorld::queryAABB(const sf::Vector2f& lower, const sf::Vector2f& upper, std::vector<b2Body*>& out) const {
+    b2AABB aabb;
+    aabb.lowerBound = pixelToMeter(lower);
+    aabb.upperBound = pixelToMeter(upper);
+    BodyQueryCallback callback(out);
+    world_->QueryAABB(&callback, aabb);
+}
+
+void PhysicsWorld::queryRadius(const sf::Vector2f& center, float radius, std::vector<b2Body*>& out) const {
+    const std::size_t begin = out.size();
+    queryAABB(center - sf::Vector2f(radius, radius), center + sf::Vector2f(radius, radius), out);
+
+    // 宽相位只保证包围盒相交，这里按刚体原点到圆心的距离精确筛选
+    const float radiusSq = radius * radius;
+    auto outside = [&](b2Body* body) {
+        sf::Vector2f delta = meterToPixel(body->GetPosition()) - center;
+        return delta.x * delta.x + delta.y * delta.y >= radiusSq;
+    };
+    out.erase(std::remove_if(out.begin() + begin, out.end(), outside), out.end());
+}
+
+void PhysicsWorld::step(float dt) {
+    // 单次线性遍历侧表：清零上一帧的 hitStrength，并对非鸟动态刚体做全局限速
+    // （鸟的最大速度由 Bird 类按类型处理，侧表中 maxSpeed 为 0）
+    for (const BodyRecord& record : bodies_) {
+        record.data->hitStrength = 0.0f;
+        if (record.maxSpeed <= 0.0f) continue;
+
+        b2Body* body = record.body;
+        if (body->GetType() != b2_dynamicBody) continue;
+        b2Vec2 vel = body->GetLinearVelocity();
+        float speedSq = vel.x * vel.x + vel.y * vel.y;
+        if (speedSq > record.maxSpeed * record.maxSpeed) {
+            float speed = std::sqrt(speedSq);
+            body->SetLinearVelocity((record.maxSpeed / speed) * vel);
         }
     }
 
     // Step the physics simulation with more position iterations for better collision resolution
     // Increased iterations to prevent overlaps, especially for stone/stoneslab blocks
-    int32 velocityIterations = 10;   // Increased from 8
-    int32 positionIterations = 40;  // Increased from 30 for better overlap resolution, especially for stoneslab ends
-    world_->Step(dt, velocityIterations, positionIterations);
+    world_->Step(dt, config::kVelocityIterations, config::kPositionIterations);
+    // 求解器回调只记录事件：摩擦、小鸟减速与伤害在这里统一处理（实体 update 之前，hitStrength 已就绪）
+    contactListener_->resolve(time_);
+    time_ += dt;
+    clearInactive();
+}
+
+void PhysicsWorld::collectAwakeEntities(std::vector<Entity*>& out) const {
+    out.clear();
+    // 只读紧凑侧表与 b2Body 的休眠标志；Box2D 在接触时会唤醒被撞的休眠刚体，
+    // 爆炸冲量同样带唤醒，因此休眠刚体不会漏掉伤害
+    for (const BodyRecord& record : bodies_) {
+        const FixtureUserData* data = record.data;
+        if (!data->entityPtr || data->isBird || data->environment) continue;
+        if (data->needsUpdate || data->hitStrength > 0.0f || record.body->IsAwake()) {
+            out.push_back(static_cast<Entity*>(data->entityPtr));
+        }
+    }
 }
 
 void PhysicsWorld::clearInactive() {
-    // Box2D handles body destruction automatically when we delete them
-    // We just need to clean up our user data storage
-    userDataStorage_.erase(
-        std::remove_if(userDataStorage_.begin(), userDataStorage_.end(),
-                       [](const std::unique_ptr<FixtureUserData>& data) {
-                           // Check if the body still exists
-                           // This is a simplified check - in practice you'd track this better
-                           return false;  // Keep all for now, proper cleanup would require body tracking
-                       }),
-        userDataStorage_.end());
+    for (const auto& [body, data] : pendingDestroy_) {
+        destroyNow(body, data);
+    }
+    pendingDestroy_.clear();
 }
 
 // ========== Conversion functions ==========
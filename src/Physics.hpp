@@ -5,10 +5,14 @@
 #include <box2d/box2d.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "EntityTable.hpp"
+
 // User data attached to Box2D fixtures for damage tracking
 struct FixtureUserData {
     float hitStrength{0.0f};
@@ -16,25 +20,42 @@ struct FixtureUserData {
     bool environment{false};
     bool isEditorEntity{false};  // True if entity is in level editor (no damage)
     void* entityPtr{nullptr};  // Pointer back to Entity for damage queries
+    bool needsUpdate{true};    // 实体请求继续逐帧更新（受击闪烁等）；新建刚体默认需要一次更新
+    EntityHandle handle;       // 方块/猪在 EntityTable 中的句柄（其他刚体无效）
 };
 
+class Entity;
+class PhysicsWorld;
+
 // Wrapper around Box2D body that maintains compatibility with existing code
+// 句柄本身不拥有刚体：由持有它的实体在析构时调用 release() 归还给所属 PhysicsWorld
 class PhysicsBody {
 public:
     b2Body* body_{nullptr};
     FixtureUserData* userData_{nullptr};
+    PhysicsWorld* owner_{nullptr};
+
+    void release();  // 销毁刚体并回收用户数据（Step 期间调用时延迟到 Step 结束）
 
     // Compatibility interface
     sf::Vector2f position() const;
     sf::Vector2f velocity() const;
     float angle() const;
+    float angularVelocity() const;  // 弧度/秒
     bool active() const;
+    bool awake() const;   // Box2D 休眠状态：休眠刚体在被唤醒前不会移动
     bool dynamic() const;
     float hitStrength() const;
     bool isBird() const;
     bool environment() const;
+    double worldTime() const;  // 所属世界已推进的模拟时间（秒）
+
+    // 实体是否要求在刚体休眠时仍被更新（见 PhysicsWorld::collectAwakeEntities）
+    void setNeedsUpdate(bool needsUpdate);
 
     void setPosition(const sf::Vector2f& pos);
+    void setTransform(const sf::Vector2f& pos, float angle);  // 同时设置位置与角度（弧度）
+    void setAwake(bool awake);
     void setVelocity(const sf::Vector2f& vel);
     void setMass(float mass, float density = 1.0f);
     void applyForce(const sf::Vector2f& force);
@@ -44,10 +65,36 @@ public:
 };
 
 // Box2D contact listener for damage calculation
+// 求解器回调内只做筛选和记录：静止接触（相对速度达不到伤害阈值）在取世界流形之前就被丢弃，
+// 其余写入预分配的事件缓冲；地面摩擦、小鸟减速和伤害在 world->Step 之后由 resolve() 按记录顺序统一处理
 class DamageContactListener : public b2ContactListener {
 public:
+    explicit DamageContactListener(EntityTable& entities);
+
     void BeginContact(b2Contact* contact) override;
     void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
+
+    // 处理并清空本步记录的事件（PhysicsWorld::step 在 Step 之后调用；now 为本步开始时的世界时间）
+    void resolve(double now);
+    std::size_t pendingEvents() const { return events_.size(); }
+
+private:
+    struct ContactEvent {
+        enum class Kind : std::uint8_t { GroundFriction, BirdImpact, Impact };
+        Kind kind{Kind::Impact};
+        b2Body* bodyA{nullptr};  // GroundFriction：接触地面的动态刚体；BirdImpact：小鸟
+        b2Body* bodyB{nullptr};  // BirdImpact：被撞的刚体
+        FixtureUserData* dataA{nullptr};
+        FixtureUserData* dataB{nullptr};
+        float impactSpeed{0.0f};  // 沿接触法线的接近速度（像素/秒，求解前的速度）
+    };
+
+    void resolveGroundFriction(b2Body* body);
+    void resolveBirdImpact(const ContactEvent& event);
+    void resolveImpact(const ContactEvent& event, double now);
+
+    EntityTable* entities_{nullptr};
+    std::vector<ContactEvent> events_;
 };
 
 // Box2D physics world wrapper
@@ -56,7 +103,7 @@ public:
     explicit PhysicsWorld(const sf::Vector2f& gravity);
     ~PhysicsWorld();
     
-    // Move constructor and assignment for Game::loadLevel
+    // 可移动，但 PhysicsBody 句柄记录了所属世界的地址：只应在没有实体持有刚体时移动（重载关卡请用 reset）
     PhysicsWorld(PhysicsWorld&&) noexcept = default;
     PhysicsWorld& operator=(PhysicsWorld&&) noexcept = default;
     
@@ -74,8 +121,36 @@ public:
                                   bool isDynamic, bool isBird = false, bool isEnvironment = false,
                                   void* entityPtr = nullptr, bool isEditorEntity = false);
 
+    // 关卡重载：以新的 b2World 清空全部刚体，但保留用户数据池和侧表容量，
+    // 避免每次重试都重新分配。调用前必须先销毁持有刚体的实体
+    void reset(const sf::Vector2f& gravity);
+
     void step(float dt);
-    void clearInactive();
+    void clearInactive();  // 执行延迟的刚体销毁（step 结束时自动调用）
+    // 销毁刚体、移除侧表记录并把用户数据放回池中（不要直接调用 b2World::DestroyBody）
+    // world 处于 Step 中（锁定）时排队，等 clearInactive 处理
+    void destroyBody(PhysicsBody& body);
+    std::size_t bodyCount() const { return bodies_.size(); }
+
+    // 静止判定（用于关卡初始沉降）：只统计启用的动态刚体
+    float kineticEnergy() const;       // 未休眠刚体的总动能（焦耳）
+    int awakeDynamicBodyCount() const;
+    int dynamicBodyCount() const;
+
+    // 本步需要更新的实体（唤醒集合）：刚体未休眠、本步受到冲击（hitStrength > 0）
+    // 或实体通过 setNeedsUpdate 请求继续更新；鸟与环境刚体不在其中。先清空 out，再按侧表顺序追加
+    // 沉降后的休眠堆叠不会出现在结果中，调用方跳过它们的 update() 与精灵同步
+    void collectAwakeEntities(std::vector<Entity*>& out) const;
+    double time() const { return time_; }  // step 累计的模拟时间（秒），reset 时归零
+
+    // 本世界中方块/猪的受击状态表（实体构造时登记、析构时移除）
+    EntityTable& entities() { return *entities_; }
+    const EntityTable& entities() const { return *entities_; }
+
+    // 范围查询（走 Box2D 宽相位 QueryAABB，只访问包围盒相交的刚体）
+    // 结果按刚体去重追加到 out；范围查询额外要求刚体原点在半径内（像素）
+    void queryAABB(const sf::Vector2f& lower, const sf::Vector2f& upper, std::vector<b2Body*>& out) const;
+    void queryRadius(const sf::Vector2f& center, float radius, std::vector<b2Body*>& out) const;
 
     b2World* world() { return world_.get(); }
     const b2World* world() const { return world_.get(); }
@@ -87,9 +162,29 @@ public:
     static float meterToPixel(float meter);
 
 private:
+    // 按刚体索引的紧凑侧表：创建刚体时登记，step 的预处理只线性遍历这张表，
+    // 不再逐个遍历 b2Body/b2Fixture 链表判断是否为鸟
+    struct BodyRecord {
+        b2Body* body{nullptr};
+        FixtureUserData* data{nullptr};  // 每个刚体只有一个夹具（hitStrength/实体指针在这里）
+        float maxSpeed{0.0f};            // 全局限速（米/秒）；0 = 不限速（鸟由 Bird 自行限速）
+    };
+
+    PhysicsBody registerBody(b2Body* body, b2Fixture* fixture, bool isBird, bool isEnvironment,
+                             void* entityPtr, bool isEditorEntity);
+    FixtureUserData* acquireUserData();
+    void destroyNow(b2Body* body, FixtureUserData* data);
+
     std::unique_ptr<b2World> world_;
+    // 状态表与监听器都放在堆上：PhysicsWorld 移动后监听器持有的状态表地址仍然有效
+    std::unique_ptr<EntityTable> entities_;
     std::unique_ptr<DamageContactListener> contactListener_;
-    std::vector<std::unique_ptr<FixtureUserData>> userDataStorage_;
+    // 用户数据池：deque 保证元素地址稳定（夹具持有裸指针），释放的槽位经空闲表复用
+    std::deque<FixtureUserData> userDataPool_;
+    std::vector<FixtureUserData*> freeUserData_;
+    std::vector<BodyRecord> bodies_;  // 刚体的 b2BodyUserData 保存其在表中的下标
+    std::vector<std::pair<b2Body*, FixtureUserData*>> pendingDestroy_;
+    double time_{0.0};
 };
 
 // GLM utility functions for math operations
@@ -0,0 +1,212 @@
+// 性能分析器实现
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace {
+constexpr float kGraphHeight = 120.0f;
+constexpr float kGraphMaxMs = 33.3f;  // 图表顶部对应 30 FPS
+constexpr float kBarWidth = 2.0f;
+constexpr std::size_t kAverageFrames = 60;
+
+// 图表中绘制的“叶子”段：父区域只画扣除子区域之后的自身耗时
+struct Segment {
+    ProfileZone zone;
+    sf::Color color;
+    bool stacked{true};  // false：只出现在图例中（与主线程并行的耗时）
+};
+const Segment kSegments[] = {
+    {ProfileZone::ProcessEvents, sf::Color(200, 200, 200)},
+    {ProfileZone::Update,        sf::Color(120, 120, 255)},
+    {ProfileZone::PreviewPath,   sf::Color(255, 255, 120)},
+    {ProfileZone::AI,            sf::Color(255, 140, 255)},
+    {ProfileZone::Physics,       sf::Color(255, 90, 90)},
+    {ProfileZone::EntityUpdate,  sf::Color(255, 170, 60)},
+    {ProfileZone::EntityErase,   sf::Color(160, 100, 60)},
+    {ProfileZone::EditorUpdate,  sf::Color(80, 200, 200)},
+    {ProfileZone::Render,        sf::Color(90, 220, 90)},
+    {ProfileZone::Present,       sf::Color(40, 110, 40)},
+    {ProfileZone::SimulationWait, sf::Color(230, 60, 160)},
+    {ProfileZone::Simulation,    sf::Color(150, 150, 150), false},
+};
+
+// 区域自身耗时（父区域减去子区域）
+float selfMs(const Profiler::FrameSample& sample, ProfileZone zone) {
+    float ms = sample.zoneMs[static_cast<std::size_t>(zone)];
+    for (std::size_t i = 0; i < Profiler::kZoneCount; ++i) {
+        if (Profiler::parentZone(static_cast<ProfileZone>(i)) == zone) {
+            ms -= sample.zoneMs[i];
+        }
+    }
+    return std::max(0.0f, ms);
+}
+}  // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::beginFrame() {
+    current_ = FrameSample{};
+    frameStart_ = Clock::now();
+    // 只在第一帧记录：之后只读，后台线程在 add() 中比较时没有数据竞争
+    if (frameThread_ == std::thread::id{}) frameThread_ = std::this_thread::get_id();
+    inFrame_ = true;
+}
+
+void Profiler::endFrame() {
+    if (!inFrame_) return;
+    inFrame_ = false;
+    current_.frameMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart_).count();
+    history_[head_] = current_;
+    head_ = (head_ + 1) % kHistorySize;
+    count_ = std::min(count_ + 1, kHistorySize);
+}
+
+void Profiler::add(ProfileZone zone, float ms) {
+    if (std::this_thread::get_id() != frameThread_) return;
+    current_.zoneMs[static_cast<std::size_t>(zone)] += ms;
+}
+
+const Profiler::FrameSample& Profiler::frame(std::size_t ago) const {
+    return history_[(head_ + kHistorySize - 1 - ago) % kHistorySize];
+}
+
+const char* Profiler::zoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::ProcessEvents: return "events";
+        case ProfileZone::Update:        return "update";
+        case ProfileZone::PreviewPath:   return "preview_path";
+        case ProfileZone::AI:            return "ai";
+        case ProfileZone::Physics:       return "physics";
+        case ProfileZone::EntityUpdate:  return "entity_update";
+        case ProfileZone::EntityErase:   return "entity_erase";
+        case ProfileZone::EditorUpdate:  return "editor_update";
+        case ProfileZone::Render:        return "render";
+        case ProfileZone::Present:       return "present";
+        case ProfileZone::SimulationWait: return "sim_wait";
+        case ProfileZone::Simulation:    return "simulation";
+        case ProfileZone::Count:         break;
+    }
+    return "unknown";
+}
+
+ProfileZone Profiler::parentZone(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::PreviewPath:
+        case ProfileZone::AI:
+        case ProfileZone::Physics:
+        case ProfileZone::EntityUpdate:
+        case ProfileZone::EntityErase:
+        case ProfileZone::EditorUpdate:
+            return ProfileZone::Update;
+        case ProfileZone::Present:
+            return ProfileZone::Render;
+        default:
+            return ProfileZone::Count;
+    }
+}
+
+bool Profiler::exportCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << "frame,frame_ms";
+    for (std::size_t i = 0; i < kZoneCount; ++i) {
+        out << "," << zoneName(static_cast<ProfileZone>(i)) << "_ms";
+    }
+    out << "\n" << std::fixed << std::setprecision(4);
+    for (std::size_t n = 0; n < count_; ++n) {
+        const FrameSample& sample = frame(count_ - 1 - n);
+        out << n << "," << sample.frameMs;
+        for (float ms : sample.zoneMs) out << "," << ms;
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void Profiler::drawOverlay(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f origin) const {
+    const float graphWidth = kBarWidth * static_cast<float>(kHistorySize);
+    const float legendHeight = 16.0f * static_cast<float>(std::size(kSegments) + 1);
+
+    sf::RectangleShape background({graphWidth + 16.0f, kGraphHeight + legendHeight + 24.0f});
+    background.setPosition(origin);
+    background.setFillColor(sf::Color(0, 0, 0, 170));
+    target.draw(background);
+
+    const sf::Vector2f graphOrigin(origin.x + 8.0f, origin.y + 8.0f);
+    const float baseline = graphOrigin.y + kGraphHeight;
+    const float pxPerMs = kGraphHeight / kGraphMaxMs;
+
+    // 堆叠柱状图：最新一帧在最右侧
+    sf::VertexArray bars(sf::PrimitiveType::Triangles);
+    for (std::size_t ago = 0; ago < count_; ++ago) {
+        const FrameSample& sample = frame(ago);
+        float x1 = graphOrigin.x + graphWidth - kBarWidth * static_cast<float>(ago);
+        float x0 = x1 - kBarWidth;
+        float y = baseline;
+        for (const auto& segment : kSegments) {
+            if (!segment.stacked) continue;
+            float h = selfMs(sample, segment.zone) * pxPerMs;
+            if (h <= 0.0f) continue;
+            float top = std::max(graphOrigin.y, y - h);
+            bars.append(sf::Vertex{{x0, y}, segment.color});
+            bars.append(sf::Vertex{{x1, y}, segment.color});
+            bars.append(sf::Vertex{{x1, top}, segment.color});
+            bars.append(sf::Vertex{{x0, y}, segment.color});
+            bars.append(sf::Vertex{{x1, top}, segment.color});
+            bars.append(sf::Vertex{{x0, top}, segment.color});
+            y = top;
+            if (y <= graphOrigin.y) break;
+        }
+    }
+    target.draw(bars);
+
+    // 16.7ms（60 FPS）参考线
+    const float y60 = baseline - 16.7f * pxPerMs;
+    sf::Vertex budgetLine[] = {sf::Vertex{{graphOrigin.x, y60}, sf::Color::White},
+                               sf::Vertex{{graphOrigin.x + graphWidth, y60}, sf::Color::White}};
+    target.draw(budgetLine, 2, sf::PrimitiveType::Lines);
+
+    // 图例：最近 kAverageFrames 帧的平均自身耗时
+    const std::size_t frames = std::min(count_, kAverageFrames);
+    float avgFrame = 0.0f;
+    std::array<float, std::size(kSegments)> avg{};
+    for (std::size_t ago = 0; ago < frames; ++ago) {
+        const FrameSample& sample = frame(ago);
+        avgFrame += sample.frameMs;
+        for (std::size_t s = 0; s < std::size(kSegments); ++s) {
+            avg[s] += selfMs(sample, kSegments[s].zone);
+        }
+    }
+    const float divisor = frames > 0 ? static_cast<float>(frames) : 1.0f;
+
+    float textY = baseline + 6.0f;
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(2) << "frame " << avgFrame / divisor << " ms";
+    sf::Text headerText(font, header.str(), 13);
+    headerText.setPosition({graphOrigin.x, textY});
+    headerText.setFillColor(sf::Color::White);
+    target.draw(headerText);
+    textY += 16.0f;
+
+    for (std::size_t s = 0; s < std::size(kSegments); ++s) {
+        sf::RectangleShape swatch({10.0f, 10.0f});
+        swatch.setPosition({graphOrigin.x, textY + 3.0f});
+        swatch.setFillColor(kSegments[s].color);
+        target.draw(swatch);
+
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2) << zoneName(kSegments[s].zone) << "  " << avg[s] / divisor << " ms";
+        sf::Text text(font, line.str(), 13);
+        text.setPosition({graphOrigin.x + 16.0f, textY});
+        text.setFillColor(sf::Color::White);
+        target.draw(text);
+        textY += 16.0f;
+    }
+}
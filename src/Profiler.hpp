@@ -0,0 +1,88 @@
+// 轻量级逐帧性能分析：作用域计时器 + 环形帧历史 + 屏幕叠加图 + CSV导出
+// 用法：在需要统计的代码块中声明 ScopedTimer timer(ProfileZone::Physics);
+// 同一帧内多次进入同一区域时耗时累加（例如一帧追赶多个物理步）
+// 只记录调用 beginFrame() 的线程（主线程）：后台线程里的计时器被忽略，
+// 流水线模式下模拟线程的总耗时由主线程汇合时记入 Simulation
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+enum class ProfileZone {
+    ProcessEvents,
+    Update,
+    PreviewPath,   // 子区域：玩家拖拽时的轨迹预览积分（属于 Update）
+    AI,            // 子区域：AI 分析/瞄准（属于 Update）
+    Physics,       // 子区域：physics_.step（属于 Update）
+    EntityUpdate,  // 子区域：鸟/方块/猪 update（属于 Update）
+    EntityErase,   // 子区域：销毁实体的计分与移除（属于 Update）
+    EditorUpdate,  // 子区域：LevelEditor::update（属于 Update）
+    Render,
+    Present,       // 子区域：window.display()，包含帧率限制的等待（属于 Render）
+    SimulationWait,  // 流水线模式：主线程等待上一帧模拟任务完成
+    Simulation,      // 流水线模式：模拟线程上的任务耗时（与主线程并行，不计入帧时间柱）
+    Count
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t kZoneCount = static_cast<std::size_t>(ProfileZone::Count);
+    static constexpr std::size_t kHistorySize = 240;  // 约4秒（60FPS）
+
+    struct FrameSample {
+        float frameMs{0.0f};
+        std::array<float, kZoneCount> zoneMs{};
+    };
+
+    static Profiler& instance();
+
+    void beginFrame();
+    void endFrame();
+    void add(ProfileZone zone, float ms);
+
+    // 历史帧：ago = 0 为最近完成的一帧；ago 必须小于 frameCount()
+    const FrameSample& frame(std::size_t ago) const;
+    std::size_t frameCount() const { return count_; }
+
+    static const char* zoneName(ProfileZone zone);
+    static ProfileZone parentZone(ProfileZone zone);  // 顶层区域返回 ProfileZone::Count
+
+    // 按时间顺序（旧 -> 新）导出历史帧，成功返回 true
+    bool exportCsv(const std::string& path) const;
+
+    // 在 origin 处绘制堆叠柱状图（每帧一根柱，按区域着色）和最近 60 帧平均耗时图例
+    // 调用方负责设置屏幕坐标视图
+    void drawOverlay(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f origin) const;
+
+private:
+    Profiler() = default;
+
+    using Clock = std::chrono::steady_clock;
+    std::array<FrameSample, kHistorySize> history_{};
+    std::size_t head_{0};   // 下一帧写入位置
+    std::size_t count_{0};
+    FrameSample current_;
+    Clock::time_point frameStart_;
+    std::thread::id frameThread_;
+    bool inFrame_{false};
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfileZone zone) : zone_(zone), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        Profiler::instance().add(zone_, std::chrono::duration<float, std::milli>(elapsed).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    ProfileZone zone_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,38 @@
+// 渲染快照实现
+#include "RenderSnapshot.hpp"
+
+#include <utility>
+
+RenderSnapshot::RenderSnapshot(const TextureAtlas& atlas) : batch_(atlas) {}
+
+void RenderSnapshot::clearWorld() {
+    batch_.clear();
+    drawables_.clear();
+    runs_.clear();
+    hud = HudSnapshot{};
+    popups.clear();
+}
+
+void RenderSnapshot::addDrawable(Drawable drawable) {
+    drawables_.push_back(std::move(drawable));
+    const std::size_t vertexEnd = batch_.vertexCount();
+    if (!runs_.empty() && runs_.back().vertexEnd == vertexEnd) {
+        // 连续的单独对象之间没有批次顶点，合并到同一段
+        runs_.back().drawableEnd = drawables_.size();
+    } else {
+        runs_.push_back({vertexEnd, drawables_.size()});
+    }
+}
+
+void RenderSnapshot::drawWorld(sf::RenderTarget& target) const {
+    std::size_t vertex = 0;
+    std::size_t drawable = 0;
+    for (const Run& run : runs_) {
+        batch_.draw(target, vertex, run.vertexEnd - vertex);
+        for (; drawable < run.drawableEnd; ++drawable) {
+            std::visit([&target](const auto& d) { target.draw(d); }, drawables_[drawable]);
+        }
+        vertex = run.vertexEnd;
+    }
+    batch_.draw(target, vertex, batch_.vertexCount() - vertex);
+}
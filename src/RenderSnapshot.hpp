@@ -0,0 +1,60 @@
+// 渲染快照：一帧游戏画面所需的全部数据（实体顶点、单独绘制的精灵/形状、HUD 数值、得分飘字、轨迹预览）
+// 由模拟阶段写入、渲染阶段只读。流水线模式下 Game 持有两份快照：模拟线程写后台那份，
+// 主线程用 window_ 绘制前台那份，模拟任务完成后交换（见 Game::syncSimulation）
+//
+// 快照按值保存所有内容，绘制时不再访问实体、物理世界或计分系统；
+// 精灵/文字中的贴图与字体指针指向常驻对象（TextureCache、Game::font_）
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+#include "SpriteBatch.hpp"
+
+// HUD 显示的数值（计分文字的缩放脉冲也属于模拟状态）
+struct HudSnapshot {
+    int score{0};
+    int highScore{0};
+    float scorePulse{0.0f};
+    std::size_t birds{0};
+    std::size_t pigs{0};
+};
+
+class RenderSnapshot {
+public:
+    // 无法进入图集批次的绘制对象（无贴图的方块、炸弹爆炸特效等）
+    using Drawable = std::variant<sf::Sprite, sf::RectangleShape, sf::CircleShape>;
+
+    explicit RenderSnapshot(const TextureAtlas& atlas);
+
+    // 清空模拟阶段写入的部分（实体、HUD、飘字）；输入相关部分由 Game::captureInput 整体覆盖
+    void clearWorld();
+
+    // 实体按绘制顺序依次追加：能批量的进 batch()，其余经 addDrawable 单独记录，绘制时保持先后顺序
+    SpriteBatch& batch() { return batch_; }
+    void addDrawable(Drawable drawable);
+
+    void drawWorld(sf::RenderTarget& target) const;
+
+    HudSnapshot hud;
+    std::vector<sf::Text> popups;  // 得分飘字（屏幕坐标视图下绘制）
+
+    // 以下由主线程在启动模拟任务前写入（拖拽输入与 AI 瞄准都在主线程）
+    std::vector<sf::Vertex> playerPreview;
+    std::vector<sf::Vertex> aiPreview;
+    bool hasDragLine{false};
+    sf::Vertex dragLine[2];
+
+private:
+    // 每段：先画批次中截至 vertexEnd 的顶点，再画截至 drawableEnd 的单独对象
+    struct Run {
+        std::size_t vertexEnd;
+        std::size_t drawableEnd;
+    };
+
+    SpriteBatch batch_;
+    std::vector<Drawable> drawables_;
+    std::vector<Run> runs_;
+};
@@ -19,9 +19,9 @@ void ScoreSystem::update(float dt) {
     pulse_ = std::max(0.0f, pulse_ - dt);
 }
 
-void ScoreSystem::draw(sf::RenderWindow& window, float x, float y) {
-    sf::Text text(font_, "Score: " + std::to_string(score_) + "  High: " + std::to_string(highScore_),
-                  20 + static_cast<int>(pulse_ * 20));
+void ScoreSystem::draw(sf::RenderWindow& window, float x, float y, int score, int highScore, float pulse) const {
+    sf::Text text(font_, "Score: " + std::to_string(score) + "  High: " + std::to_string(highScore),
+                  20 + static_cast<int>(pulse * 20));
     text.setFillColor(sf::Color::Yellow);
     text.setPosition({x, y});
     window.draw(text);
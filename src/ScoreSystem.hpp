@@ -13,9 +13,11 @@ public:
     void resetRound() { score_ = 0; }
     int score() const { return score_; }
     int highScore() const { return highScore_; }
+    float pulse() const { return pulse_; }  // 得分后的文字放大脉冲（秒，逐渐衰减到 0）
 
     void update(float dt);
-    void draw(sf::RenderWindow& window, float x, float y);
+    // 按给定数值绘制（取自渲染快照；只读字体，不访问计分状态，模拟线程运行时也可调用）
+    void draw(sf::RenderWindow& window, float x, float y, int score, int highScore, float pulse) const;
 
 private:
     const sf::Font& font_;
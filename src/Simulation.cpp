@@ -0,0 +1,271 @@
+// 无窗口关卡模拟会话实现
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+
+#include "LevelSettle.hpp"
+#include "Logger.hpp"
+#include "Material.hpp"
+
+namespace {
+sf::Vector2f clampVec(const sf::Vector2f& v, float maxLen) {
+    float lenSq = v.x * v.x + v.y * v.y;
+    if (lenSq <= maxLen * maxLen) return v;
+    float len = std::sqrt(lenSq);
+    return v * (maxLen / len);
+}
+
+// [-1, 1) 均匀分布：直接使用 mt19937 原始输出，同一种子在任何平台上结果相同
+float symmetricUnit(std::mt19937& rng) {
+    return static_cast<float>(rng() >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+}  // namespace
+
+SimulationSession::SimulationSession()
+    : physics_({0.f, config::kGravity}), scoreSystem_(font_) {}
+
+SimulationSession::~SimulationSession() = default;
+
+void SimulationSession::setLaunchNoise(float angleDeg, float powerPercent, std::uint32_t seed) {
+    launchAngleNoise_ = std::max(0.0f, angleDeg);
+    launchPowerNoise_ = std::max(0.0f, powerPercent);
+    noiseRng_.seed(seed);
+}
+
+// ========== 关卡加载 ==========
+
+bool SimulationSession::loadLevel(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    levelPath_ = path;
+    try {
+        LevelData level = levelLoader_.load(path);
+        loadLevelData(level, path);
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("关卡加载失败: " + std::string(e.what()));
+        loaded_ = false;
+        return false;
+    }
+    loadTimeMs_ = elapsedMs(start);
+    return true;
+}
+
+void SimulationSession::loadLevel(const LevelData& level) {
+    loadLevelData(level, std::string());
+}
+
+void SimulationSession::loadLevelData(const LevelData& level, const std::string& settleCachePath) {
+    level_ = level;
+    loadTimeMs_ = 0.0;
+    if (!useSettleCache_) {
+        // 关闭缓存时同样忽略二进制关卡自带的预沉降变换，保证每次都真正沉降
+        level_.settledBlocks.clear();
+        level_.settledPigs.clear();
+    }
+
+    aiController_.setEnabled(false);
+    awakeEntities_.clear();
+    blocks_.clear();
+    pigs_.clear();
+    birds_.clear();
+    physics_.reset({0.f, config::kGravity});
+
+    shots_ = 0;
+    steps_ = 0;
+    simTime_ = 0.0f;
+    won_ = false;
+    lost_ = false;
+
+    // 地面（与 Game::loadLevel 相同：x=-200 到 x=1600）
+    const float groundLeft = -200.0f;
+    const float groundRight = 1600.0f;
+    const float groundWidth = groundRight - groundLeft;
+    sf::Vector2f groundPos((groundLeft + groundRight) * 0.5f,
+                           static_cast<float>(config::kWindowHeight) - 10.0f);
+    sf::Vector2f groundSize(groundWidth, 20.0f);
+    physics_.createBoxBody(groundPos, groundSize, 0.0f, 2.0f, 0.1f, false, false, true, nullptr);
+
+    slingshotPos_ = level_.slingshot;
+
+    // JSON 中方块位置为左上角，Box2D 需要中心点
+    for (auto& b : level_.blocks) {
+        Material mat = getMaterialOrDefault(b.material);
+        sf::Vector2f centerPos = b.position + b.size * 0.5f;
+        blocks_.push_back(std::make_unique<Block>(mat, centerPos, b.size, physics_));
+    }
+    for (auto& p : level_.pigs) {
+        pigs_.push_back(std::make_unique<Pig>(p.type, p.position, physics_));
+    }
+    for (auto& b : level_.birds) {
+        birds_.push_back(std::make_unique<Bird>(b.type, b.position, physics_));
+    }
+
+    // 初始沉降：与 Game::loadLevel 共用同一流程，否则模拟结果与实际游戏不同
+    settleSteps_ = LevelSettle::settleOrLoadCache(useSettleCache_ ? settleCachePath : std::string(),
+                                                  level_, physics_, blocks_, pigs_);
+
+    scoreSystem_.resetRound();
+    aiController_.clearTrajectory();
+    aiController_.resetLaunchFlag();
+    aiController_.resetSkillFlag();
+    aiController_.setEnabled(true);
+    loaded_ = true;
+}
+
+// ========== 模拟推进 ==========
+
+void SimulationSession::step() {
+    if (!loaded_ || finished()) return;
+
+    const float dt = config::kFixedDelta;
+
+    aiController_.update(dt, blocks_, pigs_, birds_, slingshotPos_);
+    handleAIControl();
+
+    // 更新顺序与 Game::stepWorld 一致：物理 -> 鸟（爆炸写入hitStrength）-> 唤醒集合中的方块和猪
+    physics_.step(dt);
+    for (auto& b : birds_) b->update(dt);
+    const std::size_t destroyedCount = physics_.entities().tick(dt, physics_.time());
+    physics_.collectAwakeEntities(awakeEntities_);
+    for (Entity* e : awakeEntities_) e->update(dt);
+
+    removeDestroyedEntities(destroyedCount);
+    scoreSystem_.update(dt);
+
+    ++steps_;
+    simTime_ += dt;
+
+    // 先判胜利再判失败（最后一只鸟的爆炸消灭最后一只猪算胜利）
+    if (pigs_.empty()) {
+        scoreSystem_.addBonusForRemainingBirds(static_cast<int>(birds_.size()));
+        won_ = true;
+    } else if (birds_.empty()) {
+        lost_ = true;
+    }
+}
+
+SimulationResult SimulationSession::run(float maxSimTime) {
+    auto start = std::chrono::steady_clock::now();
+    while (loaded_ && !finished() && simTime_ < maxSimTime) {
+        step();
+    }
+
+    SimulationResult result;
+    result.levelPath = levelPath_;
+    result.loaded = loaded_;
+    result.won = won_;
+    result.score = scoreSystem_.score();
+    result.shots = shots_;
+    result.birdsLeft = static_cast<int>(birds_.size());
+    result.pigsLeft = static_cast<int>(pigs_.size());
+    result.steps = steps_;
+    result.simulatedTime = simTime_;
+    result.wallTimeMs = loadTimeMs_ + elapsedMs(start);
+    return result;
+}
+
+// ========== AI发射控制（对应 Game::handleAIControl，去掉音效与拖拽动画） ==========
+
+void SimulationSession::handleAIControl() {
+    if (birds_.empty()) return;
+
+    Bird* currentBird = nullptr;
+    for (auto& bird : birds_) {
+        if (bird && !bird->isLaunched()) {
+            currentBird = bird.get();
+            break;
+        }
+    }
+    if (!currentBird) return;
+
+    if (aiController_.shouldLaunch()) {
+        auto* body = currentBird->body();
+        if (body) {
+            sf::Vector2f delta = body->position() - slingshotPos_;
+            // 鸟不在弹弓位置时先归位，下一步再发射
+            if (std::sqrt(delta.x * delta.x + delta.y * delta.y) > 20.0f) {
+                body->setPosition(slingshotPos_);
+                body->setDynamic(false);
+                body->setVelocity({0.0f, 0.0f});
+                return;
+            }
+
+            const auto& aim = aiController_.getCurrentAim();
+            if (aim.isValid) {
+                // AI模式下黄鸟允许2倍拉弓距离（与 Game::launchCurrentBird 相同）
+                float maxPullDist = config::kMaxPullDistance;
+                if (currentBird->type() == BirdType::Yellow) {
+                    maxPullDist = config::kMaxPullDistance * 2.0f;
+                }
+                sf::Vector2f pull = clampVec(slingshotPos_ - aim.dragEnd, maxPullDist);
+                if (launchAngleNoise_ > 0.0f || launchPowerNoise_ > 0.0f) {
+                    float angle = symmetricUnit(noiseRng_) * launchAngleNoise_ * 3.14159265f / 180.0f;
+                    float scale = 1.0f + symmetricUnit(noiseRng_) * launchPowerNoise_ / 100.0f;
+                    float c = std::cos(angle);
+                    float s = std::sin(angle);
+                    pull = clampVec({(pull.x * c - pull.y * s) * scale, (pull.x * s + pull.y * c) * scale},
+                                    maxPullDist);
+                }
+                currentBird->launch(pull * config::kSlingshotStiffness);
+                ++shots_;
+
+                if (currentBird->type() == BirdType::Yellow && aiController_.shouldActivateSkill()) {
+                    currentBird->activateSkill();
+                    aiController_.resetSkillFlag();
+                }
+
+                aiController_.resetLaunchFlag();
+                aiController_.clearTrajectory();
+            }
+        }
+    }
+
+    // 备用：处理技能激活
+    if (aiController_.shouldActivateSkill()) {
+        for (auto& bird : birds_) {
+            if (bird && bird->isLaunched() && bird->type() == BirdType::Yellow) {
+                bird->activateSkill();
+                aiController_.resetSkillFlag();
+                break;
+            }
+        }
+    }
+}
+
+// ========== 清理已销毁实体并计分（分值与 Game::update 一致） ==========
+
+void SimulationSession::removeDestroyedEntities(std::size_t destroyedCount) {
+    if (destroyedCount > 0) {  // EntityTable::tick 本步没有标记销毁时跳过方块/猪的删除遍历
+        removeDestroyed(blocks_, [this](const Block& block) {
+            scoreSystem_.addPoints(static_cast<int>(block.material().strength * 5));
+        });
+
+        removeDestroyed(pigs_, [this](const Pig& pig) {
+            int pts = 0;
+            switch (pig.type()) {
+                case PigType::Small: pts = 1000; break;
+                case PigType::Medium: pts = 3000; break;
+                case PigType::Large: pts = 5000; break;
+            }
+            scoreSystem_.addPoints(pts);
+        });
+    }
+
+    while (!birds_.empty() && birds_.front()->isDestroyed()) {
+        birds_.pop_front();
+        if (!birds_.empty()) {
+            if (auto* body = birds_.front()->body()) {
+                body->setPosition(slingshotPos_);
+                body->setDynamic(false);
+                body->setVelocity({0.0f, 0.0f});
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+// 无窗口关卡模拟会话：物理世界 + 实体 + AI + 计分，不依赖 sf::RenderWindow
+// 用于批量回归测试（HeadlessRunner），逻辑与 Game::loadLevel / Game::update 保持一致
+// 会话之间不共享可变状态（日志除外，Logger 本身线程安全），不同线程可同时运行各自的会话；
+// 多会话并行时请关闭 AI 的并行搜索（setParallelSearch(false)），并用 loadLevel(LevelData) 避免同时读写沉降缓存文件
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AIController.hpp"
+#include "Config.hpp"
+#include "Entity.hpp"
+#include "Level.hpp"
+#include "Physics.hpp"
+#include "ScoreSystem.hpp"
+
+// 单次关卡模拟的结果
+struct SimulationResult {
+    std::string levelPath;
+    bool loaded{false};          // 关卡是否加载成功
+    bool won{false};             // 是否消灭所有猪
+    int score{0};                // 最终分数（含剩余小鸟奖励）
+    int shots{0};                // 发射的小鸟数量
+    int birdsLeft{0};            // 剩余小鸟
+    int pigsLeft{0};             // 剩余猪
+    int steps{0};                // 执行的固定步数
+    float simulatedTime{0.0f};   // 模拟时长（秒）
+    double wallTimeMs{0.0};      // 实际耗时（毫秒，含关卡加载与沉降）
+};
+
+class SimulationSession {
+public:
+    SimulationSession();
+    ~SimulationSession();
+
+    SimulationSession(const SimulationSession&) = delete;
+    SimulationSession& operator=(const SimulationSession&) = delete;
+
+    // 加载关卡并完成初始沉降（与 Game::loadLevel 相同）
+    // 从文件加载时默认使用沉降缓存（levels/levelN.settled.json）；直接传入 LevelData 时不读写缓存
+    // 两种方式下 LevelData 自带预沉降变换（二进制关卡）时都直接使用，setUseSettleCache(false) 时忽略
+    bool loadLevel(const std::string& path);
+    void loadLevel(const LevelData& level);
+    void setUseSettleCache(bool enabled) { useSettleCache_ = enabled; }
+    int settleSteps() const { return settleSteps_; }  // 最近一次加载的沉降步数（命中缓存为0）
+    // AI 瞄准时是否考虑方块遮挡（默认开启，见 AIController::setObstacleAwareAim）
+    void setObstacleAwareAim(bool enabled) { aiController_.setObstacleAwareAim(enabled); }
+    // AI 搜索是否使用进程共享线程池（默认开启；多个会话并行运行时应关闭）
+    void setParallelSearch(bool enabled) { aiController_.setParallelSearch(enabled); }
+    // 发射扰动：每次发射把拉弓方向随机旋转 ±angleDeg 度、力度随机缩放 ±powerPercent%
+    // 模拟玩家手感误差，用于自我对局统计；两者都为 0 时不扰动（默认）
+    void setLaunchNoise(float angleDeg, float powerPercent, std::uint32_t seed);
+
+    // 以 config::kFixedDelta 推进一步：AI -> 发射 -> 物理 -> 实体更新 -> 清理 -> 胜负判定
+    void step();
+
+    // 一直运行到胜利/失败，或模拟时长超过 maxSimTime
+    SimulationResult run(float maxSimTime = 120.0f);
+
+    bool finished() const { return won_ || lost_; }
+    bool won() const { return won_; }
+    int shots() const { return shots_; }
+    int score() const { return scoreSystem_.score(); }
+
+    const LevelData& level() const { return level_; }
+    PhysicsWorld& physics() { return physics_; }
+    const std::vector<std::unique_ptr<Block>>& blocks() const { return blocks_; }
+    const std::vector<std::unique_ptr<Pig>>& pigs() const { return pigs_; }
+    const std::deque<std::unique_ptr<Bird>>& birds() const { return birds_; }
+
+private:
+    void loadLevelData(const LevelData& level, const std::string& settleCachePath);
+    void handleAIControl();
+    void removeDestroyedEntities(std::size_t destroyedCount);  // destroyedCount：本步 EntityTable::tick 新标记销毁的数量
+
+    sf::Font font_;  // ScoreSystem 需要字体引用，无窗口模式下不会绘制
+    LevelLoader levelLoader_;
+    LevelData level_;
+    std::string levelPath_;
+    double loadTimeMs_{0.0};
+    bool useSettleCache_{true};
+    int settleSteps_{0};
+
+    PhysicsWorld physics_;
+    std::vector<std::unique_ptr<Block>> blocks_;
+    std::vector<std::unique_ptr<Pig>> pigs_;
+    std::vector<Entity*> awakeEntities_;  // 每步复用的唤醒集合缓冲
+    std::deque<std::unique_ptr<Bird>> birds_;
+
+    ScoreSystem scoreSystem_;
+    AIController aiController_;
+    sf::Vector2f slingshotPos_{config::kSlingshotX, config::kSlingshotY};
+
+    float launchAngleNoise_{0.0f};   // 度
+    float launchPowerNoise_{0.0f};   // 百分比
+    std::mt19937 noiseRng_;
+
+    int shots_{0};
+    int steps_{0};
+    float simTime_{0.0f};
+    bool loaded_{false};
+    bool won_{false};
+    bool lost_{false};
+};
@@ -0,0 +1,54 @@
+// 模拟线程实现
+#include "SimulationThread.hpp"
+
+#include <chrono>
+#include <utility>
+
+SimulationThread::~SimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_one();
+    // 正在执行的任务会先跑完（它访问的实体/物理世界此时仍然有效）
+    if (worker_.joinable()) worker_.join();
+}
+
+void SimulationThread::launch(std::function<void()> job) {
+    if (!worker_.joinable()) worker_ = std::thread([this] { workerLoop(); });
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = std::move(job);
+        hasJob_ = true;
+    }
+    inFlight_ = true;
+    wakeCv_.notify_one();
+}
+
+float SimulationThread::wait() {
+    if (!inFlight_) return 0.0f;
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this] { return !hasJob_; });
+    inFlight_ = false;
+    return jobMs_;
+}
+
+void SimulationThread::workerLoop() {
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeCv_.wait(lock, [this] { return hasJob_ || stop_; });
+        if (!hasJob_) return;  // stop_ 且没有待执行任务
+        std::function<void()> job = std::move(job_);
+        lock.unlock();
+
+        const auto start = Clock::now();
+        job();
+        const float ms = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        lock.lock();
+        jobMs_ = ms;
+        hasJob_ = false;
+        doneCv_.notify_one();
+    }
+}
@@ -0,0 +1,43 @@
+// 模拟线程：模拟/渲染两级流水线的第一级
+// 主线程处理完输入后把本帧的固定步长模拟交给这里执行，同时用 window_ 绘制上一帧的渲染快照；
+// 下一帧处理输入之前 wait() 汇合。任务运行期间只有模拟线程访问物理世界与实体，
+// 主线程只能读写任务不涉及的状态（窗口、视图、按钮、前台快照）
+//
+// 同一时刻最多一个任务；线程在第一次 launch() 时才创建，不启用流水线时没有额外线程
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class SimulationThread {
+public:
+    SimulationThread() = default;
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // 在模拟线程上执行 job（不阻塞）；上一个任务必须已经 wait() 完成
+    void launch(std::function<void()> job);
+
+    // 等待已提交的任务完成，返回任务耗时（毫秒）；没有任务时立即返回 0
+    float wait();
+
+    // 是否有已提交、尚未 wait() 的任务（只在主线程调用）
+    bool busy() const { return inFlight_; }
+
+private:
+    void workerLoop();
+
+    std::mutex mutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable doneCv_;
+    std::function<void()> job_;
+    bool hasJob_{false};
+    bool stop_{false};
+    float jobMs_{0.0f};
+    bool inFlight_{false};
+    std::thread worker_;
+};
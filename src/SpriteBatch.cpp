@@ -0,0 +1,147 @@
+// 图集打包与批量渲染实现
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "TextureCache.hpp"
+
+namespace {
+constexpr unsigned kAtlasPadding = 2;  // 区域之间留空，避免线性过滤时相邻贴图串色
+}  // namespace
+
+bool TextureAtlas::build(const std::vector<std::string>& paths) {
+    regions_.clear();
+    ready_ = false;
+
+    struct Entry {
+        const sf::Texture* source;
+        sf::Image image;
+        sf::Vector2u position;
+    };
+    std::vector<Entry> entries;
+    for (const auto& path : paths) {
+        const sf::Texture* source = TextureCache::instance().get(path);
+        if (!source || source->getSize().x == 0) continue;
+        bool duplicate = std::any_of(entries.begin(), entries.end(),
+                                     [&](const Entry& e) { return e.source == source; });
+        if (duplicate) continue;
+        entries.push_back({source, source->copyToImage(), {0, 0}});
+    }
+    if (entries.empty()) return false;
+
+    // 简单的行（shelf）打包：按高度降序排列，逐行从左到右放置
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.image.getSize().y > b.image.getSize().y;
+    });
+    const unsigned maxSize = sf::Texture::getMaximumSize();
+    const unsigned atlasWidth = std::min(2048u, maxSize);
+    unsigned x = 0, y = 0, rowHeight = 0, usedWidth = 0;
+    for (auto& entry : entries) {
+        sf::Vector2u size = entry.image.getSize();
+        if (size.x > atlasWidth) {
+            std::cerr << "警告: 贴图宽度超过图集宽度，图集未启用\n";
+            return false;
+        }
+        if (x + size.x > atlasWidth) {
+            x = 0;
+            y += rowHeight + kAtlasPadding;
+            rowHeight = 0;
+        }
+        entry.position = {x, y};
+        x += size.x + kAtlasPadding;
+        rowHeight = std::max(rowHeight, size.y);
+        usedWidth = std::max(usedWidth, x);
+    }
+    const unsigned atlasHeight = y + rowHeight;
+    if (atlasHeight > maxSize) {
+        std::cerr << "警告: 图集高度超过显卡纹理上限，图集未启用\n";
+        return false;
+    }
+
+    sf::Image atlasImage(sf::Vector2u(usedWidth, atlasHeight), sf::Color::Transparent);
+    for (const auto& entry : entries) {
+        if (!atlasImage.copy(entry.image, entry.position)) {
+            std::cerr << "警告: 图集拷贝贴图失败，图集未启用\n";
+            return false;
+        }
+    }
+    if (!texture_.loadFromImage(atlasImage)) {
+        std::cerr << "警告: 无法创建图集纹理\n";
+        return false;
+    }
+
+    for (const auto& entry : entries) {
+        regions_[entry.source] = sf::IntRect(sf::Vector2i(entry.position), sf::Vector2i(entry.image.getSize()));
+    }
+    ready_ = true;
+    return true;
+}
+
+const sf::IntRect* TextureAtlas::find(const sf::Texture* source) const {
+    auto it = regions_.find(source);
+    return it != regions_.end() ? &it->second : nullptr;
+}
+
+SpriteBatch::SpriteBatch(const TextureAtlas& atlas) : atlas_(atlas) {}
+
+bool SpriteBatch::add(const sf::Sprite& sprite, const sf::Texture* source) {
+    if (!atlas_.ready()) return false;
+    const sf::IntRect* region = atlas_.find(source);
+    if (!region) return false;
+
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const sf::Color color = sprite.getColor();
+    const int tileW = region->size.x;
+    const int tileH = region->size.y;
+    if (tileW <= 0 || tileH <= 0 || rect.size.x <= 0 || rect.size.y <= 0) return false;
+
+    // 按贴图尺寸把纹理矩形切成若干块：普通精灵只有一块，重复平铺的方块有多块
+    auto wrap = [](int v, int size) { return ((v % size) + size) % size; };
+    for (int ty = rect.position.y; ty < rect.position.y + rect.size.y;) {
+        int texY = wrap(ty, tileH);
+        int h = std::min(tileH - texY, rect.position.y + rect.size.y - ty);
+        for (int tx = rect.position.x; tx < rect.position.x + rect.size.x;) {
+            int texX = wrap(tx, tileW);
+            int w = std::min(tileW - texX, rect.position.x + rect.size.x - tx);
+            sf::FloatRect local(
+                sf::Vector2f(static_cast<float>(tx - rect.position.x), static_cast<float>(ty - rect.position.y)),
+                sf::Vector2f(static_cast<float>(w), static_cast<float>(h)));
+            sf::Vector2f texOrigin(static_cast<float>(region->position.x + texX),
+                                   static_cast<float>(region->position.y + texY));
+            appendQuad(transform, local, texOrigin, color);
+            tx += w;
+        }
+        ty += h;
+    }
+    return true;
+}
+
+void SpriteBatch::appendQuad(const sf::Transform& transform, sf::FloatRect local, sf::Vector2f texOrigin,
+                             sf::Color color) {
+    const sf::Vector2f p0 = local.position;
+    const sf::Vector2f p1(local.position.x + local.size.x, local.position.y);
+    const sf::Vector2f p2(local.position.x + local.size.x, local.position.y + local.size.y);
+    const sf::Vector2f p3(local.position.x, local.position.y + local.size.y);
+    const sf::Vector2f t0 = texOrigin;
+    const sf::Vector2f t1(texOrigin.x + local.size.x, texOrigin.y);
+    const sf::Vector2f t2(texOrigin.x + local.size.x, texOrigin.y + local.size.y);
+    const sf::Vector2f t3(texOrigin.x, texOrigin.y + local.size.y);
+
+    const sf::Vertex v0{transform.transformPoint(p0), color, t0};
+    const sf::Vertex v1{transform.transformPoint(p1), color, t1};
+    const sf::Vertex v2{transform.transformPoint(p2), color, t2};
+    const sf::Vertex v3{transform.transformPoint(p3), color, t3};
+    vertices_.append(v0);
+    vertices_.append(v1);
+    vertices_.append(v2);
+    vertices_.append(v0);
+    vertices_.append(v2);
+    vertices_.append(v3);
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, std::size_t first, std::size_t count) const {
+    if (count == 0) return;
+    target.draw(&vertices_[first], count, sf::PrimitiveType::Triangles, sf::RenderStates(&atlas_.texture()));
+}
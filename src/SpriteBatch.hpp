@@ -0,0 +1,51 @@
+// 实体批量渲染：启动时把实体贴图打包进一张图集，
+// 每帧把所有精灵按物理变换追加到一个 sf::VertexArray，一次 draw 调用完成绘制
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 贴图图集：以 TextureCache 中的 sf::Texture 指针为键，记录其在图集中的像素区域
+class TextureAtlas {
+public:
+    // 打包给定路径的贴图（通过 TextureCache 取得），成功返回 true
+    // 加载失败的路径会被跳过，使用这些贴图的精灵仍按原方式单独绘制
+    bool build(const std::vector<std::string>& paths);
+
+    bool ready() const { return ready_; }
+    const sf::Texture& texture() const { return texture_; }
+
+    // 源贴图在图集中的区域；不在图集中返回 nullptr
+    const sf::IntRect* find(const sf::Texture* source) const;
+
+private:
+    sf::Texture texture_;
+    std::unordered_map<const sf::Texture*, sf::IntRect> regions_;
+    bool ready_{false};
+};
+
+class SpriteBatch {
+public:
+    explicit SpriteBatch(const TextureAtlas& atlas);
+
+    void clear() { vertices_.clear(); }
+    bool empty() const { return vertices_.getVertexCount() == 0; }
+    std::size_t vertexCount() const { return vertices_.getVertexCount(); }
+
+    // 追加一个精灵（使用其变换、纹理矩形和颜色）；source 为精灵使用的原始贴图
+    // 纹理矩形超出贴图尺寸时（方块的重复平铺）拆成多个四边形
+    // source 不在图集中时返回 false，调用方应单独绘制该精灵
+    bool add(const sf::Sprite& sprite, const sf::Texture* source);
+
+    // 绘制 [first, first + count) 范围内的顶点（渲染快照按段绘制，与单独绘制的精灵交错，见 RenderSnapshot）
+    void draw(sf::RenderTarget& target, std::size_t first, std::size_t count) const;
+
+private:
+    void appendQuad(const sf::Transform& transform, sf::FloatRect local, sf::Vector2f texOrigin, sf::Color color);
+
+    const TextureAtlas& atlas_;
+    sf::VertexArray vertices_{sf::PrimitiveType::Triangles};
+};
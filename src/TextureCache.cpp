@@ -0,0 +1,53 @@
+// 贴图缓存实现
+#include "TextureCache.hpp"
+
+#include <iostream>
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+sf::Texture* TextureCache::get(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = textures_.find(path);
+    if (it != textures_.end()) {
+        return it->second.get();
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        std::cerr << "警告: 无法加载贴图 " << path << "\n";
+        texture.reset();
+    }
+    sf::Texture* result = texture.get();
+    textures_.emplace(path, std::move(texture));
+    return result;
+}
+
+sf::Texture* TextureCache::insert(const std::string& path, const sf::Image* image) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = textures_.find(path);
+    if (it != textures_.end()) {
+        return it->second.get();
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!image || !texture->loadFromImage(*image)) {
+        std::cerr << "警告: 无法加载贴图 " << path << "\n";
+        texture.reset();
+    }
+    sf::Texture* result = texture.get();
+    textures_.emplace(path, std::move(texture));
+    return result;
+}
+
+void TextureCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    textures_.clear();
+}
+
+std::size_t TextureCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return textures_.size();
+}
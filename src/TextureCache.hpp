@@ -0,0 +1,36 @@
+// 进程共享的贴图缓存：按文件路径缓存 sf::Texture，同一路径只读盘/上传显存一次
+// Game、实体（Block/Pig/Bird）和关卡编辑器都从这里取贴图，关卡越大越能避免重复加载
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class TextureCache {
+public:
+    static TextureCache& instance();
+
+    // 返回路径对应的贴图（首次调用时加载）；加载失败返回 nullptr
+    // 失败结果同样会被缓存，不会对同一路径反复读盘和输出警告
+    // 返回的指针在 clear() 之前一直有效
+    sf::Texture* get(const std::string& path);
+
+    // 登记已在其他线程解码好的图片（见 AssetPipeline），必须在主线程调用（上传显存）
+    // image 为 nullptr 表示解码失败，与 get() 一样缓存失败结果；路径已在缓存中时直接返回已有贴图
+    sf::Texture* insert(const std::string& path, const sf::Image* image);
+
+    // 释放所有贴图（调用前必须确保没有 sprite 仍在引用它们）
+    void clear();
+
+    std::size_t size() const;
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures_;  // nullptr = 加载失败
+};
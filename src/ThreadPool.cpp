@@ -0,0 +1,87 @@
+// 固定线程池实现
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        threadCount = hw > 1 ? hw - 1 : 0;
+    }
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) return;
+
+    // 没有工作线程或只有一个任务时直接在调用线程执行
+    if (workers_.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(callMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        pending_ = workers_.size();
+        ++generation_;
+    }
+    wakeCv_.notify_all();
+
+    // 调用线程同样领取任务
+    runTasks(task, count);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this] { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    std::uint64_t seenGeneration = 0;
+    for (;;) {
+        const std::function<void(std::size_t)>* task = nullptr;
+        std::size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeCv_.wait(lock, [&] { return stop_ || generation_ != seenGeneration; });
+            if (stop_) return;
+            seenGeneration = generation_;
+            task = task_;
+            count = count_;
+        }
+
+        runTasks(*task, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) doneCv_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks(const std::function<void(std::size_t)>& task, std::size_t count) {
+    for (std::size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next_.fetch_add(1, std::memory_order_relaxed)) {
+        task(i);
+    }
+}
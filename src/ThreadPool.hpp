@@ -0,0 +1,47 @@
+// 简单的固定线程池：用于把互相独立的计算（如AI轨迹候选）分摊到多个核心
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // threadCount = 0 时使用 hardware_concurrency() - 1 个工作线程（调用线程也参与计算）
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 并行执行 task(i)，i ∈ [0, count)；任务按索引动态分配，全部完成后返回
+    // 注意：task 内不能再调用同一个线程池的 parallelFor（会死锁）
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    // 参与计算的线程数（含调用线程）
+    std::size_t concurrency() const { return workers_.size() + 1; }
+
+    // 进程共享的线程池（首次使用时创建）
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+    void runTasks(const std::function<void(std::size_t)>& task, std::size_t count);
+
+    std::vector<std::thread> workers_;
+    std::mutex callMutex_;  // 串行化来自不同线程的 parallelFor 调用
+    std::mutex mutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable doneCv_;
+    const std::function<void(std::size_t)>* task_{nullptr};
+    std::size_t count_{0};
+    std::atomic<std::size_t> next_{0};
+    std::size_t pending_{0};       // 本轮尚未完成的工作线程数
+    std::uint64_t generation_{0};  // 每次 parallelFor 递增，用于唤醒工作线程
+    bool stop_{false};
+};
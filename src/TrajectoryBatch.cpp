@@ -0,0 +1,220 @@
+// 批量轨迹评估内核实现
+// 同一份积分逻辑通过不同的“通道操作”类型实例化为 AVX2 / SSE2 / 标量版本，
+// 逐步运算顺序与 integrateFlightStep（TrajectoryPreview.cpp） 保持一致，保证与标量轨迹结果相同
+#include "TrajectoryBatch.hpp"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TRAJECTORY_BATCH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRAJECTORY_BATCH_SSE2 1
+#endif
+
+namespace {
+
+// ========== 通道操作：标量 ==========
+struct ScalarLanes {
+    static constexpr std::size_t kWidth = 1;
+    using Float = float;
+    using Mask = bool;
+
+    static Float load(const float* p) { return *p; }
+    static void store(float* p, Float v) { *p = v; }
+    static Float set1(float v) { return v; }
+    static Float add(Float a, Float b) { return a + b; }
+    static Float sub(Float a, Float b) { return a - b; }
+    static Float mul(Float a, Float b) { return a * b; }
+    static Float div(Float a, Float b) { return a / b; }
+    static Float sqrt(Float a) { return std::sqrt(a); }
+    static Float min(Float a, Float b) { return b < a ? b : a; }
+    static Mask less(Float a, Float b) { return a < b; }
+    static Mask greater(Float a, Float b) { return a > b; }
+    static Mask maskAnd(Mask a, Mask b) { return a && b; }
+    static Mask maskAndNot(Mask a, Mask b) { return !a && b; }  // (~a) & b
+    static Mask maskOr(Mask a, Mask b) { return a || b; }
+    static Mask allTrue() { return true; }
+    static Mask allFalse() { return false; }
+    static Float select(Mask m, Float a, Float b) { return m ? a : b; }  // m ? a : b
+    static bool any(Mask m) { return m; }
+    static void storeMask(std::uint8_t* p, Mask m) { *p = m ? 1 : 0; }
+};
+
+#if defined(TRAJECTORY_BATCH_AVX2)
+// ========== 通道操作：AVX2（8路） ==========
+struct Avx2Lanes {
+    static constexpr std::size_t kWidth = 8;
+    using Float = __m256;
+    using Mask = __m256;
+
+    static Float load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+    static Float set1(float v) { return _mm256_set1_ps(v); }
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm256_div_ps(a, b); }
+    static Float sqrt(Float a) { return _mm256_sqrt_ps(a); }
+    static Float min(Float a, Float b) { return _mm256_min_ps(b, a); }
+    static Mask less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask maskAndNot(Mask a, Mask b) { return _mm256_andnot_ps(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    static Mask allTrue() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Mask allFalse() { return _mm256_setzero_ps(); }
+    static Float select(Mask m, Float a, Float b) { return _mm256_blendv_ps(b, a, m); }
+    static bool any(Mask m) { return _mm256_movemask_ps(m) != 0; }
+    static void storeMask(std::uint8_t* p, Mask m) {
+        int bits = _mm256_movemask_ps(m);
+        for (std::size_t i = 0; i < kWidth; ++i) p[i] = static_cast<std::uint8_t>((bits >> i) & 1);
+    }
+};
+#endif
+
+#if defined(TRAJECTORY_BATCH_AVX2) || defined(TRAJECTORY_BATCH_SSE2)
+// ========== 通道操作：SSE2（4路） ==========
+struct Sse2Lanes {
+    static constexpr std::size_t kWidth = 4;
+    using Float = __m128;
+    using Mask = __m128;
+
+    static Float load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Float v) { _mm_storeu_ps(p, v); }
+    static Float set1(float v) { return _mm_set1_ps(v); }
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+    static Float sqrt(Float a) { return _mm_sqrt_ps(a); }
+    static Float min(Float a, Float b) { return _mm_min_ps(b, a); }
+    static Mask less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    static Mask greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask maskAndNot(Mask a, Mask b) { return _mm_andnot_ps(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    static Mask allTrue() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Mask allFalse() { return _mm_setzero_ps(); }
+    static Float select(Mask m, Float a, Float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static bool any(Mask m) { return _mm_movemask_ps(m) != 0; }
+    static void storeMask(std::uint8_t* p, Mask m) {
+        int bits = _mm_movemask_ps(m);
+        for (std::size_t i = 0; i < kWidth; ++i) p[i] = static_cast<std::uint8_t>((bits >> i) & 1);
+    }
+};
+#endif
+
+// 推进一组（L::kWidth 条）轨迹直到全部击中、越界或达到步数上限
+template <typename L>
+void integrateLanes(const TrajectoryBatchParams& p, const float* velX, const float* velY,
+                    float* minDistance, std::uint8_t* hit) {
+    using F = typename L::Float;
+    using M = typename L::Mask;
+
+    const F dt = L::set1(p.dt);
+    const F gravityStep = L::set1(p.gravity * p.dt);
+    const F airAccel = L::set1(p.airAccel);
+    const F maxSpeed = L::set1(p.maxSpeed);
+    const F tx = L::set1(p.targetX);
+    const F ty = L::set1(p.targetY);
+    const F radius = L::set1(p.collisionRadius);
+    const F minSpeed = L::set1(0.001f);
+    const F minX = L::set1(p.minX);
+    const F maxX = L::set1(p.maxX);
+    const F maxY = L::set1(p.maxY);
+
+    F px = L::set1(p.startX);
+    F py = L::set1(p.startY);
+    F vx = L::load(velX);
+    F vy = L::load(velY);
+    F best = L::set1(std::numeric_limits<float>::max());
+    M active = L::allTrue();
+    M hitMask = L::allFalse();
+
+    for (int i = 0; i < p.maxSteps && L::any(active); ++i) {
+        // 当前点与目标的距离
+        F dx = L::sub(px, tx);
+        F dy = L::sub(py, ty);
+        F dist = L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy)));
+        best = L::select(active, L::min(best, dist), best);
+
+        // 击中检测：击中的通道记录当前距离并停止
+        M hitNow = L::maskAnd(active, L::less(dist, radius));
+        best = L::select(hitNow, dist, best);
+        hitMask = L::maskOr(hitMask, hitNow);
+        active = L::maskAndNot(hitNow, active);
+
+        // 重力
+        vy = L::add(vy, gravityStep);
+
+        // 空气阻力（与 integrateFlightStep 的运算顺序一致）
+        F speed = L::sqrt(L::add(L::mul(vx, vx), L::mul(vy, vy)));
+        M moving = L::greater(speed, minSpeed);
+        F dirX = L::div(vx, speed);
+        F dirY = L::div(vy, speed);
+        vx = L::select(moving, L::sub(vx, L::mul(L::mul(dirX, airAccel), dt)), vx);
+        vy = L::select(moving, L::sub(vy, L::mul(L::mul(dirY, airAccel), dt)), vy);
+        speed = L::select(moving, L::sqrt(L::add(L::mul(vx, vx), L::mul(vy, vy))), speed);
+
+        // 速度上限
+        M tooFast = L::greater(speed, maxSpeed);
+        F clampX = L::mul(L::div(vx, speed), maxSpeed);
+        F clampY = L::mul(L::div(vy, speed), maxSpeed);
+        vx = L::select(tooFast, clampX, vx);
+        vy = L::select(tooFast, clampY, vy);
+
+        // 更新位置
+        px = L::add(px, L::mul(vx, dt));
+        py = L::add(py, L::mul(vy, dt));
+
+        // 越界检测
+        M outside = L::maskOr(L::greater(py, maxY), L::maskOr(L::less(px, minX), L::greater(px, maxX)));
+        active = L::maskAndNot(outside, active);
+    }
+
+    L::store(minDistance, best);
+    L::storeMask(hit, hitMask);
+}
+
+// 以宽度 L::kWidth 处理完整分组，返回已处理的候选数（余下部分交给更窄的内核）
+template <typename L>
+std::size_t evaluateGroups(const TrajectoryBatchParams& p, const float* velX, const float* velY,
+                           std::size_t count, float* minDistance, std::uint8_t* hit) {
+    constexpr std::size_t W = L::kWidth;
+    std::size_t i = 0;
+    for (; i + W <= count; i += W) {
+        integrateLanes<L>(p, velX + i, velY + i, minDistance + i, hit + i);
+    }
+    return i;
+}
+
+}  // namespace
+
+void evaluateTrajectoryBatch(const TrajectoryBatchParams& params,
+                             const float* velX, const float* velY, std::size_t count,
+                             float* minDistance, std::uint8_t* hit) {
+    std::size_t done = 0;
+#if defined(TRAJECTORY_BATCH_AVX2)
+    done = evaluateGroups<Avx2Lanes>(params, velX, velY, count, minDistance, hit);
+#endif
+#if defined(TRAJECTORY_BATCH_AVX2) || defined(TRAJECTORY_BATCH_SSE2)
+    done += evaluateGroups<Sse2Lanes>(params, velX + done, velY + done, count - done,
+                                      minDistance + done, hit + done);
+#endif
+    for (; done < count; ++done) {
+        integrateLanes<ScalarLanes>(params, velX + done, velY + done, minDistance + done, hit + done);
+    }
+}
+
+const char* trajectoryBatchKernelName() {
+#if defined(TRAJECTORY_BATCH_AVX2)
+    return "avx2";
+#elif defined(TRAJECTORY_BATCH_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,33 @@
+// 批量轨迹评估内核：结构数组（SoA）布局，一次推进多条候选轨迹
+// 编译时按指令集选择实现：AVX2（8路）/ SSE2（4路）/ 标量回退
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 所有候选共享的积分参数（像素单位，与 integrateFlightStep 一致）
+struct TrajectoryBatchParams {
+    float startX{0.0f};
+    float startY{0.0f};
+    float targetX{0.0f};
+    float targetY{0.0f};
+    float collisionRadius{0.0f};  // 距离目标小于该值视为击中
+    float maxSpeed{0.0f};         // 飞行速度上限
+    float gravity{0.0f};          // 像素/秒²
+    float airAccel{0.0f};         // 空气阻力加速度（像素/秒²，config::kAirResistanceAccel * kPixelsPerMeter）
+    float dt{0.02f};
+    int maxSteps{0};
+    // 越界判定：y > maxY 或 x < minX 或 x > maxX 时停止
+    float minX{0.0f};
+    float maxX{0.0f};
+    float maxY{0.0f};
+};
+
+// 评估 count 条初速度为 (velX[i], velY[i]) 的轨迹
+// 输出：minDistance[i] = 轨迹与目标的最小距离（击中时为击中时刻的距离），hit[i] = 是否击中
+void evaluateTrajectoryBatch(const TrajectoryBatchParams& params,
+                             const float* velX, const float* velY, std::size_t count,
+                             float* minDistance, std::uint8_t* hit);
+
+// 当前编译使用的内核名称（"avx2" / "sse2" / "scalar"），用于日志与基准测试输出
+const char* trajectoryBatchKernelName();
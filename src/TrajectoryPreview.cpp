@@ -0,0 +1,103 @@
+// 轨迹预览服务与共享飞行积分器实现
+#include "TrajectoryPreview.hpp"
+
+#include <cmath>
+#include <tuple>
+
+namespace {
+sf::Vector2f normalized(const sf::Vector2f& v) {
+    float len = std::sqrt(v.x * v.x + v.y * v.y);
+    if (len < 0.0001f) return sf::Vector2f(0.0f, 0.0f);
+    return sf::Vector2f(v.x / len, v.y / len);
+}
+}  // namespace
+
+std::pair<sf::Vector2f, sf::Vector2f> integrateFlightStep(sf::Vector2f pos, sf::Vector2f vel,
+                                                          float dt, float maxSpeed) {
+    // 应用重力
+    vel.y += config::kGravity * dt;
+
+    // 应用空气阻力（运算顺序与 TrajectoryBatch 内核一致，保证结果逐位相同）
+    float speed = std::sqrt(vel.x * vel.x + vel.y * vel.y);
+    if (speed > 0.001f) {
+        const float airResistanceAccelPixels = config::kAirResistanceAccel * config::kPixelsPerMeter;
+        sf::Vector2f resistanceDir = normalized(vel);
+        sf::Vector2f resistanceAccel = -resistanceDir * airResistanceAccelPixels;
+        vel += resistanceAccel * dt;
+
+        // 重新计算速度（空气阻力可能改变了速度大小）
+        speed = std::sqrt(vel.x * vel.x + vel.y * vel.y);
+    }
+
+    // 限制速度（必须在应用重力和空气阻力之后检查）
+    if (speed > maxSpeed) {
+        vel = normalized(vel) * maxSpeed;
+    }
+
+    // 更新位置
+    pos += vel * dt;
+
+    return std::make_pair(pos, vel);
+}
+
+float birdFlightMaxSpeed(BirdType type, bool skillActive) {
+    switch (type) {
+        case BirdType::Red:
+            return config::bird_speed::kRedMaxSpeed;
+        case BirdType::Yellow:
+            return skillActive ? config::bird_speed::kYellowMaxSpeed : config::bird_speed::kYellowInitialMax;
+        case BirdType::Bomb:
+            return config::bird_speed::kBombMaxSpeed;
+    }
+    return config::kMaxBodySpeed;
+}
+
+TrajectoryPreview::Key TrajectoryPreview::quantize(const sf::Vector2f& start, const sf::Vector2f& velocity,
+                                                   float maxSpeed) {
+    auto q = [](float value, float quantum) { return static_cast<std::int32_t>(std::lround(value / quantum)); };
+    Key key;
+    key.startX = q(start.x, config::kPreviewPositionQuantum);
+    key.startY = q(start.y, config::kPreviewPositionQuantum);
+    key.velX = q(velocity.x, config::kPreviewVelocityQuantum);
+    key.velY = q(velocity.y, config::kPreviewVelocityQuantum);
+    key.maxSpeed = q(maxSpeed, 1.0f);
+    return key;
+}
+
+bool TrajectoryPreview::update(const sf::Vector2f& start, const sf::Vector2f& velocity, float maxSpeed) {
+    Key key = quantize(start, velocity, maxSpeed);
+    if (valid_ && key == key_) {
+        return false;
+    }
+    key_ = key;
+    valid_ = true;
+    ++rebuilds_;
+
+    // 原地覆盖顶点：容量在多次拖拽之间保留，不重新分配
+    vertices_.resize(static_cast<std::size_t>(style_.steps));
+    std::size_t count = 0;
+    sf::Vector2f pos = start;
+    sf::Vector2f vel = velocity;
+    const float bottom = static_cast<float>(config::kWindowHeight) + 100.0f;
+    for (int i = 0; i < style_.steps; ++i) {
+        std::tie(pos, vel) = integrateFlightStep(pos, vel, style_.dt, maxSpeed);
+        if (pos.y > bottom) break;
+        vertices_[count].position = pos;
+        vertices_[count].color = style_.color;
+        ++count;
+    }
+    vertices_.resize(count);
+
+    if (style_.fade && count > 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            float alpha = static_cast<float>(style_.color.a) * (1.0f - static_cast<float>(i) / count);
+            vertices_[i].color.a = static_cast<std::uint8_t>(alpha);
+        }
+    }
+    return true;
+}
+
+void TrajectoryPreview::clear() {
+    vertices_.clear();
+    valid_ = false;
+}
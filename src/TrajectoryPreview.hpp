@@ -0,0 +1,58 @@
+// 轨迹预览服务：玩家拖拽预览与 AI 瞄准预览共用同一个飞行积分器
+// 发射参数量化后与上次相同时不重新积分，顶点缓冲原地复用（不逐帧清空重建）
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Config.hpp"
+#include "Entity.hpp"
+
+// 单步飞行积分：重力 -> 空气阻力 -> 速度上限 -> 位置（像素单位）
+// AI 轨迹搜索（AIController::applyPhysicsStep）与两种预览都调用这里，保证物理完全一致
+std::pair<sf::Vector2f, sf::Vector2f> integrateFlightStep(sf::Vector2f pos, sf::Vector2f vel,
+                                                          float dt, float maxSpeed);
+
+// 鸟在飞行中的速度上限（黄鸟技能激活后上限提高）
+float birdFlightMaxSpeed(BirdType type, bool skillActive);
+
+class TrajectoryPreview {
+public:
+    struct Style {
+        int steps{60};
+        float dt{0.05f};
+        sf::Color color{80, 80, 80, 200};
+        bool fade{false};  // true：透明度沿轨迹线性衰减到 0
+    };
+
+    TrajectoryPreview() = default;
+    explicit TrajectoryPreview(const Style& style) : style_(style) {}
+
+    // 按发射参数（起点、初速度、飞行速度上限）更新预览
+    // 量化后的参数与上次相同时直接返回 false，顶点保持不变
+    bool update(const sf::Vector2f& start, const sf::Vector2f& velocity, float maxSpeed);
+
+    void clear();
+    bool empty() const { return vertices_.empty(); }
+    const std::vector<sf::Vertex>& vertices() const { return vertices_; }
+
+    // 重新积分的次数（调试/基准测试用）
+    std::uint64_t rebuildCount() const { return rebuilds_; }
+
+private:
+    struct Key {
+        std::int32_t startX{0}, startY{0};
+        std::int32_t velX{0}, velY{0};
+        std::int32_t maxSpeed{0};
+        bool operator==(const Key&) const = default;
+    };
+    static Key quantize(const sf::Vector2f& start, const sf::Vector2f& velocity, float maxSpeed);
+
+    Style style_;
+    std::vector<sf::Vertex> vertices_;
+    Key key_;
+    bool valid_{false};
+    std::uint64_t rebuilds_{0};
+};
@@ -0,0 +1,112 @@
+// 任务窃取线程池实现
+#include "WorkStealingPool.hpp"
+
+#include <exception>
+#include <string>
+
+#include "Logger.hpp"
+
+namespace {
+// 当前线程所属的线程池与队列下标（非工作线程为 nullptr）
+thread_local const WorkStealingPool* tlsPool = nullptr;
+thread_local std::size_t tlsIndex = 0;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) threadCount = 1;
+
+    queues_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    std::size_t index = (tlsPool == this)
+        ? tlsIndex
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    // 先计数再入队：wait() 不会在任务入队前提前返回
+    pending_.fetch_add(1, std::memory_order_acq_rel);
+    queued_.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCv_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    doneCv_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+bool WorkStealingPool::popLocal(std::size_t index, std::function<void()>& task) {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());  // 自己的队列后进先出（缓存更热）
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t thief, std::function<void()>& task) {
+    // 从下一个队列开始轮询，避免所有空闲线程都去抢同一个队列
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+        auto& queue = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());  // 从队首窃取最早提交的任务
+        queue.tasks.pop_front();
+        stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    tlsPool = this;
+    tlsIndex = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+            try {
+                task();
+            } catch (const std::exception& e) {
+                Logger::getInstance().error("线程池任务异常: " + std::string(e.what()));
+            }
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                doneCv_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stop_ && queued_.load(std::memory_order_acquire) == 0) return;
+    }
+}
@@ -0,0 +1,56 @@
+// 任务窃取线程池：用于互相独立、耗时不均的粗粒度任务（如整局自我对局模拟）
+// 每个工作线程有自己的任务队列，从队尾取自己的任务，空闲时从其他队列的队首窃取
+// 与 ThreadPool（parallelFor 索引分发，适合大量细粒度同构任务）互补
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // threadCount = 0 时使用 hardware_concurrency() 个工作线程
+    explicit WorkStealingPool(std::size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 提交任务：在工作线程内提交时放入自己的队列，否则轮流分配到各队列
+    void submit(std::function<void()> task);
+
+    // 阻塞直到所有已提交的任务（包括任务中再提交的）执行完毕
+    void wait();
+
+    std::size_t threadCount() const { return workers_.size(); }
+    std::size_t stolenCount() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    // 任务粒度很粗（毫秒到秒级），每个队列用一把独立的锁即可，竞争只发生在窃取时
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, std::function<void()>& task);
+    bool steal(std::size_t thief, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> nextQueue_{0};
+    std::atomic<std::size_t> queued_{0};   // 已提交但尚未被取走的任务数
+    std::atomic<std::size_t> pending_{0};  // 已提交但尚未执行完的任务数
+    std::atomic<std::size_t> stolen_{0};
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;  // 有新任务或停止
+    std::condition_variable doneCv_;  // pending_ 归零
+    bool stop_{false};
+};